@@ -13,6 +13,7 @@
 //----------------------------------------------------------------------
 
 #include <limits>
+#include <list>
 #include <boost/filesystem.hpp>
 #include "pngwriter.h"
 
@@ -25,6 +26,13 @@ enum meta_type {
   meta_type_group
 };
 
+/// @enum     output_layout
+/// @brief    Layout of Block data in "data" output files
+enum output_layout {
+  output_layout_block,   // one group per Block, one dataset per array
+  output_layout_level    // one group per level, arrays concatenated
+};
+
 //----------------------------------------------------------------------
 // Component class includes
 //----------------------------------------------------------------------
@@ -45,6 +53,7 @@ enum meta_type {
 #include "io_OutputImage.hpp"
 #include "io_OutputData.hpp"
 #include "io_OutputCheckpoint.hpp"
+#include "io_OutputStage.hpp"
 
 #include "io_Schedule.hpp"
 #include "io_ScheduleList.hpp"
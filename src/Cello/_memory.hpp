@@ -14,14 +14,20 @@
 
 #include <stdio.h>
 
+#include <stdlib.h>
+
 #include <stack>
 #include <memory>
+#include <vector>
+#include <algorithm>
 
 //----------------------------------------------------------------------
 // Component class includes
 //----------------------------------------------------------------------
 
 #include "memory_Memory.hpp"
+#include "memory_Scratch.hpp"
+#include "memory_Pool.hpp"
 
 #endif /* _MEMORY_HPP */
 
@@ -98,6 +98,7 @@ enum adapt_type {
 class Tree;
 
 #include "mesh_Index.hpp"
+#include "mesh_RefreshPlan.hpp"
 
 #include "mesh_Block.hpp"
 #include "mesh_Hierarchy.hpp"
@@ -9,12 +9,16 @@
 
 //======================================================================
 
-MappingTree::MappingTree(int nx, int ny, int nz)
-  :  CkArrayMap()
+MappingTree::MappingTree(int nx, int ny, int nz, int rank, int curve)
+  :  CkArrayMap(),
+     nx_(nx),ny_(ny),nz_(nz),
+     rank_(rank),
+     curve_(curve),
+     bits_(0),
+     root_key_()
 {
-  nx_ = nx;
-  ny_ = ny;
-  nz_ = nz;
+  const int n = std::max(nx,std::max(ny,nz));
+  while ((1 << bits_) < n) ++bits_;
 }
 
 //----------------------------------------------------------------------
@@ -30,13 +34,18 @@ int MappingTree::procNum(int, const CkArrayIndex &idx) {
   Index in;
   in.set_values(v3);
 
-  const int level = in.level();
+  // Sub-root levels use their own (coarsened) root array
+
+  const int level = std::max(0,in.level());
+
+  ASSERT3 ("MappingTree::procNum()",
+	   "Curve key of %d bits for level %d exceeds %d bits",
+	   rank_*(bits_+level),level,62,
+	   rank_*(bits_+level) <= 62);
 
   int iax,iay,iaz;
-  int itx,ity,itz;
   in.array (&iax,&iay,&iaz);
-  in.tree  (&itx,&ity,&itz);
-  
+
   int ix=iax;
   int iy=iay;
   int iz=iaz;
@@ -48,8 +57,104 @@ int MappingTree::procNum(int, const CkArrayIndex &idx) {
     iz = (iz<<1) | icz;
   }
 
-  int index = (ix + nx_*(iy + ny_*iz)) % CkNumPes();
+  // The curve visits each root Block's subtree contiguously, so split
+  // the key into the root Block's position along the curve and the
+  // position within its subtree
+
+  const int shift = rank_*level;
+  const long long key   = key_(ix,iy,iz,bits_+level);
+  const long long child = key & ((1LL << shift) - 1);
+
+  const std::vector<long long> & root_key = root_key_level_(level);
+
+  const long long root =
+    std::lower_bound(root_key.begin(),root_key.end(),key >> shift)
+    - root_key.begin();
+
+  // Assign equal-length segments of the curve at this level to
+  // consecutive processes
+
+  const long long num_keys = (long long)(root_key.size()) << shift;
+  const long long index_key = (root << shift) | child;
+
+  const int num_pes = CkNumPes();
 
-  return index;
+  int index = (long double)(index_key) * num_pes / num_keys;
+
+  return std::min(index, num_pes - 1);
 }
 
+//----------------------------------------------------------------------
+
+const std::vector<long long> & MappingTree::root_key_level_ (int level)
+{
+  if ((int)root_key_.size() <= level) root_key_.resize(level+1);
+
+  std::vector<long long> & root_key = root_key_[level];
+
+  if (root_key.size() == 0) {
+    const int shift = rank_*level;
+    root_key.reserve(nx_*ny_*nz_);
+    for (int iz=0; iz<nz_; iz++) {
+      for (int iy=0; iy<ny_; iy++) {
+	for (int ix=0; ix<nx_; ix++) {
+	  const long long key =
+	    key_(ix<<level,iy<<level,iz<<level,bits_+level);
+	  root_key.push_back(key >> shift);
+	}
+      }
+    }
+    std::sort(root_key.begin(),root_key.end());
+  }
+
+  return root_key;
+}
+
+//----------------------------------------------------------------------
+
+long long MappingTree::curve_key
+(int curve, int rank, int ix, int iy, int iz, int bits)
+{
+  if (bits == 0) return 0;
+
+  unsigned a3[3] = {unsigned(ix), unsigned(iy), unsigned(iz)};
+
+  const int n = rank;
+
+  if (curve == mapping_curve_hilbert) {
+
+    // Convert axes to "transposed" Hilbert index: see J. Skilling,
+    // "Programming the Hilbert curve", AIP Conf. Proc. 707 (2004)
+
+    const unsigned m = 1u << (bits - 1);
+
+    for (unsigned q = m; q > 1; q >>= 1) {
+      const unsigned p = q - 1;
+      for (int i=0; i<n; i++) {
+	if (a3[i] & q) {
+	  a3[0] ^= p;
+	} else {
+	  const unsigned t = (a3[0] ^ a3[i]) & p;
+	  a3[0] ^= t;
+	  a3[i] ^= t;
+	}
+      }
+    }
+    for (int i=1; i<n; i++) a3[i] ^= a3[i-1];
+    unsigned t = 0;
+    for (unsigned q = m; q > 1; q >>= 1) {
+      if (a3[n-1] & q) t ^= q - 1;
+    }
+    for (int i=0; i<n; i++) a3[i] ^= t;
+  }
+
+  // Interleave bits, most-significant first
+
+  long long key = 0;
+  for (int j=bits-1; j>=0; j--) {
+    for (int i=0; i<n; i++) {
+      key = (key << 1) | ((a3[i] >> j) & 1);
+    }
+  }
+  return key;
+}
@@ -10,6 +10,11 @@
 
 #include "simulation.decl.h"
 
+enum mapping_curve_type {
+  mapping_curve_morton,
+  mapping_curve_hilbert
+};
+
 class MappingTree: public CkArrayMap {
 
   /// @class    MappingTree
@@ -17,18 +22,41 @@ class MappingTree: public CkArrayMap {
   /// @brief    [\ref Parallel] Class for mapping Blocks to processors
   ///
   /// This class defines how to map a 3D array of Charm++ chares to
-  /// processes
+  /// processes.  Blocks in each level are ordered along a Morton or
+  /// Hilbert space-filling curve through the root array and the
+  /// Index tree bits, and each process is assigned a contiguous
+  /// segment of the curve containing an equal share of the possible
+  /// Blocks in that level.  Since processes on the same node are
+  /// numbered consecutively, spatial neighbors are then mostly on the
+  /// same process or node.
+  ///
+  /// procNum() must return the same home process for a Block
+  /// throughout its lifetime, so it cannot depend on which Blocks
+  /// currently exist: segments are balanced by Block count only for
+  /// uniform meshes, and are not weighted by the number of Blocks in
+  /// each level.  Config therefore only allows this mapping with
+  /// mesh refinement if Balance:type is "cost", which repartitions
+  /// Blocks by cost along the same curve.
 
 public:
 
-  MappingTree(int nx, int ny, int nz);
+  MappingTree(int nx, int ny, int nz, int rank, int curve);
 
   int procNum(int, const CkArrayIndex &idx);
 
+  /// Return the key of cell (ix,iy,iz) along a mapping_curve_type
+  /// curve through a cube of 2^bits cells per axis
+  static long long curve_key
+  (int curve, int rank, int ix, int iy, int iz, int bits);
+
   /// CHARM++ migration constructor for PUP::able
   MappingTree (CkMigrateMessage *m)
     : CkArrayMap(m),
-      nx_(0),ny_(0),nz_(0)
+      nx_(0),ny_(0),nz_(0),
+      rank_(0),
+      curve_(mapping_curve_morton),
+      bits_(0),
+      root_key_()
   { }
 
   /// CHARM++ Pack / Unpack function
@@ -40,12 +68,39 @@ public:
     p | nx_;
     p | ny_;
     p | nz_;
+    p | rank_;
+    p | curve_;
+    p | bits_;
+    // root_key_ is rebuilt as needed
   }
 
-private:
+private: // functions
+
+  /// Return the curve key of the cell (ix,iy,iz) in a 2^bits cube
+  long long key_ (int ix, int iy, int iz, int bits) const
+  { return curve_key (curve_,rank_,ix,iy,iz,bits); }
+
+  /// Return the sorted curve keys of root Blocks at the given level
+  const std::vector<long long> & root_key_level_ (int level);
 
+private: // attributes
+
+  /// Size of the root array
   int nx_, ny_, nz_;
 
+  /// Dimensionality of the problem
+  int rank_;
+
+  /// Space-filling curve type, mapping_curve_morton or hilbert
+  int curve_;
+
+  /// Number of bits per axis required for the root array
+  int bits_;
+
+  /// Sorted curve keys of root Blocks indexed by level, for ranking
+  /// root Blocks along the curve
+  std::vector< std::vector<long long> > root_key_;
+
 };
 
 #endif /* CHARM_MAPPING_TREE_HPP */
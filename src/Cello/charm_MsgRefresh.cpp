@@ -21,7 +21,9 @@ MsgRefresh::MsgRefresh()
     : CMessage_MsgRefresh(),
       is_local_(true),
       data_msg_(NULL),
-      buffer_(NULL)
+      buffer_(NULL),
+      data_buffer_(NULL),
+      data_size_(0)
 {
   ++counter[cello::index_static()]; 
 }
@@ -33,6 +35,8 @@ MsgRefresh::~MsgRefresh()
   --counter[cello::index_static()];
   delete data_msg_;
   data_msg_ = 0;
+  delete [] data_buffer_;
+  data_buffer_ = 0;
 }
 
 //----------------------------------------------------------------------
@@ -49,6 +53,24 @@ void MsgRefresh::set_data_msg  (DataMsg * data_msg)
 
 //----------------------------------------------------------------------
 
+void MsgRefresh::copy_data_msg (const char * buffer, int size)
+{
+  if (data_msg_) {
+    WARNING ("MsgRefresh::copy_data_msg()",
+	     "overwriting existing data_msg_");
+    delete data_msg_;
+  }
+  delete [] data_buffer_;
+  data_buffer_ = new char [size];
+  data_size_   = size;
+  memcpy (data_buffer_,buffer,size);
+  is_local_ = false;
+  data_msg_ = new DataMsg;
+  data_msg_->load_data(data_buffer_);
+}
+
+//----------------------------------------------------------------------
+
 void * MsgRefresh::pack (MsgRefresh * msg)
 {
 #ifdef DEBUG_MSG_REFRESH
@@ -62,8 +84,9 @@ void * MsgRefresh::pack (MsgRefresh * msg)
 
   int have_data = (msg->data_msg_ != NULL);
   if (have_data) {
-    // data_msg_
-    size += msg->data_msg_->data_size();
+    // data_msg_ (already serialized if copied with copy_data_msg())
+    size += (msg->data_buffer_ != NULL) ?
+      msg->data_size_ : msg->data_msg_->data_size();
   }
 
   //--------------------------------------------------
@@ -86,7 +109,12 @@ void * MsgRefresh::pack (MsgRefresh * msg)
   have_data = (msg->data_msg_ != NULL);
   (*pi++) = have_data;
   if (have_data) {
-    pc = msg->data_msg_->save_data(pc);
+    if (msg->data_buffer_ != NULL) {
+      memcpy (pc,msg->data_buffer_,msg->data_size_);
+      pc += msg->data_size_;
+    } else {
+      pc = msg->data_msg_->save_data(pc);
+    }
   }
 
   delete msg;
@@ -157,7 +185,7 @@ void MsgRefresh::update (Data * data)
 
   data_msg_->update(data,is_local_);
 
-  if (!is_local_) {
+  if (!is_local_ && buffer_ != NULL) {
       CkFreeMsg (buffer_);
   }
 }
@@ -36,6 +36,11 @@ public: // interface
   // Set the DataMsg object
   void set_data_msg (DataMsg * data_msg);
 
+  /// Load the DataMsg object from a copy of the serialized face of
+  /// the given size, e.g. from an aggregated refresh; the copy is
+  /// owned by this message
+  void copy_data_msg (const char * buffer, int size);
+
   /// Update the Data with data stored in this message
   void update (Data * data);
 
@@ -57,6 +62,13 @@ protected: // attributes
   /// Saved Charm++ buffer for deleting after unpack()
   void * buffer_;
 
+  /// Serialized DataMsg owned by this message if created with
+  /// copy_data_msg()
+  char * data_buffer_;
+
+  /// Size of data_buffer_ in bytes
+  int data_size_;
+
 };
 
 #endif /* CHARM_MSG_HPP */
@@ -42,6 +42,56 @@ void Matrix::residual (int ir, int ib, int ix, Block * block, int g0) throw()
 
 //----------------------------------------------------------------------
 
+long double Matrix::matvec_dot (int iy, int ix, int iz,
+				Block * block, int g0) throw()
+{
+  matvec(iy,ix,block,g0);
+
+  Field field = block->data()->field();
+
+  void * Y = field.values(iy);
+  void * Z = field.values(iz);
+
+  int mx,my,mz;
+  int gx,gy,gz;
+  field.dimensions (iy,&mx,&my,&mz);
+  field.ghost_depth(iy,&gx,&gy,&gz);
+
+  int precision = field.precision(iy);
+
+  if      (precision == precision_single)    
+    return dot_((float *)(Y), (float *)(Z), mx,my,mz,gx,gy,gz);
+  else if (precision == precision_double)    
+    return dot_((double *)(Y), (double *)(Z), mx,my,mz,gx,gy,gz);
+  else if (precision == precision_quadruple) 
+    return dot_((long double *)(Y), (long double *)(Z), mx,my,mz,gx,gy,gz);
+  else 
+    ERROR1("Matrix::matvec_dot()", "precision %d not recognized", precision);
+
+  return 0.0;
+}
+
+//----------------------------------------------------------------------
+
+template <class T>
+long double Matrix::dot_ (T * y, T * z,
+			  int mx, int my, int mz,
+			  int gx, int gy, int gz) throw()
+{
+  long double dot = 0.0;
+  for (int iz=gz; iz<mz-gz; iz++) {
+    for (int iy=gy; iy<my-gy; iy++) {
+      for (int ix=gx; ix<mx-gx; ix++) {
+	const int i=ix + mx*(iy + my*iz);
+	dot += y[i]*z[i];
+      }
+    }
+  }
+  return dot;
+}
+
+//----------------------------------------------------------------------
+
 template <class T>
 void Matrix::residual_ (T * r, T * b,
 			int mx, int my, int mz,
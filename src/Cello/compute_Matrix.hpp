@@ -44,6 +44,12 @@ public: // virtual functions
   /// Apply the matrix to a vector Y <-- A*X
   virtual void matvec (int iy, int ix, Block * block, int g0=1) throw() = 0;
 
+  /// Apply the matrix Y <-- A*X and return the Block's contribution
+  /// to DOT(Y,Z) over non-ghost zones.  Matrices may override to
+  /// compute both in one pass
+  virtual long double matvec_dot (int iy, int ix, int iz,
+				  Block * block, int g0=1) throw();
+
   virtual void matvec (precision_type precision,
 		       void * y, void * x, int g0=1) throw() = 0;
   
@@ -63,6 +69,11 @@ protected: // functions
 		 int mx, int my, int mz,
 		 int ig0) throw();
 
+  template<class T>
+  long double dot_ (T * y, T * z,
+		    int mx, int my, int mz,
+		    int gx, int gy, int gz) throw();
+
 };
 
 #endif /* COMPUTE_MATRIX_HPP */
@@ -8,6 +8,15 @@
 ///
 /// This file controls adaptive mesh refinement on a distributed
 /// array of octrees.
+///
+/// Leaf Blocks agree on their new levels by exchanging desired levels
+/// with neighbors in rounds, counting the expected neighbor messages
+/// in each round.  After adapt_level_rounds rounds a single reduction
+/// determines whether any level changed in the last round, in which
+/// case more rounds are performed.  Refined and coarsened Blocks then
+/// wait only for acknowledgments from their new children or parent
+/// before contributing to the reduction that ends the adapt step,
+/// so no quiescence detection is required.
 
 //--------------------------------------------------
 // #define DEBUG_FACE
@@ -36,13 +45,13 @@
     check_child_(IC3,"PUT_LEVEL",__FILE__,__LINE__);			\
     check_face_(IF3,"PUT_LEVEL",__FILE__,__LINE__);			\
     thisProxy[INDEX_RECV].p_adapt_recv_level				\
-      (INDEX_SEND,IC3,IF3,LEVEL_NOW,LEVEL_NEW);				\
+      (INDEX_SEND,adapt_round_,IC3,IF3,LEVEL_NOW,LEVEL_NEW);		\
   }
 #else /* DEBUG_ADAPT */
 #   define PUT_LEVEL(INDEX_SEND,INDEX_RECV,IC3,IF3,LEVEL_NOW,LEVEL_NEW,MSG) \
   {									\
     thisProxy[INDEX_RECV].p_adapt_recv_level				\
-      (INDEX_SEND,IC3,IF3,LEVEL_NOW,LEVEL_NEW);				\
+      (INDEX_SEND,adapt_round_,IC3,IF3,LEVEL_NOW,LEVEL_NEW);		\
   }
 #endif /* DEBUG_ADAPT */
 
@@ -72,6 +81,10 @@
 #include "charm_simulation.hpp"
 #include "charm_mesh.hpp"
 
+/// Number of rounds of neighbor level exchange between reductions
+/// checking whether desired levels have converged
+const int adapt_level_rounds = 2;
+
 //======================================================================
 
 /// @brief First function in the adapt phase: apply local refinement criteria.
@@ -106,6 +119,14 @@ void Block::adapt_begin_()
 
   level_next_ = adapt_compute_desired_level_(level_maximum);
 
+  // Reset counters before any neighbor can send its desired level
+
+  adapt_round_         = 0;
+  adapt_round_max_     = -1;
+  adapt_round_count_[0] = 0;
+  adapt_round_count_[1] = 0;
+  adapt_round_changed_ = false;
+
   const int min_face_rank = cello::config()->adapt_min_face_rank;
   
   control_sync_neighbor (CkIndex_Block::p_adapt_called(),
@@ -118,16 +139,63 @@ void Block::adapt_begin_()
 
 /// @brief Second step of the adapt phase: tell neighbors desired level.
 ///
-/// Call adapt_send_level() to send neighbors desired
-/// levels, after which adapt_next_() is called with quiescence
-/// detection.
+/// Call adapt_send_level() to send neighbors desired levels, and
+/// continue in adapt_check_round_() when all neighbors' levels for
+/// the round have been received.  Also called to begin another
+/// batch of rounds if levels had not converged.
 void Block::adapt_called_()
 {
   trace("adapt_called 2");
 
-  adapt_send_level();
+  if (! is_leaf()) {
+    // (...non-leaf Blocks do not exchange levels)
+    int is_changed = 0;
+    contribute (sizeof(int), &is_changed, CkReduction::max_int,
+		CkCallback (CkIndex_Block::r_adapt_next(NULL), thisProxy));
+    return;
+  }
+
+  adapt_round_max_ = adapt_send_level();
+
+  adapt_check_round_();
+}
+
+//----------------------------------------------------------------------
+
+/// @brief Advance to the next round of level exchange if all
+/// neighbors' levels for the current round have been received
+///
+/// After adapt_level_rounds rounds, contribute whether level_next_
+/// changed in the last round: if no Block's level changed, then all
+/// neighbors have received final desired levels and adapt_next_() is
+/// called, otherwise another batch of rounds is started.
+void Block::adapt_check_round_()
+{
+  while (adapt_round_max_ >= 0 &&
+	 adapt_round_count_[adapt_round_ % 2] == adapt_round_max_) {
+
+    adapt_round_count_[adapt_round_ % 2] = 0;
+
+    const int is_changed = adapt_round_changed_ ? 1 : 0;
 
-  control_sync_quiescence (CkIndex_Main::p_adapt_next());
+    adapt_round_changed_ = false;
+
+    ++ adapt_round_;
+
+    if (adapt_round_ % adapt_level_rounds == 0) {
+
+      // ignore messages for the next round until the reduction returns
+      adapt_round_max_ = -1;
+
+      contribute (sizeof(int), &is_changed, CkReduction::max_int,
+		  CkCallback (CkIndex_Block::r_adapt_next(NULL), thisProxy));
+
+    } else {
+
+      adapt_send_level();
+
+    }
+  }
 }
 
 //----------------------------------------------------------------------
@@ -157,12 +225,34 @@ void Block::adapt_next_()
 
   update_levels_();
 
+  adapt_ack_count_ = 0;
+
   if (is_leaf()) {
     if (level() < level_next_) adapt_refine_();
     if (level() > level_next_) adapt_coarsen_();
   }
 
-  control_sync_quiescence (CkIndex_Main::p_adapt_end());
+  adapt_check_ack_();
+}
+
+//----------------------------------------------------------------------
+
+/// @brief Call adapt_end_() when new children have been created
+/// (refine) or the parent has received this Block's data (coarsen).
+void Block::adapt_check_ack_()
+{
+  if (adapt_ack_count_ == 0) adapt_end_();
+}
+
+//----------------------------------------------------------------------
+
+void Block::p_adapt_child_ready()
+{
+  performance_start_(perf_adapt_end);
+  -- adapt_ack_count_;
+  adapt_check_ack_();
+  performance_stop_(perf_adapt_end);
+  performance_start_(perf_adapt_end_sync);
 }
 
 //----------------------------------------------------------------------
@@ -171,16 +261,14 @@ void Block::adapt_next_()
 /// been coarsened
 ///
 /// This step deletes itself if it has been coarsened in this adapt
-/// phase, then exits the adapt phase by directly calling adapt_exit_().
-/// This is a separate phase since the quiescence call of this function
-/// from the previous adapt_next_() step includes Block's that have
-/// been deleted.  
+/// phase, otherwise it contributes to the reduction that calls
+/// adapt_done_() once all Blocks, including newly created ones, have
+/// ended the adapt step.  Deleted Blocks are removed from the
+/// reduction by Charm++.
 void Block::adapt_end_()
 {
   trace("adapt_end 4");
 
-  if (index_.is_root()) thisProxy.doneInserting();
-
   if (delete_) {
 #ifdef DEBUG_ADAPT
   CkPrintf ("%s DESTROY\n",name().c_str());
@@ -193,6 +281,38 @@ void Block::adapt_end_()
   for (size_t i=0; i<face_level_last_.size(); i++)
     face_level_last_[i] = -1;
 
+  // Discard cached refresh plans if neighboring faces changed
+
+  if (refresh_plan_changed_()) refresh_plan_clear_();
+
+  // End insertion before the barrier, since reductions over the
+  // Block array do not complete while elements are being inserted.
+  // All children created by this Block have acknowledged, and since
+  // children are inserted on their parent's process, ending insertion
+  // on the local branch after each Block covers Blocks that refine
+  // after the root Block has reached this step
+
+  if (index_.is_root()) thisProxy.doneInserting();
+
+  thisProxy.ckLocalBranch()->remoteDoneInserting();
+
+  control_sync_barrier (CkIndex_Block::r_adapt_end(NULL));
+}
+
+//----------------------------------------------------------------------
+
+/// @brief Fifth step of the adapt phase: repeat or exit the adapt phase
+///
+/// Called when all Blocks have ended the adapt step.  On the initial
+/// cycle the adapt phase is repeated to refine up to the maximum
+/// level, otherwise the adapt phase is exited.
+void Block::adapt_done_()
+{
+  trace("adapt_done 5");
+
+  // Coarsened children have all sent their data, since each waits
+  // for p_adapt_delete() from its parent before ending the step
+
   const int rank = cello::rank();
   sync_coarsen_.set_stop(NUM_CHILDREN(rank));
   sync_coarsen_.reset();
@@ -204,11 +324,10 @@ void Block::adapt_end_()
   bool adapt_again = (is_first_cycle && (adapt_step_++ < level_maximum));
 
   if (adapt_again) {
-    control_sync_quiescence (CkIndex_Main::p_adapt_enter());
+    adapt_enter_();
   } else {
-    control_sync_quiescence (CkIndex_Main::p_adapt_exit());
+    adapt_exit_();
   }
-
 }
 
 //----------------------------------------------------------------------
@@ -218,7 +337,9 @@ bool Block::do_adapt_()
 {
   int adapt_interval = cello::config()->adapt_interval;
 
-  return ((adapt_interval && ((cycle_ % adapt_interval) == 0)));
+  // (...only adapt when all levels are at the same time if subcycling)
+  return ((adapt_interval && ((cycle_ % adapt_interval) == 0)) &&
+	  subcycle_is_synchronized_());
 }
 
 //----------------------------------------------------------------------
@@ -377,6 +498,9 @@ void Block::adapt_refine_()
 
       children_.push_back(index_child);
 
+      // wait for the child to acknowledge its creation
+      ++ adapt_ack_count_;
+
     }
   }
 
@@ -525,9 +649,9 @@ void Block::adapt_delete_child_(Index index_child)
 
 //----------------------------------------------------------------------
 
-void Block::adapt_send_level()
+int Block::adapt_send_level()
 {
-  if (!is_leaf()) return;
+  if (!is_leaf()) return 0;
 
   const int level = this->level();
   const int min_face_rank = cello::config()->adapt_min_face_rank;
@@ -536,12 +660,15 @@ void Block::adapt_send_level()
 					     neighbor_leaf,min_level,0);
   int of3[3];
 
+  int count = 0;
   while (it_neighbor.next(of3)) {
     Index index_neighbor = it_neighbor.index();
     int ic3[3];
     it_neighbor.child(ic3);
     PUT_LEVEL (index_,index_neighbor,ic3,of3,level,level_next_,"send");
+    ++count;
   }
+  return count;
 }
 
 //----------------------------------------------------------------------
@@ -549,6 +676,7 @@ void Block::adapt_send_level()
 /// @brief Entry function for receiving desired level of a neighbor
 ///
 /// @param index_send      mesh index of the calling neighbor
+/// @param round           round of the level exchange
 /// @param ic3             child indices of neighbor if it's in a finer level
 /// @param if3             face (inward) shared with neighbor
 /// @param level_face_curr neighbor's current level
@@ -562,6 +690,7 @@ void Block::adapt_send_level()
 void Block::p_adapt_recv_level
 (
  Index index_send,
+ int round,
  int ic3[3],
  int if3[3], 
  int level_face_curr,
@@ -569,6 +698,9 @@ void Block::p_adapt_recv_level
  )
 {
   performance_start_(perf_adapt_update);
+
+  // (...neighbors may be at most one round ahead)
+  ++ adapt_round_count_[round % 2];
   
   if (index_send.level() != level_face_curr) {
     PARALLEL_PRINTF 
@@ -600,6 +732,7 @@ void Block::p_adapt_recv_level
 #endif
 
   if (skip_face_update) {
+    adapt_check_round_();
     performance_stop_(perf_adapt_update);
     performance_start_(perf_adapt_update_sync);
     return;
@@ -649,8 +782,8 @@ void Block::p_adapt_recv_level
   //       occur).
   //
   // If either of these cases is true, then change the desired level
-  // to the current level (neither coarsen nor refine) and re-send
-  // desired level to neighbors
+  // to the current level (neither coarsen nor refine), which is sent
+  // to neighbors in the next round
 
   const bool is_coarsening = (level_next < level);
 
@@ -701,15 +834,18 @@ void Block::p_adapt_recv_level
   // restrict new level to within 1 of neighbor
   level_next = std::max(level_next,level_face_new - 1);
 	  
-  // notify neighbors if level_next has changed
+  // record whether level_next has changed
 
   if (level_next != level_next_) {
     ASSERT2 ("Block::p_adapt_recv_level()",
 	     "level_next %d level_next_ %d\n", level_next,level_next_,
 	     level_next > level_next_);
     level_next_ = level_next;
-    adapt_send_level();
+    adapt_round_changed_ = true;
   }
+
+  adapt_check_round_();
+
   performance_stop_(perf_adapt_update);
   performance_start_(perf_adapt_update_sync);
 }
@@ -847,6 +983,9 @@ void Block::adapt_coarsen_()
   MsgCoarsen * msg = new MsgCoarsen (nf,face_level_curr_,ic3);
   msg->set_data_msg (data_msg);
 
+  // wait for the parent to acknowledge receiving the data
+  ++ adapt_ack_count_;
+
   thisProxy[index_parent].p_adapt_recv_child (msg);
   
 }
@@ -888,6 +1027,9 @@ void Block::p_adapt_recv_child (MsgCoarsen * msg)
   // I am a leaf on the wind
   is_leaf_=true;
 
+  // (...refresh plans may already have been checked in adapt_end_())
+  refresh_plan_clear_();
+
 #ifdef DEBUG_ADAPT
   CkPrintf ("%s p_adapt_recv_child is_leaf <- 1\n",name().c_str());
 #endif
@@ -915,6 +1057,8 @@ void Block::p_adapt_delete()
   CkPrintf ("%s DELETING\n",name().c_str());
 #endif
   delete_ = true;
+  -- adapt_ack_count_;
+  adapt_check_ack_();
   performance_stop_(perf_adapt_end);
   performance_start_(perf_adapt_end_sync);
 }
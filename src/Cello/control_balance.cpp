@@ -0,0 +1,245 @@
+// See LICENSE_CELLO file for license and copyright information
+
+/// @file     control_balance.cpp
+/// @author   James Bordner (jobordner@ucsd.edu)
+/// @date     2020-03-02
+/// @brief    Cost-model load balancing of Blocks along a space-filling curve
+/// @ingroup  Control
+///
+///    BALANCE (Balance:type = "cost")
+///
+///    Block::p_stopping_balance()
+///       Block::balance_cost_enter_()
+///          contribute( >>>>> Simulation::r_balance_plan() >>>>> )
+///    Simulation::r_balance_plan()  [root process]
+///       order Blocks along curve, partition by cost
+///       Block::p_balance_migrate() >>>>> migrateMe()
+///       CkStartQD( >>>>> Block::p_balance_exit() >>>>> )
+///    Block::p_balance_exit()
+///       doneInserting()
+///       stopping_exit_()
+///
+///    The plan is computed serially on the root process from one
+///    record per Block, which takes O(B log B) time and O(B) memory
+///    for B Blocks.  This is adequate for up to roughly 10^6 Blocks;
+///    beyond that the records and the sort would need to be
+///    distributed, e.g. by sorting curve keys in parallel.
+
+#include "simulation.hpp"
+#include "mesh.hpp"
+#include "control.hpp"
+
+#include "charm_simulation.hpp"
+#include "charm_mesh.hpp"
+
+// #define TRACE_BALANCE
+
+/// Per-Block data gathered by the cost-model load balancer
+struct BalanceRecord {
+  int v3[3];
+  int ip;
+  int num_cells;
+  int num_particles;
+  int num_cycles;
+  double time;
+};
+
+//----------------------------------------------------------------------
+
+void Block::balance_cost_enter_()
+{
+  BalanceRecord record;
+
+  index_.values(record.v3);
+  record.ip = CkMyPe();
+
+  int nx,ny,nz;
+  data()->field().size(&nx,&ny,&nz);
+  record.num_cells     = nx*ny*nz;
+  record.num_particles = data()->particle().num_particles();
+  record.num_cycles    = cycle_ - balance_cycle_;
+  record.time          = balance_time_;
+
+  // restart cost measurement for the next balancing step
+
+  balance_time_  = 0.0;
+  balance_cycle_ = cycle_;
+
+  CkCallback callback
+    (CkIndex_Simulation::r_balance_plan(NULL), 0, proxy_simulation);
+
+  contribute (sizeof(BalanceRecord), &record, CkReduction::concat, callback);
+}
+
+//----------------------------------------------------------------------
+
+void Block::p_balance_migrate(int ip)
+{
+#ifdef TRACE_BALANCE
+  CkPrintf ("%d %s TRACE_BALANCE migrate to %d\n",
+	    CkMyPe(),name_.c_str(),ip);
+#endif
+  migrateMe(ip);
+}
+
+//----------------------------------------------------------------------
+
+void Block::p_balance_exit()
+{
+  performance_start_(perf_stopping);
+#ifdef TRACE_BALANCE
+  CkPrintf ("%d %s TRACE_BALANCE exit\n",CkMyPe(),name_.c_str());
+#endif
+
+  // as in ResumeFromSync()
+
+  if (index_.is_root()) {
+    thisProxy.doneInserting();
+  }
+  stopping_exit_();
+  performance_stop_(perf_stopping);
+}
+
+//----------------------------------------------------------------------
+
+void Simulation::r_balance_plan(CkReductionMsg * msg)
+{
+  const int n = msg->getSize() / sizeof(BalanceRecord);
+  BalanceRecord * record = (BalanceRecord *) msg->getData();
+
+  // Fit cost per cycle ~ a*cells + b*particles to Blocks with
+  // measured times, for estimating costs of Blocks created since the
+  // last balancing step
+
+  double scc=0.0, scp=0.0, spp=0.0, sct=0.0, spt=0.0, st=0.0, sc=0.0;
+  for (int i=0; i<n; i++) {
+    const BalanceRecord & r = record[i];
+    if (r.num_cycles > 0 && r.time > 0.0) {
+      const double t = r.time / r.num_cycles;
+      const double c = r.num_cells;
+      const double p = r.num_particles;
+      scc += c*c;  scp += c*p;  spp += p*p;
+      sct += c*t;  spt += p*t;
+      st  += t;    sc  += c;
+    }
+  }
+
+  double a = (sc > 0.0) ? st / sc : 1.0;
+  double b = a;
+  const double det = scc*spp - scp*scp;
+  if (det > 1e-12*scc*spp) {
+    const double a_fit = (sct*spp - spt*scp) / det;
+    const double b_fit = (spt*scc - sct*scp) / det;
+    if (a_fit >= 0.0 && b_fit >= 0.0) {
+      a = a_fit;
+      b = b_fit;
+    }
+  }
+
+  std::vector<double> cost (n);
+  for (int i=0; i<n; i++) {
+    const BalanceRecord & r = record[i];
+    cost[i] = (r.num_cycles > 0 && r.time > 0.0) ?
+      r.time / r.num_cycles : a*r.num_cells + b*r.num_particles;
+  }
+
+  // Order Blocks along the space-filling curve at the finest level
+
+  const int rank = cello::rank();
+  // Config ensures balance_mapping is "morton" or "hilbert"
+
+  const int curve = (config_->balance_mapping == "morton") ?
+    mapping_curve_morton : mapping_curve_hilbert;
+
+  int max_level = 0;
+  for (int i=0; i<n; i++) {
+    Index index;
+    index.set_values(record[i].v3);
+    max_level = std::max(max_level,index.level());
+  }
+
+  int bits = 0;
+  const int nb = std::max(config_->mesh_root_blocks[0],
+			  std::max(config_->mesh_root_blocks[1],
+				   config_->mesh_root_blocks[2]));
+  while ((1 << bits) < nb) ++bits;
+  bits += max_level;
+
+  ASSERT2 ("Simulation::r_balance_plan()",
+	   "Curve key of %d bits exceeds %d bits",
+	   rank*bits, 62, rank*bits <= 62);
+
+  std::vector< std::pair<long long,int> > order (n);
+  for (int i=0; i<n; i++) {
+    Index index;
+    index.set_values(record[i].v3);
+    const int level = index.level();
+    int ix,iy,iz;
+    index.array (&ix,&iy,&iz);
+    for (int l=0; l<level; l++) {
+      int icx=0,icy=0,icz=0;
+      index.child(l+1,&icx,&icy,&icz);
+      ix = (ix<<1) | icx;
+      iy = (iy<<1) | icy;
+      iz = (iz<<1) | icz;
+    }
+    const int shift = max_level - level;
+    order[i].first = MappingTree::curve_key
+      (curve, rank, ix << shift, iy << shift, iz << shift, bits);
+    order[i].second = i;
+  }
+
+  std::sort (order.begin(),order.end());
+
+  // Assign contiguous segments of equal cost to processes
+
+  const int num_pes = CkNumPes();
+
+  double cost_total = 0.0;
+  for (int i=0; i<n; i++) cost_total += cost[i];
+
+  std::vector<double> load_before (num_pes,0.0);
+  std::vector<double> load_after  (num_pes,0.0);
+
+  const double cost_pe = (cost_total > 0.0) ? cost_total / num_pes : 1.0;
+
+  CProxy_Block block_array = cello::block_array();
+
+  int num_migrate = 0;
+  double cost_prefix = 0.0;
+  for (int k=0; k<n; k++) {
+    const int i = order[k].second;
+    const double cost_mid = cost_prefix + 0.5*cost[i];
+    const int ip = std::min (int(cost_mid / cost_pe), num_pes - 1);
+    cost_prefix += cost[i];
+
+    load_before[record[i].ip] += cost[i];
+    load_after[ip] += cost[i];
+
+    if (ip != record[i].ip) {
+      Index index;
+      index.set_values(record[i].v3);
+      block_array[index].p_balance_migrate(ip);
+      ++num_migrate;
+    }
+  }
+
+  delete msg;
+
+  const double load_avg = cost_total / num_pes;
+  const double max_before =
+    *std::max_element(load_before.begin(),load_before.end());
+  const double max_after =
+    *std::max_element(load_after.begin(),load_after.end());
+
+  cello::monitor()->print
+    ("Balance","cost model migrating %d of %d Blocks: "
+     "max/avg load %5.3f -> %5.3f",
+     num_migrate, n,
+     (load_avg > 0.0) ? max_before/load_avg : 1.0,
+     (load_avg > 0.0) ? max_after/load_avg  : 1.0);
+
+  // Resume the cycle once all migrations have completed
+
+  CkStartQD (CkCallback(CkIndex_Block::p_balance_exit(), block_array));
+}
@@ -37,6 +37,13 @@ void Block::compute_begin_ ()
 
   cello::simulation()->set_phase(phase_compute);
 
+  // When subcycling, save values at the start of each step for
+  // interpolating ghost zones of finer Blocks in time
+
+  if (cello::config()->method_subcycle && subcycle_is_step_()) {
+    data()->field().save_history(time_);
+  }
+
   index_method_ = 0;
   compute_next_();
 }
@@ -56,6 +63,13 @@ void Block::compute_next_ ()
 
     Refresh * refresh = method->refresh();
 
+    // Skip the Refresh if it was merged into an earlier Method's
+
+    if (refresh && method->is_refresh_merged()) {
+      ++Refresh::counter_merged[cello::index_static()];
+      refresh = NULL;
+    }
+
     if (refresh) {
 
       refresh->set_active (is_leaf());
@@ -91,9 +105,18 @@ void Block::compute_continue_ ()
 
   Method * method = this->method();
   Schedule * schedule = method->schedule();
+
+  // When subcycling, Methods that reduce over all Blocks are only
+  // applied in cycles when all levels step, so that no Block skips
+  // the reduction
+
+  const bool is_step = method->is_global_reduction() ?
+    subcycle_is_synchronized_() : subcycle_is_step_();
+
   bool is_scheduled = 
-    (schedule==NULL) ||
-    (schedule->write_this_cycle(cycle_,time_));
+    ((schedule==NULL) ||
+     (schedule->write_this_cycle(cycle_,time_))) &&
+    is_step;
 
   if (is_scheduled) {
 
@@ -144,12 +167,18 @@ void Block::compute_end_ ()
   //  traceUserBracketEvent(10,time_start, CmiWallTimer());
 #endif
 
-  // Push back fields if saving old ones
-  data()->field().save_history(time_);
+  const bool is_step = subcycle_is_step_();
+
+  // Push back fields if saving old ones (saved in compute_begin_()
+  // instead if subcycling)
+  if (! cello::config()->method_subcycle) {
+    data()->field().save_history(time_);
+  }
 
-  // Update block cycle and time
+  // Update block cycle and time (time only if this Block's level
+  // took a step this cycle)
   set_cycle (cycle_ + 1);
-  set_time  (time_  + dt_);
+  if (is_step) set_time (time_ + dt_);
 
   // Update Simulation cycle and time (redundant)
   cello::simulation()->set_cycle(cycle_);
@@ -82,8 +82,79 @@ void Simulation::r_initialize_block_array(CkReductionMsg * msg)
   TRACE_INITIALIZE;
   performance_->start_region(perf_initial);
   delete msg;
-  
-  initialize_block_array_();
+
+  if (problem_->initial_is_collective()) {
+
+    // Read initial data collectively before creating Blocks, using
+    // QD to ensure that p_set_block_array() has been called on all
+    // processes, since readers need the Block array map to find
+    // which process each Block will be created on
+
+    if (CkMyPe() == 0) {
+      CkStartQD
+	(CkCallback(CkIndex_Simulation::p_initial_read(), thisProxy));
+    }
+
+  } else {
+
+    initialize_block_array_();
+
+  }
+}
+
+//----------------------------------------------------------------------
+
+void Simulation::p_initial_read()
+{
+  TRACE_INITIALIZE;
+
+  // files opened, datasets read, bytes read, seconds reading
+  double stats[4] = {0.0, 0.0, 0.0, 0.0};
+
+  problem_->initial_read_collective(hierarchy_,stats);
+
+  CkCallback callback
+    (CkIndex_Simulation::r_initial_read(NULL), thisProxy[0]);
+
+  contribute(4*sizeof(double),stats,CkReduction::sum_double,callback);
+}
+
+//----------------------------------------------------------------------
+
+void Simulation::r_initial_read(CkReductionMsg * msg)
+{
+  TRACE_INITIALIZE;
+
+  double * stats = (double *) msg->getData();
+
+  const double mbytes = stats[2] / (1024.0*1024.0);
+
+  // seconds are summed over readers, so throughput is per reader
+
+  Monitor * monitor = Monitor::instance();
+  monitor->print ("Initial", "collective read files opened   %ld",
+		  long(stats[0]));
+  monitor->print ("Initial", "collective read hyperslabs     %ld",
+		  long(stats[1]));
+  monitor->print ("Initial", "collective read data MB        %.3f",mbytes);
+  if (stats[3] > 0.0) {
+    monitor->print ("Initial", "collective read MB/s per proc  %.3f",
+		    mbytes / stats[3]);
+  }
+
+  delete msg;
+
+  // Create Blocks after all initial data have arrived
+
+  CkStartQD
+    (CkCallback(CkIndex_Simulation::p_initialize_block_array(), thisProxy[0]));
+}
+
+//----------------------------------------------------------------------
+
+void Simulation::p_initial_data(int index_initial, int n, char * buffer)
+{
+  problem_->initial(index_initial)->receive_collective(n,buffer);
 }
 
 //----------------------------------------------------------------------
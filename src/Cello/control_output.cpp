@@ -25,6 +25,12 @@
 
 void Block::output_enter_ ()
 {
+  // Skip output unless all levels are at the same time if subcycling
+  if (! subcycle_is_synchronized_()) {
+    output_exit_();
+    return;
+  }
+
   performance_start_(perf_output);
 #ifdef NEW_OUTPUT
   new_output_begin_();
@@ -196,6 +202,13 @@ void Simulation::output_start(int index_output)
 {
   TRACE_OUTPUT("Simulation::output_start()");
   Output * output = problem()->output(index_output);
+
+  // Finish any asynchronous data output before checkpointing, since
+  // staged Block data are not saved in the checkpoint
+  if (dynamic_cast<OutputCheckpoint *>(output) != NULL) {
+    problem()->output_flush();
+  }
+
   output->init();
   output->open();
   index_output_ = index_output;
@@ -284,39 +297,10 @@ void Problem::output_wait(Simulation * simulation) throw()
 {
   TRACE_OUTPUT("Problem::output_wait()");
   
-  Output * output = this->output(index_output_);
-
-  const int ip = CkMyPe();
-  const int np = CkNumPes();
-  const int ip_write = output->process_writer();
-
-  if (ip == ip_write) {
-
-    output_write(simulation,0,0);
-
-  } else {
-
-    int n=0;  char * buffer = 0;
-
-    // Copy / alias buffer array of data to send
-    output->prepare_remote(&n,&buffer);
-
-    // Send data to writing process
-    proxy_simulation[ip_write].p_output_write (n, buffer);
+  // Count this process's own data, after which non-writers send
+  // theirs on once any data from other processes have arrived
 
-    // Deallocate buffer
-    output->cleanup_remote(&n,&buffer);
-
-    output->close();
-    output->finalize();
-    output_next(simulation);
-    
-    const int stride = output->stride_wait();
-    const int ip_next = ip+1;
-    if (ip_next%stride != 0 && ip_next < np) {
-      proxy_simulation[ip_next].p_output_start(index_output_);
-    }
-  }
+  output_write(simulation,0,0);
 }
 
 //----------------------------------------------------------------------
@@ -347,6 +331,21 @@ void Problem::output_write
 
     TRACE_OUTPUT("Problem::output_write(): sync_write()->next() = true");
 
+    if (! output->is_writer()) {
+
+      int n_remote=0;  char * buffer_remote = 0;
+
+      // Copy / alias buffer array of data to send
+      output->prepare_remote(&n_remote,&buffer_remote);
+
+      // Send data to writing (or combining) process
+      proxy_simulation[output->process_remote()].p_output_write
+	(n_remote, buffer_remote);
+
+      // Deallocate buffer
+      output->cleanup_remote(&n_remote,&buffer_remote);
+    }
+
     output->close();
     output->finalize();
     output_next(simulation);
@@ -366,6 +365,43 @@ void Problem::output_write
 
 //----------------------------------------------------------------------
 
+void Simulation::p_output_drain (int index_output)
+{
+  TRACE_OUTPUT("Simulation::p_output_drain()");
+  performance_->start_region(perf_output);
+
+  // Writing one Block per message lets Block computation proceed
+  // between writes
+
+  Output * output = problem()->output(index_output);
+  if (output->drain()) {
+    thisProxy[CkMyPe()].p_output_drain(index_output);
+  }
+
+  performance_->stop_region(perf_output);
+}
+
+//----------------------------------------------------------------------
+
+void Simulation::p_output_flush()
+{
+  TRACE_OUTPUT("Simulation::p_output_flush()");
+  problem()->output_flush();
+  contribute(CkCallback (CkIndex_Simulation::r_output_flush(NULL),
+			 thisProxy[0]));
+}
+
+//----------------------------------------------------------------------
+
+void Simulation::r_output_flush(CkReductionMsg * msg)
+{
+  TRACE_OUTPUT("Simulation::r_output_flush()");
+  delete msg;
+  proxy_main.p_exit(1);
+}
+
+//----------------------------------------------------------------------
+
 void Simulation::output_exit()
 {
   TRACE_OUTPUT("Simulation::output_exit()");
@@ -24,6 +24,49 @@
 #  define TRACE_REFRESH(msg,REFRESH) /* NOTHING */
 #endif
 
+/// Scratch arrays for Block::particle_scatter_neighbors_(), grown as
+/// needed and reused for all batches and Blocks on the process
+struct ParticleScatterScratch {
+
+  ParticleScatterScratch()
+    : capacity(0), x(NULL), y(NULL), z(NULL), index(NULL), mask(NULL)
+  { }
+
+  ~ParticleScatterScratch()
+  { deallocate(); }
+
+  void reserve (int np)
+  {
+    if (np > capacity) {
+      deallocate();
+      capacity = np;
+      x     = new double [np];
+      y     = new double [np];
+      z     = new double [np];
+      index = new int    [np];
+      mask  = new bool   [np];
+    }
+  }
+
+  void deallocate ()
+  {
+    delete [] x;
+    delete [] y;
+    delete [] z;
+    delete [] index;
+    delete [] mask;
+  }
+
+  int capacity;
+  double * x;
+  double * y;
+  double * z;
+  int *    index;
+  bool *   mask;
+};
+
+static ParticleScatterScratch particle_scatter_scratch[CONFIG_NODE_SIZE];
+
 //----------------------------------------------------------------------
 
 void Block::refresh_enter (int callback, Refresh * refresh) 
@@ -128,12 +171,78 @@ void Block::p_refresh_store (MsgRefresh * msg)
 }
 
 
+//----------------------------------------------------------------------
+
+void Block::refresh_store_packed (char * buffer)
+{
+  performance_start_(perf_refresh_store);
+
+  // buffer remains valid for the call, so the DataMsg can refer to
+  // its field array without copying it
+
+  DataMsg data_msg;
+  data_msg.load_data(buffer);
+  data_msg.update(data(),false);
+
+  Refresh * refresh = this->refresh();
+  TRACE_REFRESH("refresh_store_packed()",refresh);
+
+  control_sync_count(CkIndex_Block::p_refresh_exit(),
+		     refresh->sync_store(),0);
+
+  performance_stop_(perf_refresh_store);
+}
+
 //----------------------------------------------------------------------
 
 int Block::refresh_load_field_faces_ (Refresh *refresh)
 {
+  // Faces bound for Blocks on remote processes, grouped by process
+  // so that they can be sent in a single message per process
 
-  int count = 0;
+  std::map<int, std::vector< std::pair<Index,DataMsg *> > > face_list;
+
+  RefreshPlan * refresh_plan = refresh_plan_(refresh);
+
+  const int count = refresh_plan->num_faces();
+
+  for (int i=0; i<count; i++) {
+    refresh_load_field_face_
+      (refresh_plan->index(i),
+       refresh_plan->field_face(i,refresh),
+       face_list);
+  }
+
+  refresh_send_field_faces_(face_list);
+
+  return count;
+}
+
+//----------------------------------------------------------------------
+
+RefreshPlan * Block::refresh_plan_ (Refresh * refresh)
+{
+  const int id = refresh->sync_id();
+
+  ASSERT1 ("Block::refresh_plan_()",
+	   "Refresh sync_id %d must be non-negative",
+	   id, id >= 0);
+
+  if (id >= refresh_plan_list_.size()) {
+    refresh_plan_list_.resize(id+1,NULL);
+  }
+
+  RefreshPlan * refresh_plan = refresh_plan_list_[id];
+
+  if (refresh_plan != NULL && refresh_plan->matches(refresh)) {
+    return refresh_plan;
+  }
+
+  // Build the plan: same neighbor iteration and refresh type
+  // classification as before caching
+
+  delete refresh_plan;
+  refresh_plan = refresh_plan_list_[id] = new RefreshPlan(refresh);
 
   const int min_face_rank = refresh->min_face_rank();
   const int neighbor_type = refresh->neighbor_type();
@@ -165,8 +274,9 @@ int Block::refresh_load_field_faces_ (Refresh *refresh)
 	(level_face == level)     ? refresh_same :
 	(level_face == level + 1) ? refresh_fine : refresh_unknown;
 
-      refresh_load_field_face_ (refresh_type,index_neighbor,if3,ic3);
-      ++count;
+      refresh_plan->add_face
+	(index_neighbor,
+	 refresh_create_field_face_(refresh_type,if3,ic3,refresh));
     }
 
   } else if (neighbor_type == neighbor_level) {
@@ -185,59 +295,256 @@ int Block::refresh_load_field_faces_ (Refresh *refresh)
 	
 	Index index_face = it_face.index();
 	int ic3[3] = {0,0,0};
-	refresh_load_field_face_ (refresh_same,index_face,if3,ic3);
-	++count;
+	refresh_plan->add_face
+	  (index_face,
+	   refresh_create_field_face_(refresh_same,if3,ic3,refresh));
       }
 
     }
   }
 
-  return count;
+  return refresh_plan;
 }
 
 //----------------------------------------------------------------------
 
-void Block::refresh_load_field_face_
-( int refresh_type,
-  Index index_neighbor,
-  int if3[3],
-  int ic3[3])
+void Block::refresh_plan_clear_ ()
+{
+  for (size_t i=0; i<refresh_plan_list_.size(); i++) {
+    delete refresh_plan_list_[i];
+    refresh_plan_list_[i] = NULL;
+  }
+  refresh_plan_face_level_       = face_level_curr_;
+  refresh_plan_child_face_level_ = child_face_level_curr_;
+  refresh_plan_is_leaf_          = is_leaf();
+}
 
+//----------------------------------------------------------------------
+
+bool Block::refresh_plan_changed_ () const
 {
-  //  TRACE_REFRESH("refresh_load_field_face()");
+  return (refresh_plan_face_level_       != face_level_curr_ ||
+	  refresh_plan_child_face_level_ != child_face_level_curr_ ||
+	  refresh_plan_is_leaf_          != is_leaf());
+}
 
-  // REFRESH FIELDS
+//----------------------------------------------------------------------
 
+FieldFace * Block::refresh_create_field_face_
+(int refresh_type, int if3[3], int ic3[3], Refresh * refresh)
+{
   // ... coarse neighbor requires child index of self in parent
 
   if (refresh_type == refresh_coarse) {
     index_.child(index_.level(),ic3,ic3+1,ic3+2);
   }
 
-  // ... copy field ghosts to array using FieldFace object
   bool lg3[3] = {false,false,false};
 
-  Refresh * refresh = this->refresh();
-
   FieldFace * field_face = create_face
     (if3, ic3, lg3, refresh_type, refresh,false);
 #ifdef DEBUG_FIELD_FACE  
   CkPrintf ("%d %s:%d DEBUG_FIELD_FACE creating %p\n",CkMyPe(),__FILE__,__LINE__,field_face);
 #endif
 
+  return field_face;
+}
+
+//----------------------------------------------------------------------
+
+void Block::refresh_load_field_face_
+( Index index_neighbor,
+  FieldFace * field_face,
+  std::map<int, std::vector< std::pair<Index,DataMsg *> > > & face_list)
+
+{
+  //  TRACE_REFRESH("refresh_load_field_face()");
+
+  Refresh * refresh = this->refresh();
+
+  // ... interpolate in time for finer neighbors if subcycling
+
+  field_face->set_time_weight (subcycle_time_weight_());
+
+  Block * block_neighbor = cello::hierarchy()->find_block(index_neighbor);
+
+  if (block_neighbor != NULL) {
+
+    // Neighbor is on this process: copy (or prolong / restrict)
+    // ghost zones directly and update its sync counter, bypassing
+    // DataMsg / MsgRefresh and Charm++ message dispatch
+
+    Field field_src = data()->field();
+    Field field_dst = block_neighbor->data()->field();
+
+    field_face->face_to_face(field_src, field_dst);
+
+    block_neighbor->control_sync_count
+      (CkIndex_Block::p_refresh_exit(),refresh->sync_store(),0);
+
+    return;
+  }
+
+  // ... compute the packed array size on the cached FieldFace so
+  // that it is reused by copies in later cycles
+
+  field_face->num_bytes_array(data()->field());
+
+  // ... DataMsg gets its own copy of the cached FieldFace, since the
+  // receiver deletes it in DataMsg::update()
+
   DataMsg * data_msg = new DataMsg;
 
-  data_msg -> set_field_face (field_face,true);
+  data_msg -> set_field_face (new FieldFace(*field_face),true);
   data_msg -> set_field_data (data()->field_data(),false);
 
-  MsgRefresh * msg = new MsgRefresh;
+  // ... neighbor's process (may be out of date if the neighbor has
+  // migrated, in which case Charm++ routes the face when it is sent
+  // on to the neighbor in Simulation::p_refresh_store_list())
+
+  const int ip = thisProxy.ckLocalBranch()->lastKnown
+    (CkArrayIndexIndex(index_neighbor));
+
+  if (ip == CkMyPe()) {
+
+    // Local but not yet resident (e.g. migrating in): send
+    // directly, avoiding packing
+
+    MsgRefresh * msg = new MsgRefresh;
+
+    msg->set_data_msg (data_msg);
+
+    thisProxy[index_neighbor].p_refresh_store (msg);
+
+  } else {
+
+    // Remote: defer to refresh_send_field_faces_()
+
+    face_list[ip].push_back(std::make_pair(index_neighbor,data_msg));
+
+  }
+}
+
+//----------------------------------------------------------------------
+
+void Block::refresh_send_field_faces_
+(std::map<int, std::vector< std::pair<Index,DataMsg *> > > & face_list)
+{
+  for (auto it_pe = face_list.begin(); it_pe != face_list.end(); ++it_pe) {
+
+    const int ip = it_pe->first;
+    std::vector< std::pair<Index,DataMsg *> > & faces = it_pe->second;
+
+    const int nf = faces.size();
+
+    if (nf == 1) {
+
+      // Only one face for the process: send it as usual
+
+      MsgRefresh * msg = new MsgRefresh;
+
+      msg->set_data_msg (faces[0].second);
+
+      thisProxy[faces[0].first].p_refresh_store (msg);
+
+    } else {
+
+      // Pack all faces for the process into one buffer
+      //
+      //    [ nf | index 0 | size 0 | DataMsg 0 | index 1 | size 1 | ... ]
+
+      int n = sizeof(int);
+      for (int i=0; i<nf; i++) {
+	n += sizeof(Index) + sizeof(int) + faces[i].second->data_size();
+      }
+
+      char * buffer = new char [n];
+      char * pc = buffer;
 
-  msg->set_data_msg (data_msg);
+      memcpy (pc,&nf,sizeof(int));
+      pc += sizeof(int);
 
-  thisProxy[index_neighbor].p_refresh_store (msg);
+      for (int i=0; i<nf; i++) {
 
+	Index index    = faces[i].first;
+	DataMsg * data_msg = faces[i].second;
+
+	int size = data_msg->data_size();
+
+	memcpy (pc,&index,sizeof(Index));
+	pc += sizeof(Index);
+	memcpy (pc,&size,sizeof(int));
+	pc += sizeof(int);
+
+	pc = data_msg->save_data(pc);
+
+	delete data_msg;
+      }
+
+      ASSERT2("Block::refresh_send_field_faces_()",
+	      "buffer size mismatch %d allocated %d packed",
+	      (pc - buffer),n,
+	      (pc - buffer) == n);
+
+      proxy_simulation[ip].p_refresh_store_list (n,buffer);
+
+      delete [] buffer;
+    }
+  }
 }
 
+//----------------------------------------------------------------------
+
+void Simulation::p_refresh_store_list (int n, char * buffer)
+{
+  // Unpack the faces aggregated by Block::refresh_send_field_faces_()
+  // and store each in its destination Block
+
+  CProxy_Block block_array = hierarchy_->block_array();
+  
+  char * pc = buffer;
+
+  int nf;
+  memcpy (&nf,pc,sizeof(int));
+  pc += sizeof(int);
+
+  for (int i=0; i<nf; i++) {
+
+    Index index;
+    int size;
+    memcpy (&index,pc,sizeof(Index));
+    pc += sizeof(Index);
+    memcpy (&size,pc,sizeof(int));
+    pc += sizeof(int);
+
+    Block * block = hierarchy_->find_block(index);
+
+    if (block != NULL) {
+
+      // Block is on this process: store the face directly
+
+      block->refresh_store_packed (pc);
+
+    } else {
+
+      // Block has migrated: copy the face into a MsgRefresh and let
+      // Charm++ route it to the Block
+
+      MsgRefresh * msg = new MsgRefresh;
+
+      msg->copy_data_msg (pc,size);
+
+      block_array[index].p_refresh_store (msg);
+    }
+
+    pc += size;
+  }
+
+  ASSERT2("Simulation::p_refresh_store_list()",
+	  "buffer size mismatch %d received %d unpacked",
+	  n,(pc - buffer),
+	  (pc - buffer) == n);
+}
 
 //----------------------------------------------------------------------
 
@@ -250,24 +557,19 @@ int Block::refresh_load_particle_faces_ (Refresh * refresh)
 
   const int npa = (rank == 1) ? 4 : ((rank == 2) ? 4*4 : 4*4*4);
 
-  ParticleData * particle_array[npa];
-  ParticleData * particle_list [npa];
+  std::vector<ParticleData *> particle_array (npa,NULL);
+  std::vector<ParticleData *> particle_list  (npa,NULL);
   Index * index_list = new Index[npa];
-  
-  for (int i=0; i<npa; i++) {
-    particle_list[i]  = NULL;
-    particle_array[i] = NULL;
-  }
 
   // Sort particles that have left the Block into 4x4x4 array
   // corresponding to neighbors
 
   int nl = particle_load_faces_
-    (npa,particle_list,particle_array, index_list, refresh);
+    (npa,particle_list.data(),particle_array.data(), index_list, refresh);
 
   // Send particle data to neighbors
 
-  particle_send_(nl,index_list,particle_list);
+  particle_send_(nl,index_list,particle_list.data());
 
   delete [] index_list;
 
@@ -327,8 +629,15 @@ int Block::particle_load_faces_ (int npa,
   // ... arrays for updating positions of particles that cross
   // periodic boundaries
 
+  // neighbor_array[i] is the index into particle_list[] of the
+  // neighbor overlapping particle_array[i], or -1 if none.
+  // ParticleData objects are only created for neighbors that receive
+  // particles
+
+  std::vector<int> neighbor_array (npa,-1);
+
   int nl = particle_create_array_neighbors_
-    (refresh, particle_array,particle_list,index_list);
+    (refresh, npa, neighbor_array.data(),index_list);
 
   // Scatter particles among particle_data array
 
@@ -344,7 +653,8 @@ int Block::particle_load_faces_ (int npa,
     type_list = refresh->particle_list();
   }
 
-  particle_scatter_neighbors_(npa,particle_array,type_list, particle);
+  particle_scatter_neighbors_
+    (npa,particle_array,particle_list,neighbor_array.data(),type_list, particle);
 
   // Update positions particles crossing periodic boundaries
 
@@ -357,8 +667,8 @@ int Block::particle_load_faces_ (int npa,
 
 int Block::particle_create_array_neighbors_
 (Refresh * refresh, 
- ParticleData * particle_array[],
- ParticleData * particle_list[],
+ int npa,
+ int neighbor_array[],
  Index index_list[])
 { 
   //  TRACE_REFRESH("particle_create_array_neighbors()");
@@ -369,6 +679,8 @@ int Block::particle_create_array_neighbors_
   const int min_face_rank = refresh->min_face_rank();
   ItNeighbor it_neighbor = this->it_neighbor(min_face_rank,index_,neighbor_leaf,0,0);
 
+  for (int i=0; i<npa; i++) neighbor_array[i] = -1;
+
   int il = 0;
 
   int if3[3];
@@ -396,21 +708,13 @@ int Block::particle_create_array_neighbors_
     int index_upper[3] = {1,1,1};
     refresh->index_limits (rank,refresh_type,if3,ic3,index_lower,index_upper);
 
-    ParticleData * pd = new ParticleData;
-
-    ParticleDescr * p_descr = cello::particle_descr();
-
-    pd->allocate(p_descr);
-
-    particle_list[il] = pd;
-
     index_list[il] = it_neighbor.index();
 
     for (int iz=index_lower[2]; iz<index_upper[2]; iz++) {
       for (int iy=index_lower[1]; iy<index_upper[1]; iy++) {
 	for (int ix=index_lower[0]; ix<index_upper[0]; ix++) {
 	  int i=ix + 4*(iy + 4*iz);
-	  particle_array[i] = pd;
+	  neighbor_array[i] = il;
 	}
       }
     }
@@ -469,13 +773,9 @@ void Block::particle_apply_periodic_update_
   const int level = this->level();
   const int min_face_rank = refresh->min_face_rank();
 
-  double dpx[nl],dpy[nl],dpz[nl];
-
-  for (int i=0; i<nl; i++) {
-    dpx[i]=0.0;
-    dpy[i]=0.0;
-    dpz[i]=0.0; 
-  }
+  std::vector<double> dpx (nl,0.0);
+  std::vector<double> dpy (nl,0.0);
+  std::vector<double> dpz (nl,0.0);
 
   // Compute position updates for particles crossing periodic boundaries
 
@@ -515,6 +815,10 @@ void Block::particle_apply_periodic_update_
   for (int il=0; il<nl; il++) {
 
     ParticleData * p_data = particle_list[il];
+
+    // (...skip neighbors not receiving any particles)
+    if (p_data == NULL) continue;
+
     Particle particle_neighbor (p_descr,p_data);
 
     if ( ((rank >= 1) && dpx[il] != 0.0) ||
@@ -541,6 +845,8 @@ void Block::particle_apply_periodic_update_
 void Block::particle_scatter_neighbors_
 (int npa,
  ParticleData * particle_array[],
+ ParticleData * particle_list[],
+ const int neighbor_array[],
  std::vector<int> & type_list,
  Particle particle)
 {
@@ -560,6 +866,11 @@ void Block::particle_scatter_neighbors_
   const double yl = yp-ym;
   const double zl = zp-zm;
 
+  ParticleDescr * p_descr = cello::particle_descr();
+
+  ParticleScatterScratch & scratch =
+    particle_scatter_scratch[cello::index_static()];
+
   int count = 0;
   // ...for each particle type to be moved
 
@@ -574,8 +885,16 @@ void Block::particle_scatter_neighbors_
     const bool is_float = 
       (cello::type_is_float(particle.attribute_type(it,ia_x)));
 
-    // (...stride may be != 1 if particle attributes are interleaved)
-    const int d  = particle.stride(it,ia_x);
+    // (...map positions to [-2,2) relative to the Block)
+    const double ax = is_float ? 2.0 : 1.0;
+    const double ay = is_float ? 2.0 : 1.0;
+    const double az = is_float ? 2.0 : 1.0;
+    const double bx = is_float ? x0 : 0.0;
+    const double by = is_float ? y0 : 0.0;
+    const double bz = is_float ? z0 : 0.0;
+    const double cx = is_float ? xl : 1.0;
+    const double cy = is_float ? yl : 1.0;
+    const double cz = is_float ? zl : 1.0;
 
     // ...for each batch of particles
 
@@ -585,47 +904,66 @@ void Block::particle_scatter_neighbors_
 
       const int np = particle.num_particles(it,ib);
 
-      // ...extract particle position arrays
+      if (np == 0) continue;
+
+      scratch.reserve(np);
+
+      // ...extract particle position arrays (positions are returned
+      // contiguously regardless of attribute stride)
 
-      double xa[np],ya[np],za[np];
+      double * xa = scratch.x;
+      double * ya = scratch.y;
+      double * za = scratch.z;
       particle.position(it,ib,xa,ya,za);
 
-      // ...initialize mask used for scatter and delete
-      // ...and corresponding particle indices
+      // ...classify particles into the 4x4x4 neighbor array in one
+      // pass: index[] is the neighbor array element and mask[] is
+      // whether the particle has left the Block
 
-      bool mask[np];
-      int index[np];
+      int  * index = scratch.index;
+      bool * mask  = scratch.mask;
+
+      int num_out = 0;
+      int num_error = 0;
       for (int ip=0; ip<np; ip++) {
 
-	double x = is_float ? 2.0*(xa[ip*d]-x0)/xl : xa[ip*d];
-	double y = is_float ? 2.0*(ya[ip*d]-y0)/yl : ya[ip*d];
-	double z = is_float ? 2.0*(za[ip*d]-z0)/zl : za[ip*d];
+	const int ix = (rank >= 1) ? int(ax*(xa[ip]-bx)/cx + 2) : 0;
+	const int iy = (rank >= 2) ? int(ay*(ya[ip]-by)/cy + 2) : 0;
+	const int iz = (rank >= 3) ? int(az*(za[ip]-bz)/cz + 2) : 0;
 
-	int ix = (rank >= 1) ? (x + 2) : 0;
-	int iy = (rank >= 2) ? (y + 2) : 0;
-	int iz = (rank >= 3) ? (z + 2) : 0;
+	num_error += (ix < 0 || ix > 3 || iy < 0 || iy > 3 || iz < 0 || iz > 3);
 
-	if (! (0 <= ix && ix < 4) ||
-	    ! (0 <= iy && iy < 4) ||
-	    ! (0 <= iz && iz < 4)) {
-	  
-	  CkPrintf ("%d ix iy iz %d %d %d\n",CkMyPe(),ix,iy,iz);
-	  CkPrintf ("%d x y z %f %f %f\n",CkMyPe(),x,y,z);
-	  CkPrintf ("%d xa ya za %f %f %f\n",CkMyPe(),xa[ip*d],ya[ip*d],za[ip*d]);
-	  CkPrintf ("%d xm ym zm %f %f %f\n",CkMyPe(),xm,ym,zm);
-	  CkPrintf ("%d xp yp zp %f %f %f\n",CkMyPe(),xp,yp,zp);
-	  ERROR3 ("Block::particle_scatter_neighbors_",
-		  "particle indices (ix,iy,iz) = (%d,%d,%d) out of bounds",
-		  ix,iy,iz);
-	}
+	const bool in_block =
+	  (!(rank >= 1) || (1 <= ix && ix <= 2)) &&
+	  (!(rank >= 2) || (1 <= iy && iy <= 2)) &&
+	  (!(rank >= 3) || (1 <= iz && iz <= 2));
+
+	index[ip] = ix + 4*(iy + 4*iz);
+	mask[ip]  = ! in_block;
+	num_out  += ! in_block;
+      }
+
+      if (num_error > 0) particle_scatter_error_(np,xa,ya,za,is_float);
 
-	const int i = ix + 4*(iy + 4*iz);
-	index[ip] = i;
-	bool in_block = true;
-	in_block = in_block && (!(rank >= 1) || (1 <= ix && ix <= 2));
-	in_block = in_block && (!(rank >= 2) || (1 <= iy && iy <= 2));
-	in_block = in_block && (!(rank >= 3) || (1 <= iz && iz <= 2));
-	mask[ip] = ! in_block;
+      // ...skip batches with no particles leaving the Block
+
+      if (num_out == 0) continue;
+
+      // ...create ParticleData only for neighbors receiving particles
+
+      for (int ip=0; ip<np; ip++) {
+	if (mask[ip] && particle_array[index[ip]] == NULL) {
+	  const int il = neighbor_array[index[ip]];
+	  ASSERT1 ("Block::particle_scatter_neighbors_",
+		   "No neighbor Block for particle array element %d",
+		   index[ip], il >= 0);
+	  ParticleData * pd = new ParticleData;
+	  pd->allocate(p_descr);
+	  particle_list[il] = pd;
+	  for (int i=0; i<npa; i++) {
+	    if (neighbor_array[i] == il) particle_array[i] = pd;
+	  }
+	}
       }
 
       // ...scatter particles to particle array
@@ -641,6 +979,45 @@ void Block::particle_scatter_neighbors_
 
 //----------------------------------------------------------------------
 
+void Block::particle_scatter_error_
+(int np, const double * xa, const double * ya, const double * za,
+ bool is_float)
+{
+  const int rank = cello::rank();
+
+  double xm,ym,zm;
+  double xp,yp,zp;
+  lower(&xm,&ym,&zm);
+  upper(&xp,&yp,&zp);
+
+  for (int ip=0; ip<np; ip++) {
+
+    double x = is_float ? 2.0*(xa[ip]-0.5*(xm+xp))/(xp-xm) : xa[ip];
+    double y = is_float ? 2.0*(ya[ip]-0.5*(ym+yp))/(yp-ym) : ya[ip];
+    double z = is_float ? 2.0*(za[ip]-0.5*(zm+zp))/(zp-zm) : za[ip];
+
+    int ix = (rank >= 1) ? (x + 2) : 0;
+    int iy = (rank >= 2) ? (y + 2) : 0;
+    int iz = (rank >= 3) ? (z + 2) : 0;
+
+    if (! (0 <= ix && ix < 4) ||
+	! (0 <= iy && iy < 4) ||
+	! (0 <= iz && iz < 4)) {
+	  
+      CkPrintf ("%d ix iy iz %d %d %d\n",CkMyPe(),ix,iy,iz);
+      CkPrintf ("%d x y z %f %f %f\n",CkMyPe(),x,y,z);
+      CkPrintf ("%d xa ya za %f %f %f\n",CkMyPe(),xa[ip],ya[ip],za[ip]);
+      CkPrintf ("%d xm ym zm %f %f %f\n",CkMyPe(),xm,ym,zm);
+      CkPrintf ("%d xp yp zp %f %f %f\n",CkMyPe(),xp,yp,zp);
+      ERROR3 ("Block::particle_scatter_neighbors_",
+	      "particle indices (ix,iy,iz) = (%d,%d,%d) out of bounds",
+	      ix,iy,iz);
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+
 void Block::particle_send_
 (int nl,Index index_list[], ParticleData * particle_list[])
 {
@@ -663,13 +1040,14 @@ void Block::particle_send_
 
       thisProxy[index].p_refresh_store (msg);
 
-    } else if (p_data) {
+    } else {
       
+      // ParticleData object may not exist if no particles are sent
+
       MsgRefresh * msg = new MsgRefresh;
 
       thisProxy[index].p_refresh_store (msg);
 
-      // assert ParticleData object exits but has no particles
       delete p_data;
 
     }
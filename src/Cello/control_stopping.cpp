@@ -13,6 +13,17 @@
 ///       compute dt
 ///       compute stopping
 ///       contribute( >>>>> Block::r_output() >>>>> )
+///
+///    SUBCYCLING (Method:subcycle = true)
+///
+///    Level l of levels lmin <= l <= lmax takes one step of length
+///    dt_base * 2^(lmax-l) every 2^(lmax-l) cycles, where dt_base is
+///    limited by the minimum time step of leaf Blocks in each level.
+///    Time steps, stopping criteria, mesh adaptation, output, and
+///    load balancing are only evaluated every 2^(lmax-lmin) cycles,
+///    when all levels are at the same time.  Ghost zones of finer
+///    Blocks are interpolated in time between the previous and
+///    current values of coarser Blocks.
 
 #include "simulation.hpp"
 #include "mesh.hpp"
@@ -51,12 +62,23 @@ void Block::stopping_begin_()
 
   simulation->set_phase(phase_stopping);
 
-  int stopping_interval = simulation->config()->stopping_interval;
+  const Config * config = simulation->config();
+
+  int stopping_interval = config->stopping_interval;
 
   bool stopping_reduce = stopping_interval ? 
     ((cycle_ % stopping_interval) == 0) : false;
 
-  if (stopping_reduce || dt_==0.0) {
+  // When subcycling, time steps and stopping criteria are only
+  // evaluated when all levels are synchronized
+
+  if (config->method_subcycle) {
+    stopping_reduce = subcycle_is_synchronized_();
+  } else {
+    stopping_reduce = stopping_reduce || (dt_ == 0.0);
+  }
+
+  if (stopping_reduce) {
 
     // Compute local dt
 
@@ -90,12 +112,22 @@ void Block::stopping_begin_()
 
     int stop_block = stopping->complete(cycle_,time_);
 
-    // Reduce to find Block array minimum dt and stopping criteria
+    // Reduce to find Block array minimum dt and stopping criteria.
+    // When subcycling, find the minimum dt of leaf Blocks in each
+    // level instead
 
-    double min_reduce[2];
+    const int num_dt = config->method_subcycle ?
+      (config->mesh_max_level + 1) : 1;
 
-    min_reduce[0] = dt_block;
-    min_reduce[1] = stop_block ? 1.0 : 0.0;
+    std::vector<double> min_reduce (num_dt + 1,
+				    std::numeric_limits<double>::max());
+
+    if (num_dt == 1) {
+      min_reduce[0] = dt_block;
+    } else if (is_leaf()) {
+      min_reduce[std::min(std::max(level(),0),num_dt-1)] = dt_block;
+    }
+    min_reduce[num_dt] = stop_block ? 1.0 : 0.0;
 
     CkCallback callback (CkIndex_Block::r_stopping_compute_timestep(NULL),
 			 thisProxy);
@@ -104,7 +136,8 @@ void Block::stopping_begin_()
     CkPrintf ("%s %s:%d DEBUG_CONTRIBUTE\n",
 	      name().c_str(),__FILE__,__LINE__); fflush(stdout);
 #endif    
-    contribute(2*sizeof(double), min_reduce, CkReduction::min_double, callback);
+    contribute((num_dt+1)*sizeof(double), &min_reduce[0],
+	       CkReduction::min_double, callback);
 
   } else {
 
@@ -126,19 +159,49 @@ void Block::r_stopping_compute_timestep(CkReductionMsg * msg)
 
   double * min_reduce = (double * )msg->getData();
 
-  dt_   = min_reduce[0];
-  stop_ = min_reduce[1] == 1.0 ? true : false;
+  const int num_dt = msg->getSize()/sizeof(double) - 1;
+
+  stop_ = min_reduce[num_dt] == 1.0 ? true : false;
+
+  // dt_base is the time step of the finest level; each coarser level
+  // takes one step of twice the length of the next finer level's
+
+  double dt_base = min_reduce[0];
+
+  if (num_dt > 1) {
+
+    const double dt_max = std::numeric_limits<double>::max();
+
+    subcycle_level_min_ = 0;
+    subcycle_level_max_ = 0;
+    for (int level=num_dt-1; level>=0; level--) {
+      if (min_reduce[level] < dt_max) subcycle_level_min_ = level;
+    }
+    for (int level=0; level<num_dt; level++) {
+      if (min_reduce[level] < dt_max) subcycle_level_max_ = level;
+    }
+
+    dt_base = dt_max;
+    for (int level=subcycle_level_min_; level<=subcycle_level_max_; level++) {
+      dt_base = std::min
+	(dt_base, min_reduce[level] / subcycle_stride_(level));
+    }
+
+    subcycle_cycle_ = cycle_;
+  }
 
   delete msg;
 
   Simulation * simulation = cello::simulation();
 
-  dt_ *= Method::courant_global;
+  dt_base *= Method::courant_global;
+
+  dt_ = (num_dt > 1) ? dt_base * subcycle_stride_(level()) : dt_base;
   
   set_dt   (dt_);
   set_stop (stop_);
 
-  simulation->set_dt(dt_);
+  simulation->set_dt(dt_base);
   simulation->set_stop(stop_);
 
 #ifdef CONFIG_USE_PROJECTIONS
@@ -188,6 +251,7 @@ void Block::stopping_balance_()
   Schedule * schedule = cello::simulation()->schedule_balance();
 
   bool do_balance = (schedule && 
+		     subcycle_is_synchronized_() &&
 		     schedule->write_this_cycle(cycle_,time_));
 
   if (do_balance) {
@@ -219,7 +283,11 @@ void Block::p_stopping_balance()
   // if (index().is_root()) monitor->print ("Balance","BEGIN");
   // monitor->set_mode(mode_saved);
 
-  AtSync();
+  if (cello::config()->balance_type == "cost") {
+    balance_cost_enter_();
+  } else {
+    AtSync();
+  }
   performance_stop_(perf_stopping);
 }
  
@@ -244,6 +312,52 @@ void Block::ResumeFromSync()
 
 //----------------------------------------------------------------------
 
+int Block::subcycle_stride_ (int level) const
+{
+  // Sub-root Blocks step with the coarsest level
+  level = std::max(level,subcycle_level_min_);
+  level = std::min(level,subcycle_level_max_);
+  return 1 << (subcycle_level_max_ - level);
+}
+
+//----------------------------------------------------------------------
+
+bool Block::subcycle_is_step_ () const
+{
+  if (! cello::config()->method_subcycle) return true;
+
+  return ((cycle_ - subcycle_cycle_) % subcycle_stride_(level())) == 0;
+}
+
+//----------------------------------------------------------------------
+
+bool Block::subcycle_is_synchronized_ () const
+{
+  if (! cello::config()->method_subcycle) return true;
+
+  return ((cycle_ - subcycle_cycle_) %
+	  subcycle_stride_(subcycle_level_min_)) == 0;
+}
+
+//----------------------------------------------------------------------
+
+double Block::subcycle_time_weight_ () const
+{
+  // Current values are used if not subcycling, or at the start of
+  // this Block's step, since neighbors are then at the same time.
+  // Otherwise a finer neighbor is partway through this Block's step,
+  // whose previous values are saved in history 1
+
+  if (! cello::config()->method_subcycle) return 1.0;
+
+  const int stride = subcycle_stride_(level());
+  const int k = (cycle_ - subcycle_cycle_) % stride;
+
+  return (k == 0) ? 1.0 : double(k) / stride;
+}
+
+//----------------------------------------------------------------------
+
 void Block::exit_()
 {
 
@@ -273,7 +387,8 @@ void Block::exit_()
 		CkMyPe(),ParticleData::counter[in]);
     }
   }
+  // Exit after all processes finish writing asynchronous output
   if (index_.is_root()) {
-    proxy_main.p_exit(1);
+    proxy_simulation.p_output_flush();
   }
 }
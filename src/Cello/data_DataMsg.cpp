@@ -11,6 +11,8 @@
 
 long DataMsg::counter[CONFIG_NODE_SIZE] = {0};
 
+Pool DataMsg::pool (sizeof(DataMsg));
+
 //----------------------------------------------------------------------
 
 int DataMsg::data_size () const
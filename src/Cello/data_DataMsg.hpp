@@ -18,6 +18,17 @@ public: // interface
 
   static long counter[CONFIG_NODE_SIZE];
 
+  /// Free-list pool for DataMsg objects, with hit and miss counters
+  static Pool pool;
+
+  /// Allocate DataMsg objects from the pool
+  static void * operator new (size_t bytes)
+  { return pool.allocate(bytes); }
+
+  /// Return DataMsg objects to the pool
+  static void operator delete (void * pointer)
+  { pool.deallocate(pointer); }
+
   DataMsg() 
     : field_face_   (NULL),
       field_data_   (NULL),
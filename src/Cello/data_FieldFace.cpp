@@ -10,6 +10,8 @@
 
 long FieldFace::counter[CONFIG_NODE_SIZE] = {0};
 
+Pool FieldFace::pool (sizeof(FieldFace));
+
 #define FORTRAN_NAME(NAME) NAME##_
 
 extern "C" void FORTRAN_NAME(field_face_store_4)
@@ -33,7 +35,9 @@ FieldFace::FieldFace
      prolong_(NULL),
      restrict_(NULL),
      refresh_(NULL),
-     new_refresh_(false)
+     new_refresh_(false),
+     time_weight_(1.0),
+     num_bytes_array_(-1)
 {
   ++counter[cello::index_static()];
 
@@ -66,7 +70,9 @@ FieldFace::FieldFace(const FieldFace & field_face) throw ()
      prolong_(NULL),
      restrict_(NULL),
      refresh_(NULL),
-     new_refresh_(false)
+     new_refresh_(false),
+     time_weight_(1.0),
+     num_bytes_array_(-1)
 
 {
 #ifdef DEBUG_FIELD_FACE  
@@ -104,6 +110,9 @@ void FieldFace::copy_(const FieldFace & field_face)
   restrict_     = field_face.restrict_;
   prolong_      = field_face.prolong_;
   refresh_      = field_face.refresh_;
+  time_weight_  = field_face.time_weight_;
+  num_bytes_array_ = field_face.num_bytes_array_;
+  num_bytes_fields_ = field_face.num_bytes_fields_;
   // new_refresh_ must not be true in more than one FieldFace to avoid
   // multiple deletes
   new_refresh_  = false;
@@ -126,6 +135,8 @@ void FieldFace::pup (PUP::er &p)
   p | restrict_;
   p | refresh_;
   p | new_refresh_;
+  p | time_weight_;
+  if (p.isUnpacking()) num_bytes_array_ = -1;
 }
 
 //======================================================================
@@ -154,15 +165,19 @@ void FieldFace::face_to_array ( Field field,char * array) throw()
   size_t index_array = 0;
 
   std::vector <int> field_list = field_list_src_(field);
+  std::vector <int> field_list_dst = field_list_dst_(field);
 
-  for (size_t i_f=0; i_f < field_list.size(); i_f++) {
+  const int num_fields = field_list.size();
+
+  // Fields with the same layout are copied together in one pass over
+  // the face, so i_f advances by the number of fields fused
+
+  for (int i_f=0, nf=1; i_f < num_fields; i_f += nf) {
 
     size_t index_field = field_list[i_f];
   
     precision_type precision = field.precision(index_field);
 
-    const void * field_face = field.values(index_field);
-
     char * array_face  = &array[index_array];
 
     int m3[3],g3[3],c3[3];
@@ -171,8 +186,8 @@ void FieldFace::face_to_array ( Field field,char * array) throw()
     field.ghost_depth(index_field,&g3[0],&g3[1],&g3[2]);
     field.centering(index_field,&c3[0],&c3[1],&c3[2]);
 
-    int index_src = field_list_src_(field)[i_f];
-    int index_dst = field_list_dst_(field)[i_f];
+    int index_src = field_list[i_f];
+    int index_dst = field_list_dst[i_f];
     const bool accumulate = accumulate_(index_src,index_dst);
 
     int i3[3], n3[3];
@@ -184,8 +199,12 @@ void FieldFace::face_to_array ( Field field,char * array) throw()
   
     if (refresh_type_ == refresh_coarse) {
 
+      nf = 1;
+
       // Restrict field to array
 
+      const void * field_face = field.values(index_field);
+
       int nc3[3] = { (n3[0]+1)/2, (n3[1]+1)/2,(n3[2]+1)/2 };
 
       int i3_array[3] = {0,0,0};
@@ -200,22 +219,37 @@ void FieldFace::face_to_array ( Field field,char * array) throw()
 
     } else {
 
-      union { float * a4; double * a8; long double * a16; };
-      union { float * f4; double * f8;long double * f16;  };
-      a4 = (float *) array_face;
-      f4 = (float *) field_face;
-      
-      // Copy field to array
+      nf = num_fields_fused_
+	(field,field_list,field_list,field_list_dst,i_f);
+
+      std::vector<char *> field_face (nf);
+      for (int k=0; k<nf; k++) {
+	field_face[k] = field.values(field_list[i_f+k]);
+      }
+
+      // Copy fields to array
       
-      if (precision == precision_single) {
-	index_array += load_ ( a4,  f4,  m3,n3,i3, accumulate);
-      } else if (precision == precision_double) {
-	index_array += load_ ( a8,  f8,  m3,n3,i3, accumulate);
-      } else if (precision == precision_quadruple) {
-	index_array += load_ ( a16, f16, m3,n3,i3, accumulate);
-      } else {
-	ERROR("FieldFace::face_to_array", "Unsupported precision");
+      const size_t bytes = load_precision_
+	(precision, array_face, &field_face[0], nf, m3,n3,i3, accumulate);
+
+      if (time_interpolate_(field)) {
+
+	// Interpolate in time between previous and current values for
+	// the finer neighbor
+
+	std::vector<char *> field_face_old (nf);
+	for (int k=0; k<nf; k++) {
+	  field_face_old[k] = field.values(field_list[i_f+k],1);
+	}
+	std::vector<char> array_old (bytes);
+	load_precision_
+	  (precision, &array_old[0], &field_face_old[0], nf, m3,n3,i3, accumulate);
+
+	time_blend_ (precision, array_face, &array_old[0],
+		     bytes / cello::sizeof_precision(precision));
       }
+
+      index_array += bytes;
     }
   }
 
@@ -228,15 +262,19 @@ void FieldFace::array_to_face (char * array, Field field) throw()
   size_t index_array = 0;
 
   std::vector<int> field_list = field_list_dst_(field);
-  
-  for (size_t i_f=0; i_f < field_list.size(); i_f++) {
+  std::vector<int> field_list_src = field_list_src_(field);
+
+  const int num_fields = field_list.size();
+
+  // Fields with the same layout are copied together in one pass over
+  // the face, so i_f advances by the number of fields fused
+
+  for (int i_f=0, nf=1; i_f < num_fields; i_f += nf) {
 
     size_t index_field = field_list[i_f];
 
     precision_type precision = field.precision(index_field);
 
-    char * field_ghost = field.values(index_field);
-    
     char * array_ghost  = array + index_array;
 
     int m3[3],g3[3],c3[3];
@@ -245,8 +283,8 @@ void FieldFace::array_to_face (char * array, Field field) throw()
     field.ghost_depth(index_field,&g3[0],&g3[1],&g3[2]);
     field.centering(index_field,&c3[0],&c3[1],&c3[2]);
 
-    int index_src = field_list_src_(field)[i_f];
-    int index_dst = field_list_dst_(field)[i_f];
+    int index_src = field_list_src[i_f];
+    int index_dst = field_list[i_f];
     const bool accumulate = accumulate_(index_src,index_dst);
 
     int i3[3], n3[3];
@@ -258,8 +296,12 @@ void FieldFace::array_to_face (char * array, Field field) throw()
 
     if (refresh_type_ == refresh_fine) {
 
+      nf = 1;
+
       // Prolong array to field
 
+      char * field_ghost = field.values(index_field);
+    
       bool need_padding = (g3[0]%2==1) || (g3[1]%2==1) || (g3[2]%2==1);
 
       ASSERT("FieldFace::array_to_face()",
@@ -282,20 +324,25 @@ void FieldFace::array_to_face (char * array, Field field) throw()
 
     } else {
 
-      // Copy array to field
+      nf = num_fields_fused_
+	(field,field_list,field_list_src,field_list,i_f);
+
+      std::vector<char *> field_ghost (nf);
+      for (int k=0; k<nf; k++) {
+	field_ghost[k] = field.values(field_list[i_f+k]);
+      }
+
+      // Copy array to fields
+
       union { float * as4; double * as8; long double * as16; };
-      union { float * fd4; double * fd8;long double * fd16;  };
       as4 = (float *) array_ghost;
-      fd4 = (float *) field_ghost;
-      
-      // Copy field to array
 
       if (precision == precision_single) {
-	index_array += store_ ( fd4,  as4,  m3,n3,i3, accumulate);
+	index_array += store_ ( &field_ghost[0], as4,  nf, m3,n3,i3, accumulate);
       } else if (precision == precision_double) {
-	index_array += store_ ( fd8,  as8,  m3,n3,i3, accumulate);
+	index_array += store_ ( &field_ghost[0], as8,  nf, m3,n3,i3, accumulate);
       } else if (precision == precision_quadruple) {
-	index_array += store_ ( fd16, as16, m3,n3,i3, accumulate);
+	index_array += store_ ( &field_ghost[0], as16, nf, m3,n3,i3, accumulate);
       } else {
 	ERROR("FieldFace::array_to_face()", "Unsupported precision");
       }
@@ -352,6 +399,20 @@ void FieldFace::face_to_face (Field field_src, Field field_dst)
     
     Problem * problem = cello::problem();
 
+    // Interpolate coarse values in time for the finer neighbor if
+    // needed, using a temporary copy of the source field
+
+    std::vector<char> values_blend;
+
+    if (time_interpolate_(field_src)) {
+      const int n = m3[0]*m3[1]*m3[2];
+      values_blend.assign
+	(values_src, values_src + n*cello::sizeof_precision(precision));
+      time_blend_ (precision, &values_blend[0],
+		   field_src.values(index_src,1), n);
+      values_src = &values_blend[0];
+    }
+
     if (refresh_type_ == refresh_fine) {
 
       // Prolong field
@@ -408,9 +469,12 @@ void FieldFace::face_to_face (Field field_src, Field field_dst)
 
 int FieldFace::num_bytes_array(Field field) throw()
 {
+  if (num_bytes_array_ >= 0) return num_bytes_array_;
+
   int array_size = 0;
 
   std::vector<int> field_list = field_list_src_(field);
+  std::vector<int> field_list_dst = field_list_dst_(field);
 
   for (size_t i_f=0; i_f < field_list.size(); i_f++) {
 
@@ -425,8 +489,8 @@ int FieldFace::num_bytes_array(Field field) throw()
     field.ghost_depth(index_field,&g3[0],&g3[1],&g3[2]);
     field.centering(index_field,&c3[0],&c3[1],&c3[2]);
 
-    int index_src = field_list_src_(field)[i_f];
-    int index_dst = field_list_dst_(field)[i_f];
+    int index_src = field_list[i_f];
+    int index_dst = field_list_dst[i_f];
     const bool accumulate = accumulate_(index_src,index_dst);
     int op_type = (refresh_type_ == refresh_fine) ? op_load : op_store;
 
@@ -445,6 +509,10 @@ int FieldFace::num_bytes_array(Field field) throw()
 	 "array_size must be > 0, maybe field_list.size() is 0?",
 	 array_size);
 
+  num_bytes_array_ = array_size;
+
+  set_num_bytes_fields_();
+
   return array_size;
 
 }
@@ -529,39 +597,94 @@ char * FieldFace::load_data (char * buffer)
 
 //======================================================================
 
+size_t FieldFace::load_precision_
+( precision_type precision,
+  char * array_face, char * const * field_face, int nf,
+  int m3[3], int n3[3],int i3[3], bool accumulate ) throw()
+{
+  union { float * a4; double * a8; long double * a16; };
+  a4 = (float *) array_face;
+
+  if (precision == precision_single) {
+    return load_ ( a4,  field_face, nf, m3,n3,i3, accumulate);
+  } else if (precision == precision_double) {
+    return load_ ( a8,  field_face, nf, m3,n3,i3, accumulate);
+  } else if (precision == precision_quadruple) {
+    return load_ ( a16, field_face, nf, m3,n3,i3, accumulate);
+  } else {
+    ERROR("FieldFace::load_precision_()", "Unsupported precision");
+  }
+  return 0;
+}
+
+//----------------------------------------------------------------------
+
+void FieldFace::time_blend_
+(precision_type precision, char * values, const char * values_old, int n) const
+{
+  if (precision == precision_single) {
+    time_blend_ ((float *)values, (const float *)values_old, n);
+  } else if (precision == precision_double) {
+    time_blend_ ((double *)values, (const double *)values_old, n);
+  } else if (precision == precision_quadruple) {
+    time_blend_ ((long double *)values, (const long double *)values_old, n);
+  } else {
+    ERROR("FieldFace::time_blend_()", "Unsupported precision");
+  }
+}
+
+//----------------------------------------------------------------------
+
+template<class T> void FieldFace::time_blend_
+(T * values, const T * values_old, int n) const
+{
+  const T w = time_weight_;
+  for (int i=0; i<n; i++) {
+    values[i] = values_old[i] + w*(values[i] - values_old[i]);
+  }
+}
+
+//----------------------------------------------------------------------
+
 template<class T>
 size_t FieldFace::load_
-( T * array_face, const T * field_face, 
+( T * array_face, char * const * field_face, int nf,
   int m3[3], int n3[3],int i3[3], bool accumulate ) throw()
 {
   // NOTE: don't check accumulate since loading array; accumulate
   // is handled in corresponding store_() at the receiving end
-  // add values
 
-  for (int iz=0; iz <n3[2]; iz++)  {
-    int kz = iz+i3[2];
-    for (int iy=0; iy < n3[1]; iy++) {
-      int ky = iy+i3[1];
-      for (int ix=0; ix < n3[0]; ix++) {
-	int kx = ix+i3[0];
-	int index_array = ix +   n3[0]*(iy +   n3[1] * iz);
-	int index_field = kx + m3[0]*(ky + m3[1] * kz);
-	array_face[index_array] = field_face[index_field];
-      }
-    }
+  const int im = i3[0] + m3[0]*(i3[1] + m3[1]*i3[2]);
+  const int n  = n3[0]*n3[1]*n3[2];
+
+  // Each field's face is stored in its own contiguous block of the
+  // array, in field list order
+
+  std::vector<T *>       vd (nf);
+  std::vector<const T *> vs (nf);
+  for (int k=0; k<nf; k++) {
+    vd[k] = array_face + k*n;
+    vs[k] = (const T *)(field_face[k]) + im;
   }
 
-  return (sizeof(T) * n3[0] * n3[1] * n3[2]);
+  copy_dispatch_ (&vd[0], n3[0], n3[0]*n3[1],
+		  &vs[0], m3[0], m3[0]*m3[1],
+		  n3, nf, false);
+
+  return (sizeof(T) * n * nf);
 
 }
 
 //----------------------------------------------------------------------
 
 template<class T> size_t FieldFace::store_
-( T * ghost, const T * array,
+( char * const * ghost, const T * array, int nf,
   int m3[3], int n3[3],int i3[3], bool accumulate) throw()
 {
-#define FORTRAN_STORE
+  // #define FORTRAN_STORE
+
+  const int im = i3[0] + m3[0]*(i3[1] + m3[1]*i3[2]);
+  const int n  = n3[0]*n3[1]*n3[2];
 
 #ifdef FORTRAN_STORE
 
@@ -580,62 +703,44 @@ template<class T> size_t FieldFace::store_
     long double * array_16;
   };
 
-  ghost_4 = (float *) ghost;
-  array_4 = (float *) array;
-  
-  int im = i3[0] + m3[0]*(i3[1] + m3[1]*i3[2]);
-
   int iaccumulate = accumulate ? 1 : 0;
 
-  if (sizeof(T)==sizeof(float)) {
-    FORTRAN_NAME(field_face_store_4)(ghost_4 + im,   array_4, m3,n3,
-				     &iaccumulate);
-  } else if (sizeof(T)==sizeof(double)) {
-    FORTRAN_NAME(field_face_store_8)(ghost_8 + im,   array_8, m3,n3,
-				     &iaccumulate);
-  } else if (sizeof(T)==sizeof(long double)) {
-    FORTRAN_NAME(field_face_store_16)(ghost_16 + im, array_16, m3,n3,
-				      &iaccumulate);
-  } else {
-    ERROR1 ("FieldFace::store_()",
-	   "unknown float precision sizeof(T) = %d\n",sizeof(T));
+  for (int k=0; k<nf; k++) {
+
+    ghost_4 = (float *) ghost[k];
+    array_4 = (float *) (array + k*n);
+
+    if (sizeof(T)==sizeof(float)) {
+      FORTRAN_NAME(field_face_store_4)(ghost_4 + im,   array_4, m3,n3,
+				       &iaccumulate);
+    } else if (sizeof(T)==sizeof(double)) {
+      FORTRAN_NAME(field_face_store_8)(ghost_8 + im,   array_8, m3,n3,
+				       &iaccumulate);
+    } else if (sizeof(T)==sizeof(long double)) {
+      FORTRAN_NAME(field_face_store_16)(ghost_16 + im, array_16, m3,n3,
+					&iaccumulate);
+    } else {
+      ERROR1 ("FieldFace::store_()",
+	      "unknown float precision sizeof(T) = %d\n",sizeof(T));
+    }
   }
 
 #else
 
-  if (accumulate) {
-    // add values
-    for (int iz=0; iz <n3[2]; iz++)  {
-      int kz = iz+i3[2];
-      for (int iy=0; iy < n3[1]; iy++) {
-	int ky = iy+i3[1];
-	for (int ix=0; ix < n3[0]; ix++) {
-	  int kx = ix+i3[0];
-	  int index_array = ix + n3[0]*(iy + n3[1] * iz);
-	  int index_field = kx + m3[0]*(ky + m3[1] * kz);
-	  ghost[index_field] += array[index_array];
-	}
-      }
-    }
-  } else {
-    // copy values
-    for (int iz=0; iz <n3[2]; iz++)  {
-      int kz = iz+i3[2];
-      for (int iy=0; iy < n3[1]; iy++) {
-	int ky = iy+i3[1];
-	for (int ix=0; ix < n3[0]; ix++) {
-	  int kx = ix+i3[0];
-	  int index_array = ix + n3[0]*(iy + n3[1] * iz);
-	  int index_field = kx + m3[0]*(ky + m3[1] * kz);
-	  ghost[index_field] = array[index_array];
-	}
-      }
-    }
+  std::vector<T *>       vd (nf);
+  std::vector<const T *> vs (nf);
+  for (int k=0; k<nf; k++) {
+    vd[k] = (T *)(ghost[k]) + im;
+    vs[k] = array + k*n;
   }
 
+  copy_dispatch_ (&vd[0], m3[0], m3[0]*m3[1],
+		  &vs[0], n3[0], n3[0]*n3[1],
+		  n3, nf, accumulate);
+
 #endif
 
-  return (sizeof(T) * n3[0] * n3[1] * n3[2]);
+  return (sizeof(T) * n * nf);
 
 }
 
@@ -646,23 +751,72 @@ template<class T> void FieldFace::copy_
   const T * vs, int ms3[3],int ns3[3],int is3[3],
   bool accumulate) throw()
 {
-  if (accumulate) {
-    for (int iz=0; iz <ns3[2]; iz++)  {
-      for (int iy=0; iy < ns3[1]; iy++) {
-	for (int ix=0; ix < ns3[0]; ix++) {
-	  int i_src = (ix+is3[0]) + ms3[0]*((iy+is3[1]) + ms3[1] * (iz+is3[2]));
-	  int i_dst = (ix+id3[0]) + md3[0]*((iy+id3[1]) + md3[1] * (iz+id3[2]));
-	  vd[i_dst] += vs[i_src];
-	}
-      }
+  T       * vd_start = vd + id3[0] + md3[0]*(id3[1] + md3[1]*id3[2]);
+  const T * vs_start = vs + is3[0] + ms3[0]*(is3[1] + ms3[1]*is3[2]);
+
+  copy_dispatch_ (&vd_start, md3[0], md3[0]*md3[1],
+		  &vs_start, ms3[0], ms3[0]*ms3[1],
+		  ns3, 1, accumulate);
+}
+
+//----------------------------------------------------------------------
+
+template<class T> void FieldFace::copy_dispatch_
+( T       * const * vd, int dyd, int dzd,
+  const T * const * vs, int dys, int dzs,
+  const int n3_in[3], int nf, bool accumulate) throw()
+{
+  int n3[3] = { n3_in[0], n3_in[1], n3_in[2] };
+
+  if (n3[0]*n3[1]*n3[2]*nf == 0) return;
+
+  // Merge y into x, then z into x-y, when rows are contiguous in both
+  // arrays, so that e.g. full z faces become a single run
+
+  if (n3[0] == dyd && n3[0] == dys) {
+    n3[0] *= n3[1];
+    n3[1] =  1;
+    if (n3[0] == dzd && n3[0] == dzs) {
+      n3[0] *= n3[2];
+      n3[2] =  1;
     }
+  }
+
+  if (accumulate) {
+    copy_kernel_<T,true,0> (vd,dyd,dzd,vs,dys,dzs,n3,nf);
   } else {
-    for (int iz=0; iz <ns3[2]; iz++)  {
-      for (int iy=0; iy < ns3[1]; iy++) {
-	for (int ix=0; ix < ns3[0]; ix++) {
-	  int i_src = (ix+is3[0]) + ms3[0]*((iy+is3[1]) + ms3[1] * (iz+is3[2]));
-	  int i_dst = (ix+id3[0]) + md3[0]*((iy+id3[1]) + md3[1] * (iz+id3[2]));
-	  vd[i_dst] = vs[i_src];
+    switch (n3[0]) {
+    case 1:  copy_kernel_<T,false,1> (vd,dyd,dzd,vs,dys,dzs,n3,nf); break;
+    case 2:  copy_kernel_<T,false,2> (vd,dyd,dzd,vs,dys,dzs,n3,nf); break;
+    case 3:  copy_kernel_<T,false,3> (vd,dyd,dzd,vs,dys,dzs,n3,nf); break;
+    case 4:  copy_kernel_<T,false,4> (vd,dyd,dzd,vs,dys,dzs,n3,nf); break;
+    default: copy_kernel_<T,false,0> (vd,dyd,dzd,vs,dys,dzs,n3,nf); break;
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+
+template<class T, bool ACCUMULATE, int NX> void FieldFace::copy_kernel_
+( T       * const * vd, int dyd, int dzd,
+  const T * const * vs, int dys, int dzs,
+  const int n3[3], int nf) throw()
+{
+  const int nx = (NX > 0) ? NX : n3[0];
+
+  for (int iz=0; iz < n3[2]; iz++) {
+    for (int iy=0; iy < n3[1]; iy++) {
+      const int od = iy*dyd + iz*dzd;
+      const int os = iy*dys + iz*dzs;
+      for (int k=0; k < nf; k++) {
+	T       * d = vd[k] + od;
+	const T * s = vs[k] + os;
+	if (ACCUMULATE) {
+	  for (int ix=0; ix < nx; ix++) d[ix] += s[ix];
+	} else if (NX > 0) {
+	  for (int ix=0; ix < NX; ix++) d[ix] = s[ix];
+	} else {
+	  memcpy (d, s, nx*sizeof(T));
 	}
       }
     }
@@ -671,6 +825,48 @@ template<class T> void FieldFace::copy_
 
 //----------------------------------------------------------------------
 
+int FieldFace::num_fields_fused_
+(Field field,
+ const std::vector<int> & field_list,
+ const std::vector<int> & field_list_src,
+ const std::vector<int> & field_list_dst,
+ int i_f) const
+{
+  const int index = field_list[i_f];
+
+  const precision_type precision = field.precision(index);
+  const bool accumulate =
+    accumulate_(field_list_src[i_f],field_list_dst[i_f]);
+
+  int m3[3],g3[3],c3[3];
+  field.field_size (index,&m3[0],&m3[1],&m3[2]);
+  field.ghost_depth(index,&g3[0],&g3[1],&g3[2]);
+  field.centering  (index,&c3[0],&c3[1],&c3[2]);
+
+  int nf = 1;
+  for (int j_f=i_f+1; j_f < (int)field_list.size(); j_f++, nf++) {
+
+    const int index_j = field_list[j_f];
+
+    int mj3[3],gj3[3],cj3[3];
+    field.field_size (index_j,&mj3[0],&mj3[1],&mj3[2]);
+    field.ghost_depth(index_j,&gj3[0],&gj3[1],&gj3[2]);
+    field.centering  (index_j,&cj3[0],&cj3[1],&cj3[2]);
+
+    const bool match =
+      (field.precision(index_j) == precision) &&
+      (accumulate_(field_list_src[j_f],field_list_dst[j_f]) == accumulate) &&
+      (mj3[0]==m3[0] && mj3[1]==m3[1] && mj3[2]==m3[2]) &&
+      (gj3[0]==g3[0] && gj3[1]==g3[1] && gj3[2]==g3[2]) &&
+      (cj3[0]==c3[0] && cj3[1]==c3[1] && cj3[2]==c3[2]);
+
+    if (! match) break;
+  }
+  return nf;
+}
+
+//----------------------------------------------------------------------
+
 void FieldFace::loop_limits_accumulate
 ( int i3[3],int n3[3], const int m3[3], const int g3[3], const int c3[3],
   int op_type)
@@ -944,6 +1140,7 @@ void FieldFace::print(const char * message)
 
 void FieldFace::set_field_list(std::vector<int> field_list)
 {
+  num_bytes_array_ = -1;
   refresh_->set_field_list(field_list);
 }
 
@@ -975,3 +1172,35 @@ bool FieldFace::accumulate_(int index_src, int index_dst) const
 {
   return ((index_src != index_dst) && refresh_->accumulate());
 }
+
+//----------------------------------------------------------------------
+
+void FieldFace::set_num_bytes_fields_()
+{
+  const std::vector<int> & src = refresh_->field_list_src();
+  const std::vector<int> & dst = refresh_->field_list_dst();
+
+  num_bytes_fields_.resize(3 + src.size() + dst.size());
+  num_bytes_fields_[0] = refresh_->all_fields() ? 1 : 0;
+  num_bytes_fields_[1] = refresh_->accumulate() ? 1 : 0;
+  num_bytes_fields_[2] = src.size();
+  std::copy (src.begin(),src.end(),num_bytes_fields_.begin() + 3);
+  std::copy (dst.begin(),dst.end(),num_bytes_fields_.begin() + 3 + src.size());
+}
+
+//----------------------------------------------------------------------
+
+bool FieldFace::is_num_bytes_fields_(Refresh * refresh) const
+{
+  const std::vector<int> & src = refresh->field_list_src();
+  const std::vector<int> & dst = refresh->field_list_dst();
+
+  if (num_bytes_fields_.size() != 3 + src.size() + dst.size()) return false;
+
+  return ((num_bytes_fields_[0] == (refresh->all_fields() ? 1 : 0)) &&
+	  (num_bytes_fields_[1] == (refresh->accumulate() ? 1 : 0)) &&
+	  (num_bytes_fields_[2] == (int) src.size()) &&
+	  std::equal (src.begin(),src.end(),num_bytes_fields_.begin() + 3) &&
+	  std::equal (dst.begin(),dst.end(),
+		      num_bytes_fields_.begin() + 3 + src.size()));
+}
@@ -23,6 +23,17 @@ public: // interface
 
   static long counter[CONFIG_NODE_SIZE];
 
+  /// Free-list pool for FieldFace objects, with hit and miss counters
+  static Pool pool;
+
+  /// Allocate FieldFace objects from the pool
+  static void * operator new (size_t bytes)
+  { return pool.allocate(bytes); }
+
+  /// Return FieldFace objects to the pool
+  static void operator delete (void * pointer)
+  { pool.deallocate(pointer); }
+
   /// Constructor of uninitialized FieldFace
 
   FieldFace () throw()
@@ -30,7 +41,9 @@ public: // interface
     prolong_(NULL),
     restrict_(NULL),
     refresh_(NULL),
-    new_refresh_(false)
+    new_refresh_(false),
+    time_weight_(1.0),
+    num_bytes_array_(-1)
   {
 #ifdef DEBUG_FIELD_FACE    
     CkPrintf ("%d %s:%d DEBUG_FIELD_FACE creating %p\n",
@@ -65,6 +78,7 @@ public: // interface
   /// Set whether or not to include ghost zones along each axis
   inline void set_ghost (bool gx, bool gy = true, bool gz = true)
   {
+    num_bytes_array_ = -1;
     ghost_[0] = gx;
     ghost_[1] = gy;
     ghost_[2] = gz;
@@ -73,6 +87,7 @@ public: // interface
   /// Set the face
   inline void set_face (int fx, int fy = 0, int fz = 0)
   {
+    num_bytes_array_ = -1;
     face_[0] = fx;
     face_[1] = fy;
     face_[2] = fz;
@@ -88,6 +103,7 @@ public: // interface
   
   inline void invert_face ()
   {
+    num_bytes_array_ = -1;
     face_[0] = -face_[0];
     face_[1] = -face_[1];
     face_[2] = -face_[2];
@@ -95,6 +111,7 @@ public: // interface
   /// Set child if restrict or prolong is required
   void set_child(int icx, int icy=0, int icz=0) throw()
   {
+    num_bytes_array_ = -1;
     child_[0] = icx;
     child_[1] = icy;
     child_[2] = icz;
@@ -104,7 +121,10 @@ public: // interface
   /// refresh_coarse(restrict), or refresh_same(copy)
 
   void set_refresh_type (int refresh_type)
-  {  refresh_type_ = refresh_type;  }
+  {
+    refresh_type_ = refresh_type;
+    num_bytes_array_ = -1;
+  }
 
   /// Set Prolong operation (default is Problem::prolong() )
   void set_prolong (Prolong * prolong)
@@ -119,11 +139,29 @@ public: // interface
   {
     refresh_ = refresh;
     new_refresh_ = new_refresh;
+    num_bytes_array_ = -1;
+  }
+
+  /// Replace the (non-owned) Refresh object, keeping the cached
+  /// array size only if the new Refresh has the same fields
+  void update_refresh (Refresh * refresh)
+  {
+    ASSERT ("FieldFace::update_refresh()",
+	    "FieldFace must not own its Refresh object",
+	    ! new_refresh_);
+    if (! is_num_bytes_fields_(refresh)) num_bytes_array_ = -1;
+    refresh_ = refresh;
   }
 
   /// Return the Refresh object
   Refresh * refresh () const
   { return refresh_; }
+
+  /// Set the weight of current field values relative to the previous
+  /// (history 1) values when loading faces for a finer neighbor, for
+  /// interpolating coarse ghost values in time when subcycling
+  void set_time_weight (double time_weight)
+  { time_weight_ = time_weight; }
   
   void set_field_list (std::vector<int> field_list);
   
@@ -140,7 +178,11 @@ public: // interface
   /// Copy directly the face from source FieldData to destination FieldData
   void face_to_face (Field field_src, Field field_dst);
 
-  /// Calculate the number of bytes needed
+  /// Calculate the number of bytes needed.  The result is saved and
+  /// reused until the face, child, ghosts, refresh type, or Refresh
+  /// object are changed, and is copied with the FieldFace, so cached
+  /// faces of a Block compute it only once.  Must be called with
+  /// Fields of the same layout while saved
 
   int num_bytes_array (Field field) throw();
 
@@ -178,17 +220,25 @@ private: // functions
   /// copy data
   void copy_(const FieldFace & field_face); 
 
-  /// Precision-agnostic function for loading field block face into
-  /// the field_face array; returns number of bytes copied
+  /// Precision-agnostic function for loading the faces of nf fields
+  /// with the same layout into consecutive field_face blocks of the
+  /// array; returns number of bytes copied
   template<class T>
-  size_t load_ (T * array_face,  const T * field_face,
+  size_t load_ (T * array_face,  char * const * field_face, int nf,
 		int nd3[3], int nf3[3], int im3[3],
 		bool accumulate) throw();
 
-  /// Precision-agnostic function for copying the field_face array into
-  /// the field block ghosts; returns number of bytes copied
+  /// Call load_() for the given precision
+  size_t load_precision_ (precision_type precision,
+			  char * array_face, char * const * field_face, int nf,
+			  int nd3[3], int nf3[3], int im3[3],
+			  bool accumulate) throw();
+
+  /// Precision-agnostic function for copying consecutive field_face
+  /// blocks of the array into the ghosts of nf fields with the same
+  /// layout; returns number of bytes copied
   template<class T>
-  size_t store_ (T * field_ghosts,  const T * array_ghosts, 
+  size_t store_ (char * const * field_ghosts, const T * array_ghosts, int nf,
 		 int nd3[3], int nf3[3], int im3[3],
 		 bool accumulate) throw();
 
@@ -199,11 +249,63 @@ private: // functions
 	      const T * vs, int ms3[3], int ns3[3], int is3[3],
 	      bool accumulate) throw();
 
+  /// Select the copy_kernel_() specialization for the given
+  /// precision, accumulate, and contiguous x-axis run length, after
+  /// merging axes that are contiguous in both source and destination.
+  /// The nf source and destination arrays share the same strides
+  template<class T>
+  static void copy_dispatch_ (T       * const * vd, int dyd, int dzd,
+			      const T * const * vs, int dys, int dzs,
+			      const int n3[3], int nf, bool accumulate) throw();
+
+  /// Copy (or add if ACCUMULATE) an n3 block of values between
+  /// strided arrays for each of nf arrays, walking the face region
+  /// once and copying each row of all nf arrays together.  NX > 0 is
+  /// the compile-time x-axis run length for short runs (x faces); NX
+  /// == 0 copies rows of run-time length n3[0] using memcpy() (y and
+  /// z faces)
+  template<class T, bool ACCUMULATE, int NX>
+  static void copy_kernel_ (T       * const * vd, int dyd, int dzd,
+			    const T * const * vs, int dys, int dzs,
+			    const int n3[3], int nf) throw();
+
+  /// Return the number of fields following field_list[i_f] that can
+  /// be packed or unpacked together with it: same precision, size,
+  /// ghost depth, centering, and accumulate
+  int num_fields_fused_ (Field field,
+			 const std::vector<int> & field_list,
+			 const std::vector<int> & field_list_src,
+			 const std::vector<int> & field_list_dst,
+			 int i_f) const;
+
+  /// Whether loaded values must be interpolated in time between the
+  /// history 1 and current field values
+  bool time_interpolate_ (const Field & field) const
+  {
+    return (refresh_type_ == refresh_fine &&
+	    time_weight_ < 1.0 &&
+	    field.num_history() > 0);
+  }
+
+  /// Set values = values_old + time_weight_*(values - values_old)
+  /// for n values of the given precision
+  void time_blend_ (precision_type precision, char * values,
+		    const char * values_old, int n) const;
+
+  template<class T>
+  void time_blend_ (T * values, const T * values_old, int n) const;
 
   std::vector<int> field_list_src_(Field field) const;
   std::vector<int> field_list_dst_(Field field) const;
   bool accumulate_(int index_src, int index_dst) const;
 
+  /// Save the Refresh attributes that num_bytes_array() depends on
+  void set_num_bytes_fields_();
+
+  /// Return whether the given Refresh has the same attributes as
+  /// those saved with num_bytes_array_
+  bool is_num_bytes_fields_(Refresh * refresh) const;
+
 private: // attributes
 
   /// Select face, including edges and corners (-1,-1,-1) to (1,1,1)
@@ -230,6 +332,18 @@ private: // attributes
 
   /// Whether refresh object should be deleted in destructor
   bool new_refresh_;
+
+  /// Weight of current values relative to history 1 values when
+  /// loading faces for finer neighbors (1.0 if not interpolating)
+  double time_weight_;
+
+  /// Saved result of num_bytes_array(), or -1 if not computed
+  int num_bytes_array_;
+
+  /// Whether all fields are refreshed, whether to accumulate, and the
+  /// source and destination field lists of the Refresh object used to
+  /// compute num_bytes_array_
+  std::vector<int> num_bytes_fields_;
 };
 
 #endif /* DATA_FIELD_FACE_HPP */
@@ -233,8 +233,11 @@ void ParticleData::scatter
 {
   // count number of particles in each particle_array element
 
-  int * np_array = new int[n];
-  for (int i=0; i<n; i++) np_array[i] = 0;
+  std::vector<int> work (3*n,0);
+  int * np_array = &work[0];
+  int * k_first  = &work[n];
+  int * i_array  = &work[2*n];
+  for (int k=0; k<n; k++) i_array[k] = -1;
 
   if (mask == NULL) {
     for (int ip=0; ip<np; ip++) {
@@ -246,26 +249,30 @@ void ParticleData::scatter
     }
   }
   
-  // insert uninitialized particles
-  std::map<ParticleData *, int>  i_array;
-  std::map<ParticleData *, bool> is_first;
+  // find first element sharing each element's ParticleData, since
+  // neighbors may overlap multiple elements
+
   for (int k=0; k<n; k++) {
-    ParticleData * pd = particle_array[k];
-    is_first[pd] = true;
-    i_array[pd] = 0;
+    k_first[k] = k;
+    for (int j=0; j<k; j++) {
+      if (particle_array[j] == particle_array[k]) {
+	k_first[k] = j;
+	break;
+      }
+    }
   }
 
+  // insert uninitialized particles
+
   for (int k=0; k<n; k++) {
     ParticleData * pd = particle_array[k];
     if (np_array[k]>0 && pd) {
       int i0 = pd->insert_particles (particle_descr,it,np_array[k]);
-      if (is_first[pd]) i_array[pd] = i0;
-      is_first[pd] = false;
+      // (later insertions into pd follow the first contiguously)
+      if (i_array[k_first[k]] < 0) i_array[k_first[k]] = i0;
     }
   }
 
-  delete [] np_array;
-  
   const bool interleaved = particle_descr->interleaved(it);
   const int na = particle_descr->num_attributes(it);
   int mp = particle_descr->particle_bytes(it);
@@ -278,7 +285,7 @@ void ParticleData::scatter
       ++count;
       int k = index[ip_src];
       ParticleData * pd = particle_array[k];
-      int i_dst = i_array[pd]++;
+      int i_dst = i_array[k_first[k]]++;
       int ib_dst,ip_dst;
       particle_descr->index(i_dst,&ib_dst,&ip_dst);
       for (int ia=0; ia<na; ia++) {
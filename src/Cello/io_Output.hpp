@@ -118,7 +118,7 @@ public: // functions
   void set_stride_write (int stride) throw () 
   {
     stride_write_ = stride; 
-    sync_write_.set_stop(stride_write_);
+    sync_write_.set_stop(is_writer() ? stride_write_ : 1);
   }
 
   int stride_write () const throw () 
@@ -221,6 +221,21 @@ public: // virtual functions
   virtual void cleanup_remote (int * n, char ** buffer) throw()
   {}
 
+  /// Return the process to send data prepared by prepare_remote()
+  /// to, by default the writer.  The receiving process's
+  /// sync_write() stop must count this process
+  virtual int process_remote () const throw()
+  { return process_writer(); }
+
+  /// Write the next part of any data staged for asynchronous output,
+  /// and return whether more remains
+  virtual bool drain () throw()
+  { return false; }
+
+  /// Write all data staged for asynchronous output
+  virtual void flush () throw()
+  {}
+
 protected:
 
   /// Return the name for the format and given arguments
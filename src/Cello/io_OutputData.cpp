@@ -10,6 +10,8 @@
 #include "main.hpp"
 #include "io.hpp"
 
+#include "charm_simulation.hpp"
+
 //----------------------------------------------------------------------
 
 // #define TRACE_OUTPUT
@@ -21,7 +23,12 @@ OutputData::OutputData
  Config * config
 ) throw ()
   : Output(index,factory),
-    text_block_count_(0)
+    block_list_(),
+    async_(config->output_async[index]),
+    async_limit_(1024.0*1024.0*config->output_async_limit_mb[index]),
+    layout_(output_layout_block),
+    stage_(NULL),
+    stage_drain_(NULL)
 {
   // Set process stride, with default = 1
 
@@ -40,12 +47,31 @@ OutputData::OutputData
   stride = config->output_stride_wait[index_];
   stride_wait_ = (stride == 0) ? 1 : stride;
 
+  const std::string layout = config->output_layout[index_];
+  if (layout == "block") {
+    layout_ = output_layout_block;
+  } else if (layout == "level") {
+    layout_ = output_layout_level;
+  } else {
+    ERROR2 ("OutputData::OutputData()",
+	    "Output:%s:layout = \"%s\" must be \"block\" or \"level\"",
+	    config->output_list[index_].c_str(),layout.c_str());
+  }
+
 }
 
 //----------------------------------------------------------------------
 
 OutputData::~OutputData() throw()
 {
+  // Write any staged data; stage_ closes and deletes file_
+  delete stage_drain_;
+  stage_drain_ = NULL;
+  if (stage_) {
+    delete stage_;
+    stage_ = NULL;
+    file_ = 0;
+  }
   close();
 }
 
@@ -60,7 +86,11 @@ void OutputData::pup (PUP::er &p)
 
   Output::pup(p);
 
-  p | text_block_count_;
+  // block_list_ is empty between outputs
+  p | async_;
+  p | async_limit_;
+  p | layout_;
+  // stage_ and stage_drain_ are flushed before checkpointing
 }
 
 //======================================================================
@@ -81,6 +111,14 @@ void OutputData::open () throw()
   file_ = new FileHdf5 (dir,file_name);
 
   file_->file_create();
+
+  // Block data are staged in memory and written after the output
+  // phase, or for the "level" layout when the file is closed; the
+  // OutputStage owns file_ once created
+
+  if (async_ || layout_ == output_layout_level) {
+    stage_ = new OutputStage (file_,layout_);
+  }
 }
 
 //----------------------------------------------------------------------
@@ -90,8 +128,112 @@ void OutputData::close () throw()
 #ifdef TRACE_OUTPUT
     CkPrintf ("%d TRACE_OUTPUT OutputData::close()\n",CkMyPe());
 #endif    
-  if (file_) file_->file_close();
-  delete file_;  file_ = 0;
+  if (file_) write_text_files_();
+
+  if (stage_ && async_) {
+
+    // Keep at most two outputs in memory: finish writing the previous
+    // one before handing this one off to be written in the background
+
+    delete stage_drain_;
+    stage_drain_ = stage_;
+    stage_ = NULL;
+    file_ = 0;
+
+    proxy_simulation[CkMyPe()].p_output_drain(index_);
+
+  } else if (stage_) {
+
+    // Write aggregated levels, then close file_
+
+    delete stage_;
+    stage_ = NULL;
+    file_ = 0;
+
+  } else {
+
+    if (file_) file_->file_close();
+    delete file_;  file_ = 0;
+
+  }
+}
+
+//----------------------------------------------------------------------
+
+void OutputData::text_file_names_
+(std::string * name_dir,
+ std::string * name_file,
+ std::string * name_out_file) const throw()
+{
+  (*name_dir)      = expand_name_(&dir_name_,&dir_args_);
+  (*name_out_file) = expand_name_(&file_name_,&file_args_);
+
+  if (*name_dir == "") {
+    // output block list and parameters to work directory
+    (*name_dir)  = ".";
+    // strip extension, use this for name
+    (*name_file) = name_out_file->substr(0, name_out_file->rfind("."));
+  } else {
+    // output block list and parameters to subdirectory
+    (*name_file) = (*name_dir);
+  }
+}
+
+//----------------------------------------------------------------------
+
+void OutputData::write_text_files_ () throw()
+{
+  std::string name_dir, name_file, name_out_file;
+
+  text_file_names_ (&name_dir,&name_file,&name_out_file);
+
+  // Send one DIR.block_list and one DIR.file_list contribution per
+  // process, rather than one per Block, so Main expects exactly
+  // CkNumPes() of each (count = 0)
+
+  std::string dir  = name_dir;
+  std::string file = name_file + ".block_list";
+
+  proxy_main.p_text_file_write(dir.size()+1,         dir.c_str(),
+			       file.size()+1,        file.c_str(),
+			       block_list_.size()+1, block_list_.c_str(),
+			       0);
+
+  // List this process's file only if it contains Blocks
+
+  file = name_file + ".file_list";
+  std::string line = block_list_.empty() ? "" : name_out_file + "\n";
+
+  proxy_main.p_text_file_write(dir.size()+1,  dir.c_str(),
+			       file.size()+1, file.c_str(),
+			       line.size()+1, line.c_str(),
+			       0);
+  block_list_.clear();
+}
+
+//----------------------------------------------------------------------
+
+bool OutputData::drain () throw()
+{
+  if (stage_drain_ == NULL) return false;
+
+  const bool more = stage_drain_->write_next();
+
+  if (! more) {
+    // closes the file
+    delete stage_drain_;
+    stage_drain_ = NULL;
+  }
+  return more;
+}
+
+//----------------------------------------------------------------------
+
+void OutputData::flush () throw()
+{
+  delete stage_drain_;
+  stage_drain_ = NULL;
+  if (stage_) stage_->write_all();
 }
 
 //----------------------------------------------------------------------
@@ -127,30 +269,10 @@ void OutputData::write_block ( const  Block * block ) throw()
     CkPrintf ("%d TRACE_OUTPUT OutputData::write_block()\n",CkMyPe());
 #endif    
 
-  char file[256];
-  char dir[256];
-  char line[256];
-
-  std::string name_dir = expand_name_(&dir_name_,&dir_args_);
-
+  std::string name_dir, name_file, name_out_file;
 
-  // Write blocks text file
-  std::string name_file;
-  std::string name_out_file  = expand_name_(&file_name_,&file_args_);
+  text_file_names_ (&name_dir,&name_file,&name_out_file);
 
-  if (name_dir == "") {
-    // output block list and parameters to work directory
-    name_dir  = ".";
-    // strip extension, use this for name
-    name_file = name_out_file.substr(0, name_out_file.rfind("."));
-  } else {
-    // output block list and parameters to subdirectory
-    name_file = name_dir;
-  }
-
-  const int num_blocks = cello::hierarchy()->num_blocks();
-  int count = 0;
-    
   // Write DIR.parameters file
 
   if (block->index().is_root()) {
@@ -159,44 +281,33 @@ void OutputData::write_block ( const  Block * block ) throw()
     std::string libconfig_file_name = name_dir+"/"+name_file+".libconfig";
     g_parameters.write(libconfig_file_name.c_str(),param_write_libconfig);
   }
-    
-  // Contribute to DIR.block_list file
-    
-  count = (text_block_count_ == 0) ? num_blocks : 0;
-
-  sprintf (file,"%s.block_list",name_file.c_str());
-  sprintf (dir, "%s",           name_dir.c_str());
-  sprintf (line,"%s %s\n",      block->name().c_str(),name_out_file.c_str());
-    
-  proxy_main.p_text_file_write(strlen(dir)+1,  dir,
-			       strlen(file)+1, file,
-			       strlen(line)+1, line,
-			       count);
-    
-    // Contribute to DIR.file_list file
-
-  if (text_block_count_ == 0) {
-      
-    count = 0;
-    
-    sprintf (file,"%s.file_list",name_file.c_str());
-    sprintf (dir, "%s",          name_dir.c_str());
-    sprintf (line,"%s\n",        name_out_file.c_str());
-    
-    proxy_main.p_text_file_write(strlen(dir)+1,  dir,
-				 strlen(file)+1, file,
-				 strlen(line)+1, line,
-				 count);
-  }    
 
-  // Increment block counter
+  // Append to this process's DIR.block_list lines, sent in close()
 
-  text_block_count_ = (text_block_count_ + 1) % num_blocks;
+  block_list_ += block->name() + " " + name_out_file + "\n";
 
   // Create file group for block
 
   std::string group_name = "/" + block->name();
 
+  if (stage_) {
+
+    // Copy block data to be written later, either asynchronously
+    // or aggregated by level
+
+    stage_->new_block(group_name,block->level());
+
+    io_block()->set_block((Block *)block);
+
+    stage_meta_ (io_block());
+
+    Output::write_block(block);
+
+    if (async_) stage_limit_();
+
+    return;
+  }
+
   DEBUG1 ("block name = %s",group_name.c_str());
   file_->group_chdir(group_name);
   file_->group_create();
@@ -222,6 +333,11 @@ void OutputData::write_field_data
   const FieldData * field_data,
   int index_field) throw()
 {
+  if (stage_) {
+    stage_field_data_ (field_data,index_field);
+    return;
+  }
+
   io_field_data()->set_field_data((FieldData*)field_data);
   io_field_data()->set_field_index(index_field);
 
@@ -262,6 +378,11 @@ void OutputData::write_particle_data
 ( const ParticleData * particle_data,
   int it) throw()
 {
+  if (stage_) {
+    stage_particle_data_ (particle_data,it);
+    return;
+  }
+
   ParticleDescr * particle_descr = cello::particle_descr();
   
   const Particle particle ( (ParticleDescr*) particle_descr,
@@ -334,3 +455,115 @@ void OutputData::write_particle_data
 }
 
 //======================================================================
+
+void OutputData::stage_meta_ (Io * io) throw()
+{
+  for (size_t i=0; i<io->meta_count(); i++) {
+
+    void * buffer;
+    std::string name;
+    int type;
+    int nx,ny,nz;
+
+    io->meta_value(i,& buffer, &name, &type, &nx,&ny,&nz);
+
+    stage_->add_meta(buffer,name,type,nx,ny,nz);
+  }
+}
+
+//----------------------------------------------------------------------
+
+void OutputData::stage_field_data_
+(
+  const FieldData * field_data,
+  int index_field) throw()
+{
+  io_field_data()->set_field_data((FieldData*)field_data);
+  io_field_data()->set_field_index(index_field);
+
+  for (size_t i=0; i<io_field_data()->data_count(); i++) {
+
+    void * buffer;
+    std::string name;
+    int type;
+    int nxd,nyd,nzd;  // Array dimension
+    int nx,ny,nz;     // Array size
+
+    io_field_data()->field_array(i, &buffer, &name, &type,
+				 &nxd,&nyd,&nzd,
+				 &nx, &ny, &nz);
+
+    char * values = stage_->new_data(name,type,nxd,nyd,nzd,nx,ny,nz);
+
+    memcpy (values, buffer, cello::type_bytes[type]*nx*ny*nz);
+  }
+}
+
+//----------------------------------------------------------------------
+
+void OutputData::stage_particle_data_
+( const ParticleData * particle_data,
+  int it) throw()
+{
+  ParticleDescr * particle_descr = cello::particle_descr();
+
+  const Particle particle ( (ParticleDescr*) particle_descr,
+			    (ParticleData*)  particle_data);
+
+  const int nb = particle.num_batches(it);
+  const int na = particle.num_attributes(it);
+  const int np = particle.num_particles (it);
+
+  // Concatenate batches of each attribute into a single array
+
+  for (int ia=0; ia<na; ia++) {
+
+    const std::string name = "particle_"
+      +                particle.type_name(it) + "_"
+      +                particle.attribute_name(it,ia);
+
+    const int type  = particle.attribute_type(it,ia);
+    const int bytes = cello::type_bytes[type];
+
+    char * values = stage_->new_data(name,type,np,1,1,np,1,1);
+
+    int i0 = 0;
+
+    for (int ib=0; ib<nb; ib++) {
+
+      const int mb = particle.num_particles(it,ib);
+
+      memcpy (values + i0*bytes, particle.attribute_array(it,ia,ib), mb*bytes);
+
+      i0 += mb;
+    }
+
+    ASSERT2 ("OutputData::stage_particle_data_()",
+	     "Particle count mismatch %d particles %d staged",
+	     np,i0,
+	     np == i0);
+  }
+}
+
+//----------------------------------------------------------------------
+
+void OutputData::stage_limit_ () throw()
+{
+  // Back-pressure: if staged data exceed the limit, block until the
+  // previous output is written, then write the current one directly
+
+  long long bytes = stage_->bytes();
+  if (stage_drain_) bytes += stage_drain_->bytes();
+
+  if (bytes > async_limit_) {
+    delete stage_drain_;
+    stage_drain_ = NULL;
+    // Levels cannot be written until all Blocks are staged
+    if (stage_->bytes() > async_limit_ &&
+	stage_->layout() == output_layout_block) {
+      stage_->write_all();
+    }
+  }
+}
+
+//======================================================================
@@ -21,7 +21,14 @@ class OutputData : public Output {
 public: // functions
 
   /// Empty constructor for Charm++ pup()
-  OutputData() throw() : text_block_count_(0) {}
+  OutputData() throw()
+    : block_list_(),
+      async_(false),
+      async_limit_(0),
+      layout_(output_layout_block),
+      stage_(NULL),
+      stage_drain_(NULL)
+  {}
 
   /// Create an uninitialized OutputData object
   OutputData(int index,
@@ -37,7 +44,12 @@ public: // functions
   /// Charm++ PUP::able migration constructor
   OutputData (CkMigrateMessage *m)
     : Output (m),
-      text_block_count_(0)
+      block_list_(),
+      async_(false),
+      async_limit_(0),
+      layout_(output_layout_block),
+      stage_(NULL),
+      stage_drain_(NULL)
   { }
 
   /// CHARM++ Pack / Unpack function
@@ -75,11 +87,60 @@ public: // virtual functions
   ( const ParticleData * particle_data,
     int index_particle) throw();
 
-protected:
+  /// Write the next Block staged for asynchronous output, closing the
+  /// file when done, and return whether more Blocks remain
+  virtual bool drain () throw();
 
-  /// Count of number of Blocks sent from local process for text file
-  /// output
-  int text_block_count_;
+  /// Write all Blocks staged for asynchronous output
+  virtual void flush () throw();
+
+protected: // functions
+
+  /// Return the directory, base name, and data file name used for
+  /// the DIR.parameters, DIR.block_list, and DIR.file_list files
+  void text_file_names_ (std::string * name_dir,
+			 std::string * name_file,
+			 std::string * name_out_file) const throw();
+
+  /// Send this process's DIR.block_list and DIR.file_list lines to Main
+  void write_text_files_ () throw();
+
+  /// Copy Block metadata into the current OutputStage
+  void stage_meta_ (Io * io) throw();
+
+  /// Copy field data into the current OutputStage
+  void stage_field_data_ (const FieldData * field_data,
+			  int index_field) throw();
+
+  /// Copy particle data into the current OutputStage
+  void stage_particle_data_ (const ParticleData * particle_data,
+			     int index_particle) throw();
+
+  /// Write staged data to disk if staging memory is exhausted
+  void stage_limit_ () throw();
+
+protected: // attributes
+
+  /// Lines for the DIR.block_list file from local Blocks, sent to
+  /// Main once per process when the file is closed
+  std::string block_list_;
+
+  /// Whether to stage Block data in memory and write it to disk
+  /// while the simulation continues
+  bool async_;
+
+  /// Maximum bytes of staged data before writing synchronously
+  double async_limit_;
+
+  /// Layout of Block data in the file, either output_layout_block
+  /// or output_layout_level
+  int layout_;
+
+  /// Block data being staged for the current output
+  OutputStage * stage_;
+
+  /// Block data from the previous output being written to disk
+  OutputStage * stage_drain_;
 };
 
 #endif /* IO_OUTPUT_DATA_HPP */
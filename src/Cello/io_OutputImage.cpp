@@ -18,6 +18,9 @@
 #  define TRACE_OUTPUT(M) /* ... */
 #endif
 
+// Image tiles sent between processes are 2^tile_bits pixels square
+static const int tile_bits = 5;
+
 //----------------------------------------------------------------------
 
 OutputImage::OutputImage(int index,
@@ -39,7 +42,8 @@ OutputImage::OutputImage(int index,
 			 bool image_log,
 			 bool image_abs,
 			 bool ghost,
-			 double min_value, double max_value) throw ()
+			 double min_value, double max_value,
+			 std::string image_remote_precision) throw ()
 : Output(index,factory),
     image_data_(NULL),
     image_mesh_(NULL),
@@ -56,8 +60,11 @@ OutputImage::OutputImage(int index,
     ghost_(ghost),
     min_level_(min_level),
     max_level_(max_level),
-    leaf_only_(leaf_only)
-
+    leaf_only_(leaf_only),
+    remote_float_(false),
+    ntx_(0),
+    nty_(0),
+    tile_used_()
 {
 
   if      (image_reduce_type=="min") { op_reduce_ = reduce_min; } 
@@ -70,6 +77,14 @@ OutputImage::OutputImage(int index,
 	    image_reduce_type.c_str());
   }
 
+  if      (image_remote_precision=="single") { remote_float_ = true; }
+  else if (image_remote_precision=="double") { remote_float_ = false; }
+  else {
+    ERROR1 ("OutputImage::OutputImage()",
+	    "Unrecognized output_image_remote_precision %s",
+	    image_remote_precision.c_str());
+  }
+
   if      (image_mesh_color=="level")   mesh_color_type_ = mesh_color_level;
   else if (image_mesh_color=="process") mesh_color_type_ = mesh_color_process;
   else if (image_mesh_color=="age")     mesh_color_type_ = mesh_color_age;
@@ -101,7 +116,8 @@ OutputImage::OutputImage(int index,
     nyi_ += 2*nyb*ngy*nl;
   }
   
-  // Override default Output::stride_write_: only root writes
+  // Override default Output::stride_write_: only root writes, after
+  // images are combined in a tree of processes (see init())
   set_stride_write (process_count);
   // Let all processes contribute data when its available
   // (wait stride may be helpful for performance?)
@@ -195,6 +211,10 @@ void OutputImage::pup (PUP::er &p)
   PUParray(p,image_lower_,3);
   PUParray(p,image_upper_,3);
   p | ghost_;
+  p | remote_float_;
+  p | ntx_;
+  p | nty_;
+  p | tile_used_;
 }
 
 //----------------------------------------------------------------------
@@ -222,6 +242,10 @@ void OutputImage::init () throw()
 {
   TRACE_OUTPUT("OutputImage::init()");
   image_create_();
+
+  // Wait for this process's Blocks and its children in the tree
+
+  sync_write_.set_stop(1 + num_children_());
 }
 
 //----------------------------------------------------------------------
@@ -562,15 +586,31 @@ void OutputImage::prepare_remote (int * n, char ** buffer) throw()
   TRACE("OutputImage::prepare_remote()");
   DEBUG("prepare_remote");
 
-  int size = 0;
-  int nx = nxi_;
-  int ny = nyi_;
+  // List tiles updated by this process or its children
+
+  std::vector<int> tile_list;
+  int num_pixels = 0;
+  for (int it=0; it<ntx_*nty_; it++) {
+    if (tile_used_[it]) {
+      int ixm,ixp,iym,iyp;
+      tile_range_(it,&ixm,&ixp,&iym,&iyp);
+      tile_list.push_back(it);
+      num_pixels += (ixp-ixm)*(iyp-iym);
+    }
+  }
 
-  // Determine buffer size
+  const int num_tiles  = tile_list.size();
+  const int num_images =
+    (type_is_data_() ? 1 : 0) + (type_is_mesh_() ? 1 : 0);
+  const int bytes = remote_float_ ? sizeof(float) : sizeof(double);
 
-  size += 2*sizeof(int);        // nxi_, nyi_
-  size += nx*ny*sizeof(double); // image_data_
-  size += nx*ny*sizeof(double); // image_mesh_
+  // Determine buffer size, padding integers to align values
+
+  const int num_ints = 4 + num_tiles + (num_tiles % 2);
+
+  int size = 0;
+  size += num_ints*sizeof(int);          // nxi_, nyi_, tiles, precision
+  size += num_images*num_pixels*bytes;   // image_data_, image_mesh_
   (*n) = size;
 
   // Allocate buffer (deallocated in cleanup_remote())
@@ -578,18 +618,21 @@ void OutputImage::prepare_remote (int * n, char ** buffer) throw()
 
   union {
     char   * c;
-    double * d;
     int    * i;
   } p ;
 
   p.c = (*buffer);
 
-  *p.i++ = nx;
-  *p.i++ = ny;
+  p.i[0] = nxi_;
+  p.i[1] = nyi_;
+  p.i[2] = num_tiles;
+  p.i[3] = remote_float_;
+  for (int k=0; k<num_tiles; k++) p.i[4+k] = tile_list[k];
 
-  for (int k=0; k<nx*ny; k++) *p.d++ = image_data_[k];
-  for (int k=0; k<nx*ny; k++) *p.d++ = image_mesh_[k];
-  
+  char * values = (*buffer) + num_ints*sizeof(int);
+
+  if (type_is_data_()) values = pack_tiles_(values,image_data_,tile_list);
+  if (type_is_mesh_()) values = pack_tiles_(values,image_mesh_,tile_list);
 }
 
 //----------------------------------------------------------------------
@@ -601,34 +644,34 @@ void OutputImage::update_remote  ( int m, char * buffer) throw()
 
   union {
     char   * c;
-    double * d;
     int    * i;
   } p ;
 
   p.c = buffer;
 
-  const int nx = *p.i++;
-  const int ny = *p.i++;
+  const int nx        = p.i[0];
+  const int ny        = p.i[1];
+  const int num_tiles = p.i[2];
+  const bool is_float = p.i[3];
+  const int * tile_list = p.i + 4;
 
-  const int n = nx*ny;
-  
-  if (op_reduce_ == reduce_min) {
-    for (int k=0; k<n; k++) image_data_[k] = std::min(image_data_[k],*p.d++);
-    for (int k=0; k<n; k++) image_mesh_[k] = std::min(image_mesh_[k],*p.d++);
-  } else if (op_reduce_ == reduce_max) {
-    for (int k=0; k<n; k++) image_data_[k] = std::max(image_data_[k],*p.d++);
-    for (int k=0; k<n; k++) image_mesh_[k] = std::max(image_mesh_[k],*p.d++);
-  } else if (op_reduce_ == reduce_sum) {
-    for (int k=0; k<n; k++) image_data_[k] += *p.d++;
-    for (int k=0; k<n; k++) image_mesh_[k] += *p.d++;
-  } else if (op_reduce_ == reduce_avg) {
-    for (int k=0; k<n; k++) image_data_[k] += *p.d++;
-    for (int k=0; k<n; k++) image_mesh_[k] += *p.d++;
-  } else if (op_reduce_ == reduce_set) {
-    for (int k=0; k<n; k++) image_data_[k]  = *p.d++;
-    for (int k=0; k<n; k++) image_mesh_[k]  = *p.d++;
-  }
+  ASSERT4 ("OutputImage::update_remote()",
+	   "Remote image size %d x %d differs from local size %d x %d",
+	   nx,ny,nxi_,nyi_,
+	   (nx == nxi_ && ny == nyi_));
+
+  const int num_ints = 4 + num_tiles + (num_tiles % 2);
+
+  char * values = buffer + num_ints*sizeof(int);
+
+  if (type_is_data_())
+    values = unpack_tiles_(values,image_data_,tile_list,num_tiles,is_float);
+  if (type_is_mesh_())
+    values = unpack_tiles_(values,image_mesh_,tile_list,num_tiles,is_float);
+
+  // Forward received tiles to the parent process
 
+  for (int k=0; k<num_tiles; k++) tile_used_[tile_list[k]] = 1;
 }
 
 //----------------------------------------------------------------------
@@ -641,9 +684,111 @@ void OutputImage::cleanup_remote  (int * n, char ** buffer) throw()
   (*buffer) = NULL;
 }
 
+//----------------------------------------------------------------------
+
+int OutputImage::process_remote () const throw()
+{
+  // Binary tree of processes, numbered from the writer
+  const int ip_write = process_writer();
+  return ip_write + (CkMyPe() - ip_write - 1) / 2;
+}
 
 //======================================================================
 
+int OutputImage::num_children_ () const throw()
+{
+  const int ip_write = process_writer();
+  const int np = std::min(stride_write_, CkNumPes() - ip_write);
+  const int ir = CkMyPe() - ip_write;
+  return ((2*ir+1 < np) ? 1 : 0) + ((2*ir+2 < np) ? 1 : 0);
+}
+
+//----------------------------------------------------------------------
+
+void OutputImage::tile_range_
+(int it, int * ixm, int * ixp, int * iym, int * iyp) const throw()
+{
+  const int itx = it % ntx_;
+  const int ity = it / ntx_;
+  (*ixm) = itx << tile_bits;
+  (*iym) = ity << tile_bits;
+  (*ixp) = std::min((itx+1) << tile_bits, nxi_);
+  (*iyp) = std::min((ity+1) << tile_bits, nyi_);
+}
+
+//----------------------------------------------------------------------
+
+char * OutputImage::pack_tiles_
+(char * buffer, const double * image,
+ const std::vector<int> & tile_list) const throw()
+{
+  float  * values_float  = (float *)  buffer;
+  double * values_double = (double *) buffer;
+
+  // clamp to float range, e.g. for unset pixels with reduce_min
+  const double max_float = std::numeric_limits<float>::max();
+
+  for (size_t k=0; k<tile_list.size(); k++) {
+    int ixm,ixp,iym,iyp;
+    tile_range_(tile_list[k],&ixm,&ixp,&iym,&iyp);
+    for (int iy=iym; iy<iyp; iy++) {
+      const double * row = image + nxi_*iy;
+      if (remote_float_) {
+	for (int ix=ixm; ix<ixp; ix++) {
+	  *values_float++ = std::max(-max_float,std::min(max_float,row[ix]));
+	}
+      } else {
+	for (int ix=ixm; ix<ixp; ix++) *values_double++ = row[ix];
+      }
+    }
+  }
+  return remote_float_ ? (char *)values_float : (char *)values_double;
+}
+
+//----------------------------------------------------------------------
+
+char * OutputImage::unpack_tiles_
+(char * buffer, double * image,
+ const int * tile_list, int num_tiles, bool is_float) throw()
+{
+  float  * values_float  = (float *)  buffer;
+  double * values_double = (double *) buffer;
+
+  const double max_float  = std::numeric_limits<float>::max();
+  const double max_double = std::numeric_limits<double>::max();
+
+  for (int k=0; k<num_tiles; k++) {
+    int ixm,ixp,iym,iyp;
+    tile_range_(tile_list[k],&ixm,&ixp,&iym,&iyp);
+    for (int iy=iym; iy<iyp; iy++) {
+      double * row = image + nxi_*iy;
+      for (int ix=ixm; ix<ixp; ix++) {
+	double value;
+	if (is_float) {
+	  value = *values_float++;
+	  // restore values clamped in pack_tiles_()
+	  if (value >=  max_float) value =  max_double;
+	  if (value <= -max_float) value = -max_double;
+	} else {
+	  value = *values_double++;
+	}
+	if (op_reduce_ == reduce_min) {
+	  row[ix] = std::min(row[ix],value);
+	} else if (op_reduce_ == reduce_max) {
+	  row[ix] = std::max(row[ix],value);
+	} else if (op_reduce_ == reduce_sum || op_reduce_ == reduce_avg) {
+	  row[ix] += value;
+	} else if (op_reduce_ == reduce_set) {
+	  row[ix] = value;
+	}
+      }
+    }
+  }
+  return is_float ? (char *)values_float : (char *)values_double;
+}
+
+//----------------------------------------------------------------------
+
 double OutputImage::mesh_color_(int level,int age) const
 {
   if (mesh_color_type_ == mesh_color_level) {
@@ -736,6 +881,10 @@ void OutputImage::image_create_ () throw()
   for (int i=0; i<nxi_*nyi_; i++) image_data_[i] = value0;
   for (int i=0; i<nxi_*nyi_; i++) image_mesh_[i] = value0;
 
+  ntx_ = (nxi_ + (1 << tile_bits) - 1) >> tile_bits;
+  nty_ = (nyi_ + (1 << tile_bits) - 1) >> tile_bits;
+  tile_used_.assign(ntx_*nty_,0);
+
 }
 
 //----------------------------------------------------------------------
@@ -886,6 +1035,8 @@ void OutputImage::reduce_point_
   }
   const int i = ix + nxi_*iy;
 
+  tile_used_[(ix >> tile_bits) + ntx_*(iy >> tile_bits)] = 1;
+
   double value_new = 0.0;
   
   switch (op_reduce_) {
@@ -23,6 +23,12 @@ class OutputImage : public Output {
   /// @class    OutputImage
   /// @ingroup  Io
   /// @brief [\ref Io] class for writing images
+  ///
+  /// Each process accumulates its Blocks into a local image, and
+  /// images are combined in a binary tree of processes rooted at
+  /// the writer.  Only the square tiles of the image that Blocks or
+  /// particles contributed to are sent, optionally in single
+  /// precision.
 
 public: // functions
 
@@ -50,7 +56,8 @@ public: // functions
 	      bool image_log,
 	      bool image_abs,
 	      bool ghost,
-	      double min_value, double max_value) throw();
+	      double min_value, double max_value,
+	      std::string image_remote_precision) throw();
 
   /// OutputImage destructor: free allocated image data
   virtual ~OutputImage() throw();
@@ -80,7 +87,11 @@ public: // functions
       ghost_(false),
       min_level_(0),
       max_level_(0),
-      leaf_only_(false)
+      leaf_only_(false),
+      remote_float_(false),
+      ntx_(0),
+      nty_(0),
+      tile_used_()
   {
     for (int axis=0; axis<3; axis++) {
       image_lower_[axis] = -std::numeric_limits<double>::max();
@@ -132,6 +143,9 @@ public: // virtual functions
   /// Free local array if allocated; NOP if not
   virtual void cleanup_remote (int * n, char ** buffer) throw();
 
+  /// Return the parent of this process in the tree combining images
+  virtual int process_remote () const throw();
+
 private: // functions
 
   /// value associated with the given mesh level
@@ -177,6 +191,24 @@ private: // functions
 
   double data_(int i) const ;
 
+  /// Return the number of processes sending images to this process
+  int num_children_ () const throw();
+
+  /// Return the pixel range [ixm,ixp) x [iym,iyp) of the given tile
+  void tile_range_ (int it, int * ixm, int * ixp, int * iym, int * iyp)
+    const throw();
+
+  /// Copy the pixels of the listed tiles of the image to the buffer,
+  /// and return the end of the copied values
+  char * pack_tiles_ (char * buffer, const double * image,
+		      const std::vector<int> & tile_list) const throw();
+
+  /// Reduce the pixels of the listed tiles in the buffer into the
+  /// image, and return the end of the buffer values
+  char * unpack_tiles_ (char * buffer, double * image,
+			const int * tile_list, int num_tiles,
+			bool is_float) throw();
+
 private: // attributes
 
   /// Color map
@@ -239,7 +271,16 @@ private: // attributes
   /// Lower and upper bounds on image (can be used for slices)
   double image_lower_[3];
   double image_upper_[3];
-  
+
+  /// Whether to send image tiles in single precision
+  bool remote_float_;
+
+  /// Number of image tiles along each axis
+  int ntx_, nty_;
+
+  /// Whether any pixel in each image tile has been updated
+  std::vector<char> tile_used_;
+
 };
 
 #endif /* IO_OUTPUT_IMAGE_HPP */
@@ -0,0 +1,359 @@
+// See LICENSE_CELLO file for license and copyright information
+
+/// @file     io_OutputStage.cpp
+/// @author   James Bordner (jobordner@ucsd.edu)
+/// @date     2020-03-30
+/// @brief    Implementation of the OutputStage class
+
+#include "io.hpp"
+
+//----------------------------------------------------------------------
+
+OutputStage::OutputStage(File * file, int layout) throw()
+  : file_(file),
+    layout_(layout),
+    block_list_(),
+    level_map_(),
+    level_(0),
+    bytes_(0)
+{
+}
+
+//----------------------------------------------------------------------
+
+OutputStage::~OutputStage() throw()
+{
+  write_all();
+  if (file_) file_->file_close();
+  delete file_;
+  file_ = NULL;
+}
+
+//----------------------------------------------------------------------
+
+void OutputStage::new_block (std::string group_name, int level) throw()
+{
+  if (layout_ == output_layout_level) {
+    level_ = level;
+    ++ level_map_[level_].num_blocks;
+  } else {
+    block_list_.push_back(BlockData());
+    block_list_.back().group_name = group_name;
+  }
+}
+
+//----------------------------------------------------------------------
+
+void OutputStage::add_meta
+(const void * buffer, std::string name, int type,
+ int nx, int ny, int nz) throw()
+{
+  if (layout_ == output_layout_level) {
+    char * values = append_ (&level_map_[level_].meta_list,
+			     name,type,nx,ny,nz,nx,ny,nz);
+    memcpy (values, buffer,
+	    cello::type_bytes[type]*nx*std::max(ny,1)*std::max(nz,1));
+    return;
+  }
+
+  std::vector<Array> & meta_list = block_list_.back().meta_list;
+
+  meta_list.push_back(Array());
+  Array & array = meta_list.back();
+
+  // metadata dimensions may be 0 for unused axes
+  array.name = name;
+  array.type = type;
+  array.nxd = array.nx = nx;
+  array.nyd = array.ny = ny;
+  array.nzd = array.nz = nz;
+
+  char * values = allocate_(&array);
+  memcpy (values, buffer, array.values.size());
+}
+
+//----------------------------------------------------------------------
+
+char * OutputStage::new_data
+(std::string name, int type,
+ int nxd, int nyd, int nzd,
+ int nx,  int ny,  int nz) throw()
+{
+  if (layout_ == output_layout_level) {
+    return append_ (&level_map_[level_].data_list,
+		    name,type,nxd,nyd,nzd,nx,ny,nz);
+  }
+
+  std::vector<Array> & data_list = block_list_.back().data_list;
+
+  data_list.push_back(Array());
+  Array & array = data_list.back();
+
+  array.name = name;
+  array.type = type;
+  array.nxd = nxd;
+  array.nyd = nyd;
+  array.nzd = nzd;
+  array.nx  = nx;
+  array.ny  = ny;
+  array.nz  = nz;
+
+  return allocate_(&array);
+}
+
+//----------------------------------------------------------------------
+
+bool OutputStage::write_next() throw()
+{
+  if (layout_ == output_layout_level) {
+    if (level_map_.empty()) return false;
+    write_level_();
+    return ! level_map_.empty();
+  }
+
+  if (block_list_.empty()) return false;
+
+  BlockData & block_data = block_list_.front();
+
+  file_->group_chdir(block_data.group_name);
+  file_->group_create();
+
+  // Write block metadata
+
+  for (size_t i=0; i<block_data.meta_list.size(); i++) {
+    Array & array = block_data.meta_list[i];
+    file_->group_write_meta (&array.values[0],array.name.c_str(),array.type,
+			     array.nx,array.ny,array.nz);
+    bytes_ -= array.values.size();
+  }
+
+  // Write field and particle datasets
+
+  for (size_t i=0; i<block_data.data_list.size(); i++) {
+
+    Array & array = block_data.data_list[i];
+
+    const int nx = array.nx;
+    const int ny = array.ny;
+    const int nz = array.nz;
+    const int nxd = array.nxd;
+    const int nyd = array.nyd;
+    const int nzd = array.nzd;
+    const char * name = array.name.c_str();
+
+    if (nzd > 1) {
+      file_->data_create(name,array.type,nzd,nyd,nxd,1,nz,ny,nx,1);
+    } else if (nyd > 1) {
+      file_->data_create(name,array.type,nyd,nxd,  1,1,ny,nx, 1,1);
+    } else {
+      file_->data_create(name,array.type,nxd,  1,  1,1,nx,  1,1,1);
+    }
+    // skip writing empty datasets, e.g. particle types with no particles
+    if (array.values.size() > 0) {
+      file_->mem_create(nx,ny,nz,nx,ny,nz,0,0,0);
+      file_->data_write(&array.values[0]);
+      file_->mem_close();
+    }
+    file_->data_close();
+
+    bytes_ -= array.values.size();
+  }
+
+  file_->group_close();
+
+  block_list_.pop_front();
+
+  return ! block_list_.empty();
+}
+
+//----------------------------------------------------------------------
+
+char * OutputStage::allocate_ (Array * array) throw()
+{
+  const int nx = std::max(array->nx,1);
+  const int ny = std::max(array->ny,1);
+  const int nz = std::max(array->nz,1);
+
+  const size_t bytes = cello::type_bytes[array->type];
+
+  // array->nx may be 0 for empty particle datasets
+
+  array->values.resize(bytes*nx*ny*nz*(array->nx > 0));
+
+  bytes_ += array->values.size();
+
+  return array->values.size() > 0 ? &array->values[0] : NULL;
+}
+
+//----------------------------------------------------------------------
+
+char * OutputStage::append_
+(std::vector<LevelArray> * level_list,
+ std::string name, int type,
+ int nxd, int nyd, int nzd,
+ int nx,  int ny,  int nz) throw()
+{
+  const int num_blocks = level_map_[level_].num_blocks;
+
+  // Find the array, or create it if this is the first Block
+
+  size_t i;
+  for (i=0; i<level_list->size() && (*level_list)[i].array.name != name; i++)
+    ;
+
+  if (i == level_list->size()) {
+    level_list->push_back(LevelArray());
+    LevelArray & level_array = level_list->back();
+    level_array.array.name = name;
+    level_array.array.type = type;
+    level_array.array.nxd  = nxd;
+    level_array.array.nyd  = nyd;
+    level_array.array.nzd  = nzd;
+    level_array.array.nx   = nx;
+    level_array.array.ny   = ny;
+    level_array.array.nz   = nz;
+    level_array.is_uniform = true;
+  }
+
+  LevelArray & level_array = (*level_list)[i];
+  Array & array = level_array.array;
+
+  ASSERT3 ("OutputStage::append_()",
+	   "Array %s missing from %d of %d Blocks",
+	   name.c_str(),num_blocks-1-int(level_array.offset.size()),num_blocks,
+	   int(level_array.offset.size()) == num_blocks - 1);
+
+  // Arrays that differ in size between Blocks, e.g. particle
+  // attributes, are written as one-dimensional datasets
+
+  if (nxd != array.nxd || nyd != array.nyd || nzd != array.nzd ||
+      nx  != array.nx  || ny  != array.ny  || nz  != array.nz) {
+    level_array.is_uniform = false;
+  }
+
+  const size_t bytes = cello::type_bytes[type];
+  const size_t size  = array.values.size();
+  const size_t n = (nx > 0) ?
+    size_t(nx)*std::max(ny,1)*std::max(nz,1) : 0;
+
+  level_array.offset.push_back(size / bytes);
+
+  array.values.resize(size + n*bytes);
+
+  bytes_ += n*bytes;
+
+  return array.values.data() + size;
+}
+
+//----------------------------------------------------------------------
+
+void OutputStage::write_level_ () throw()
+{
+  std::map<int,LevelData>::iterator it_level = level_map_.begin();
+
+  int level = it_level->first;
+  LevelData & level_data = it_level->second;
+
+  const int nb = level_data.num_blocks;
+
+  char group_name[40];
+  snprintf (group_name,sizeof(group_name),"/level_%d",level);
+
+  file_->group_chdir(group_name);
+  file_->group_create();
+  file_->group_write_meta(&level,"level",type_int,1);
+  file_->group_write_meta(&nb,"num_blocks",type_int,1);
+
+  // Write Block metadata as "block_<name>" arrays, one row per Block
+
+  for (size_t i=0; i<level_data.meta_list.size(); i++) {
+    const LevelArray & level_array = level_data.meta_list[i];
+    write_level_array_
+      (level_array,"block_" + level_array.array.name, nb, -1);
+  }
+
+  // Write field and particle datasets
+
+  const int nd = level_data.data_list.size();
+
+  for (int id=0; id<nd; id++) {
+    const LevelArray & level_array = level_data.data_list[id];
+    write_level_array_ (level_array,level_array.array.name, nb, id);
+  }
+
+  // Write table of Block offsets into each dataset, whose column
+  // is stored in the dataset's "block_offset_column" attribute
+
+  if (nd > 0) {
+    std::vector<long long> block_offset (nb*nd);
+    for (int id=0; id<nd; id++) {
+      const LevelArray & level_array = level_data.data_list[id];
+      for (int ib=0; ib<nb; ib++) {
+	block_offset[ib*nd+id] = level_array.offset[ib];
+      }
+    }
+    file_->data_create("block_offset",type_long_long,nb,nd,1,1,nb,nd,1,1);
+    file_->mem_create(nb*nd,1,1,nb*nd,1,1,0,0,0);
+    file_->data_write(block_offset.data());
+    file_->mem_close();
+    file_->data_close();
+  }
+
+  file_->group_close();
+
+  level_map_.erase(it_level);
+}
+
+//----------------------------------------------------------------------
+
+void OutputStage::write_level_array_
+(const LevelArray & level_array, std::string name,
+ int nb, int column) throw()
+{
+  const Array & array = level_array.array;
+
+  const size_t n = array.values.size() / cello::type_bytes[array.type];
+
+  // File dataset dimensions are int
+
+  ASSERT2 ("OutputStage::write_level_array_()",
+	   "Dataset %s has %lu elements, too many for File",
+	   name.c_str(),(unsigned long)n,
+	   n <= size_t(std::numeric_limits<int>::max()));
+
+  const int nx  = array.nx;
+  const int ny  = array.ny;
+  const int nz  = array.nz;
+  const int nxd = array.nxd;
+  const int nyd = array.nyd;
+  const int nzd = array.nzd;
+
+  // Uniform arrays are stacked along a new leading axis indexed by
+  // Block, others are concatenated
+
+  if (! level_array.is_uniform || n == 0) {
+    file_->data_create(name,array.type,int(n),1,1,1,int(n),1,1,1);
+  } else if (nzd > 1) {
+    file_->data_create(name,array.type,nb,nzd,nyd,nxd,nb,nz,ny,nx);
+  } else if (nyd > 1) {
+    file_->data_create(name,array.type,nb,nyd,nxd,  1,nb,ny,nx, 1);
+  } else {
+    file_->data_create(name,array.type,nb,nxd,  1,  1,nb,nx, 1, 1);
+  }
+
+  if (n > 0) {
+    file_->mem_create(int(n),1,1,int(n),1,1,0,0,0);
+    file_->data_write(array.values.data());
+    file_->mem_close();
+  }
+
+  if (column >= 0) {
+    file_->data_write_meta(&column,"block_offset_column",type_int,1);
+  }
+
+  file_->data_close();
+
+  bytes_ -= array.values.size();
+}
+
+//======================================================================
@@ -0,0 +1,158 @@
+// See LICENSE_CELLO file for license and copyright information
+
+/// @file     io_OutputStage.hpp
+/// @author   James Bordner (jobordner@ucsd.edu)
+/// @date     2020-03-30
+/// @brief    [\ref Io] Declaration of the OutputStage class
+
+#ifndef IO_OUTPUT_STAGE_HPP
+#define IO_OUTPUT_STAGE_HPP
+
+class File;
+
+class OutputStage {
+
+  /// @class    OutputStage
+  /// @ingroup  Io
+  /// @brief    [\ref Io] Block data staged in memory for deferred output
+  ///
+  /// An OutputStage holds copies of Block metadata, field arrays,
+  /// and particle attribute arrays for one output file, so that
+  /// Blocks can continue computing while the data are written to
+  /// disk later, one Block at a time.  The OutputStage owns the
+  /// File, which is closed and deleted when the OutputStage is
+  /// deleted.
+  ///
+  /// With output_layout_level, arrays are instead appended to
+  /// contiguous per-level datasets as they are staged, and each
+  /// level is written to a group "/level_<L>" containing one dataset
+  /// per field or particle attribute, one "block_<name>" dataset per
+  /// Block metadata item (e.g. block_index, block_lower,
+  /// block_upper), and a "block_offset" table of each Block's
+  /// element offset in each dataset.
+
+public: // interface
+
+  /// Create an OutputStage for writing to the given open File
+  OutputStage(File * file, int layout = output_layout_block) throw();
+
+  /// Write any remaining Blocks, then close and delete the File
+  ~OutputStage() throw();
+
+  /// Begin staging a new Block, written to the given group in the
+  /// "block" layout or appended to the given level in the "level"
+  /// layout
+  void new_block (std::string group_name, int level) throw();
+
+  /// Copy metadata for the current Block
+  void add_meta (const void * buffer, std::string name, int type,
+		 int nx, int ny, int nz) throw();
+
+  /// Allocate a dataset for the current Block, and return the
+  /// address of its nx*ny*nz elements for the caller to fill
+  char * new_data (std::string name, int type,
+		   int nxd, int nyd, int nzd,
+		   int nx,  int ny,  int nz) throw();
+
+  /// Write the next staged Block (or level) to the File, and return
+  /// whether any staged data remain
+  bool write_next() throw();
+
+  /// Write all staged Blocks to the File
+  void write_all() throw()
+  { while (write_next()) ; }
+
+  /// Return whether no Blocks remain to be written
+  bool is_empty() const throw()
+  { return block_list_.empty() && level_map_.empty(); }
+
+  /// Return the output layout
+  int layout() const throw()
+  { return layout_; }
+
+  /// Return the number of bytes of staged array data
+  long long bytes() const throw()
+  { return bytes_; }
+
+private: // classes
+
+  /// Array of staged values with its name, type, and dimensions
+  struct Array {
+    std::string name;
+    int type;
+    int nxd, nyd, nzd;
+    int nx, ny, nz;
+    std::vector<char> values;
+  };
+
+  /// Staged metadata and datasets for a Block
+  struct BlockData {
+    std::string group_name;
+    std::vector<Array> meta_list;
+    std::vector<Array> data_list;
+  };
+
+  /// Array concatenated over all Blocks in a level, with the
+  /// element offset of each Block and whether all Blocks' arrays
+  /// have the same size
+  struct LevelArray {
+    Array array;
+    bool is_uniform;
+    std::vector<long long> offset;
+  };
+
+  /// Staged metadata and datasets for all Blocks in a level
+  struct LevelData {
+    LevelData() : num_blocks(0) {}
+    int num_blocks;
+    std::vector<LevelArray> meta_list;
+    std::vector<LevelArray> data_list;
+  };
+
+private: // functions
+
+  OutputStage (const OutputStage &);
+  OutputStage & operator = (const OutputStage &);
+
+  /// Allocate values for the Array and update the byte count
+  char * allocate_ (Array * array) throw();
+
+  /// Append an array for the current Block to the matching
+  /// LevelArray, and return the address of its values
+  char * append_ (std::vector<LevelArray> * level_list,
+		  std::string name, int type,
+		  int nxd, int nyd, int nzd,
+		  int nx,  int ny,  int nz) throw();
+
+  /// Write all staged data for the first level
+  void write_level_ () throw();
+
+  /// Write a LevelArray with the given name, and the given column
+  /// in the "block_offset" table if not negative
+  void write_level_array_ (const LevelArray & level_array,
+			   std::string name, int num_blocks,
+			   int column) throw();
+
+private: // attributes
+
+  /// File to write staged Blocks to
+  File * file_;
+
+  /// Layout of Block data in the File
+  int layout_;
+
+  /// Blocks staged but not yet written with output_layout_block
+  std::list<BlockData> block_list_;
+
+  /// Levels staged but not yet written with output_layout_level
+  std::map<int,LevelData> level_map_;
+
+  /// Level of the current Block with output_layout_level
+  int level_;
+
+  /// Number of bytes of staged array values
+  long long bytes_;
+
+};
+
+#endif /* IO_OUTPUT_STAGE_HPP */
@@ -186,8 +186,8 @@ void Main::p_text_file_write
     sync_text->set_stop(CkNumPes());
   }
 
-  // First call from any Block on a processor includes count
-  // minus one for CkNumPes() above
+  // Each process sends one call, which may contain many lines, or
+  // count calls if count > 0, including the one counted above
   if (count > 0) {
     sync_text->inc_stop(count-1);
   }
@@ -0,0 +1,20 @@
+// See LICENSE_CELLO file for license and copyright information
+
+/// @file     memory_Pool.cpp
+/// @author   James Bordner (jobordner@ucsd.edu)
+/// @date     2020-03-23
+/// @brief    Implementation of the Pool class
+
+#include "memory.hpp"
+
+//----------------------------------------------------------------------
+
+Pool::~Pool() throw()
+{
+  for (int i=0; i<CONFIG_NODE_SIZE; i++) {
+    for (size_t k=0; k<free_list_[i].size(); k++) {
+      ::operator delete (free_list_[i][k]);
+    }
+    free_list_[i].clear();
+  }
+}
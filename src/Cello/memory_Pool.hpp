@@ -0,0 +1,116 @@
+// See LICENSE_CELLO file for license and copyright information
+
+/// @file     memory_Pool.hpp
+/// @author   James Bordner (jobordner@ucsd.edu)
+/// @date     2020-03-23
+/// @brief    [\ref Memory] Declaration of the Pool class
+
+#ifndef MEMORY_POOL_HPP
+#define MEMORY_POOL_HPP
+
+class Pool {
+
+  /// @class    Pool
+  /// @ingroup  Memory
+  /// @brief    [\ref Memory] Free lists of fixed-size objects
+  ///
+  /// A Pool keeps a free list of released objects for each process
+  /// (or thread in SMP mode), so that small objects that are created
+  /// and deleted frequently, such as DataMsg and FieldFace, can be
+  /// reused without calling the heap allocator.  Classes use a Pool
+  /// by defining their own operator new and operator delete:
+  ///
+  ///    static void * operator new (size_t bytes)
+  ///    { return pool.allocate(bytes); }
+  ///    static void operator delete (void * pointer)
+  ///    { pool.deallocate(pointer); }
+  ///
+  /// An object may be deallocated by a different thread than the one
+  /// that allocated it, in which case it is added to the free list of
+  /// the deallocating thread.  Free lists are limited to
+  /// max_free_list objects.
+
+public: // interface
+
+  /// Create a Pool for objects of the given size
+  Pool (size_t object_size, int max_free_list = 1024) throw()
+    : object_size_(object_size),
+      max_free_list_(max_free_list)
+  {
+    for (int i=0; i<CONFIG_NODE_SIZE; i++) {
+      num_hits_[i]   = 0;
+      num_misses_[i] = 0;
+    }
+  }
+
+  /// Destructor
+  ~Pool() throw();
+
+  /// Return memory for an object, from the free list if possible
+  void * allocate (size_t bytes) throw ()
+  {
+    const int in = cello::index_static();
+    std::vector<void *> & free_list = free_list_[in];
+    if (bytes == object_size_ && ! free_list.empty()) {
+      void * pointer = free_list.back();
+      free_list.pop_back();
+      ++num_hits_[in];
+      return pointer;
+    } else {
+      ++num_misses_[in];
+      return ::operator new (std::max(bytes,object_size_));
+    }
+  }
+
+  /// Return memory for an object to the free list
+  void deallocate (void * pointer) throw ()
+  {
+    if (pointer == NULL) return;
+    std::vector<void *> & free_list = free_list_[cello::index_static()];
+    if (int(free_list.size()) < max_free_list_) {
+      free_list.push_back(pointer);
+    } else {
+      ::operator delete (pointer);
+    }
+  }
+
+  /// Return the number of allocations from the free list
+  long num_hits (int in) const throw ()
+  { return num_hits_[in]; }
+
+  /// Return the number of allocations from the heap
+  long num_misses (int in) const throw ()
+  { return num_misses_[in]; }
+
+  /// Reset the hit and miss counters
+  void reset_counters (int in) throw ()
+  {
+    num_hits_[in]   = 0;
+    num_misses_[in] = 0;
+  }
+
+private: // functions
+
+  Pool (const Pool &);
+  Pool & operator = (const Pool &);
+
+private: // attributes
+
+  /// Size of objects in bytes
+  size_t object_size_;
+
+  /// Maximum length of each free list
+  int max_free_list_;
+
+  /// Free lists for each process (or thread in SMP mode)
+  std::vector<void *> free_list_[CONFIG_NODE_SIZE];
+
+  /// Number of allocations from the free list
+  long num_hits_[CONFIG_NODE_SIZE];
+
+  /// Number of allocations from the heap
+  long num_misses_[CONFIG_NODE_SIZE];
+
+};
+
+#endif /* MEMORY_POOL_HPP */
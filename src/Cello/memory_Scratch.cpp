@@ -0,0 +1,110 @@
+// See LICENSE_CELLO file for license and copyright information
+
+/// @file     memory_Scratch.cpp
+/// @author   James Bordner (jobordner@ucsd.edu)
+/// @date     2020-03-16
+/// @brief    Implementation of the Scratch memory arena
+
+#include "memory.hpp"
+
+Scratch Scratch::instance_[CONFIG_NODE_SIZE];
+
+//----------------------------------------------------------------------
+
+void * Scratch::allocate_bytes_ (size_t bytes) throw ()
+{
+  // round up to keep arrays aligned
+
+  bytes = (bytes + alignment - 1) / alignment * alignment;
+
+  // skip to the next chunk (allocating it if needed) if the array
+  // does not fit in the current one
+
+  while (index_chunk_ >= chunk_list_.size() ||
+	 offset_ + bytes > chunk_size_[index_chunk_]) {
+
+    if (index_chunk_ < chunk_list_.size()) {
+      position_ += chunk_size_[index_chunk_] - offset_;
+      ++ index_chunk_;
+      offset_ = 0;
+    }
+
+    if (index_chunk_ == chunk_list_.size()) {
+      allocate_chunk_ (std::max(std::max(bytes,capacity_),
+				size_t(chunk_size_min)));
+    }
+  }
+
+  char * array = align_(chunk_list_[index_chunk_]) + offset_;
+
+  offset_   += bytes;
+  position_ += bytes;
+  position_high_ = std::max(position_high_,position_);
+
+  return array;
+}
+
+//----------------------------------------------------------------------
+
+void Scratch::release (size_t mark) throw ()
+{
+  ASSERT2 ("Scratch::release()",
+	   "Releasing to position %ld beyond current position %ld",
+	   long(mark),long(position_),
+	   mark <= position_);
+
+  // find the chunk containing the mark
+
+  size_t position_chunk = 0;
+  size_t index_chunk = 0;
+  while (index_chunk < chunk_list_.size() &&
+	 position_chunk + chunk_size_[index_chunk] < mark) {
+    position_chunk += chunk_size_[index_chunk];
+    ++ index_chunk;
+  }
+
+  index_chunk_ = index_chunk;
+  offset_      = mark - position_chunk;
+  position_    = mark;
+
+  // combine chunks into one of the high-water size when empty, so
+  // that later use requires no heap allocation
+
+  if (position_ == 0 && chunk_list_.size() > 1) {
+    const size_t bytes = position_high_;
+    deallocate_();
+    allocate_chunk_(bytes);
+  }
+}
+
+//----------------------------------------------------------------------
+
+void Scratch::allocate_chunk_ (size_t bytes) throw ()
+{
+  // (...allocate extra to align the start of the chunk)
+  char * chunk = (char *) malloc (bytes + alignment);
+
+  ASSERT1 ("Scratch::allocate_chunk_()",
+	   "Failed to allocate %ld bytes",
+	   long(bytes), chunk != NULL);
+
+  chunk_list_.push_back(chunk);
+  chunk_size_.push_back(bytes);
+  capacity_ += bytes;
+  ++ num_heap_allocations_;
+}
+
+//----------------------------------------------------------------------
+
+void Scratch::deallocate_ () throw ()
+{
+  for (size_t i=0; i<chunk_list_.size(); i++) {
+    free (chunk_list_[i]);
+  }
+  chunk_list_.clear();
+  chunk_size_.clear();
+  index_chunk_ = 0;
+  offset_      = 0;
+  position_    = 0;
+  capacity_    = 0;
+}
@@ -0,0 +1,146 @@
+// See LICENSE_CELLO file for license and copyright information
+
+/// @file     memory_Scratch.hpp
+/// @author   James Bordner (jobordner@ucsd.edu)
+/// @date     2020-03-16
+/// @brief    [\ref Memory] Declaration of the Scratch class
+
+#ifndef MEMORY_SCRATCH_HPP
+#define MEMORY_SCRATCH_HPP
+
+class Scratch {
+
+  /// @class    Scratch
+  /// @ingroup  Memory
+  /// @brief    [\ref Memory] Reusable per-process scratch memory arena
+  ///
+  /// Compute kernels borrow temporary arrays from the Scratch arena
+  /// of the calling process (or thread in SMP mode) instead of
+  /// allocating them on each call.  Arrays are allocated in
+  /// stack order between mark() and release(mark).  When the arena
+  /// overflows a new chunk is allocated, and when all arrays are
+  /// released the chunks are combined into a single chunk of the
+  /// high-water size, so that in steady state no heap allocation
+  /// is performed.
+  ///
+  ///    Scratch * scratch = Scratch::instance();
+  ///    const size_t mark = scratch->mark();
+  ///    double * a = scratch->allocate<double>(n);
+  ///    ...
+  ///    scratch->release(mark);
+
+public: // interface
+
+  /// Return the Scratch arena for this process
+  static Scratch * instance() throw ()
+  { return & instance_[cello::index_static()]; }
+
+  /// Destructor
+  ~Scratch() throw ()
+  { deallocate_(); }
+
+  /// Return the current position, for release()
+  size_t mark() const throw ()
+  { return position_; }
+
+  /// Allocate an uninitialized array of n elements of type T
+  template <class T>
+  T * allocate (size_t n) throw ()
+  { return (T *) allocate_bytes_ (n*sizeof(T)); }
+
+  /// Allocate an array of n elements of type T initialized to value
+  template <class T>
+  T * allocate (size_t n, T value) throw ()
+  {
+    T * array = allocate<T>(n);
+    for (size_t i=0; i<n; i++) array[i] = value;
+    return array;
+  }
+
+  /// Release all arrays allocated since the given mark()
+  void release (size_t mark) throw ();
+
+  /// Return the number of bytes currently allocated for the arena
+  size_t bytes_capacity() const throw ()
+  { return capacity_; }
+
+  /// Return the maximum number of bytes in use at one time
+  size_t bytes_high() const throw ()
+  { return position_high_; }
+
+  /// Return the number of heap allocations performed by the arena
+  long num_heap_allocations() const throw ()
+  { return num_heap_allocations_; }
+
+private: // functions
+
+  /// Create the Scratch object (see instance())
+  Scratch() throw ()
+    : chunk_list_(),
+      chunk_size_(),
+      index_chunk_(0),
+      offset_(0),
+      position_(0),
+      position_high_(0),
+      capacity_(0),
+      num_heap_allocations_(0)
+  { }
+
+  Scratch (const Scratch &);
+  Scratch & operator = (const Scratch &);
+
+  /// Allocate the given number of bytes, aligned to a cache line
+  void * allocate_bytes_ (size_t bytes) throw ();
+
+  /// Allocate a new chunk of at least the given size
+  void allocate_chunk_ (size_t bytes) throw ();
+
+  /// Deallocate all chunks
+  void deallocate_ () throw ();
+
+  /// Return the first aligned address in the given chunk
+  static char * align_ (char * chunk) throw ()
+  {
+    const size_t a = alignment;
+    return (char *)((((size_t)chunk) + a - 1) / a * a);
+  }
+
+private: // attributes
+
+  /// Alignment of allocated arrays in bytes
+  enum { alignment = 64 };
+
+  /// Minimum size of a chunk in bytes
+  enum { chunk_size_min = 1 << 20 };
+
+  /// Scratch objects for each process (or thread in SMP mode)
+  static Scratch instance_[CONFIG_NODE_SIZE];
+
+  /// Chunks of memory, used in order
+  std::vector<char *> chunk_list_;
+
+  /// Size of each chunk in bytes
+  std::vector<size_t> chunk_size_;
+
+  /// Index of the chunk currently being allocated from
+  size_t index_chunk_;
+
+  /// Offset of the next free byte in the current chunk
+  size_t offset_;
+
+  /// Position of the next free byte: sizes of preceding chunks plus
+  /// the offset in the current chunk
+  size_t position_;
+
+  /// Maximum position reached
+  size_t position_high_;
+
+  /// Total size of all chunks in bytes
+  size_t capacity_;
+
+  /// Number of chunks allocated from the heap
+  long num_heap_allocations_;
+
+};
+
+#endif /* MEMORY_SCRATCH_HPP */
@@ -75,10 +75,26 @@ Block::Block ( MsgRefine * msg )
   is_leaf_(true),
   age_(0),
   face_level_last_(),
+  adapt_round_(0),
+  adapt_round_max_(-1),
+  adapt_round_count_(),
+  adapt_round_changed_(false),
+  adapt_ack_count_(0),
   name_(""),
   index_method_(-1),
   index_solver_(),
-  refresh_()
+  refresh_(),
+  refresh_plan_list_(),
+  refresh_plan_face_level_(),
+  refresh_plan_child_face_level_(),
+  refresh_plan_is_leaf_(true),
+  balance_time_(0.0),
+  balance_time_start_(-1.0),
+  balance_region_(perf_unknown),
+  balance_cycle_(0),
+  subcycle_cycle_(0),
+  subcycle_level_min_(0),
+  subcycle_level_max_(0)
 {
   performance_start_(perf_block);
   usesAtSync = true;
@@ -142,10 +158,26 @@ Block::Block ( process_type ip_source )
   is_leaf_(true),
   age_(0),
   face_level_last_(),
+  adapt_round_(0),
+  adapt_round_max_(-1),
+  adapt_round_count_(),
+  adapt_round_changed_(false),
+  adapt_ack_count_(0),
   name_(""),
   index_method_(-1),
   index_solver_(),
-  refresh_()
+  refresh_(),
+  refresh_plan_list_(),
+  refresh_plan_face_level_(),
+  refresh_plan_child_face_level_(),
+  refresh_plan_is_leaf_(true),
+  balance_time_(0.0),
+  balance_time_start_(-1.0),
+  balance_region_(perf_unknown),
+  balance_cycle_(0),
+  subcycle_cycle_(0),
+  subcycle_level_min_(0),
+  subcycle_level_max_(0)
 {
   usesAtSync = true;
 #ifdef TRACE_BLOCK
@@ -218,6 +250,8 @@ void Block::init
 {
   index_ = index;
   cycle_ = cycle;
+  balance_cycle_ = cycle;
+  subcycle_cycle_ = cycle;
   time_ = time;
   dt_ = dt;
   adapt_step_ = num_adapt_steps;
@@ -339,7 +373,11 @@ void Block::init
 
   if (level > 0) {
 
-    control_sync_quiescence (CkIndex_Main::p_adapt_end());
+    // Tell parent this Block has been created, and end the adapt step
+
+    thisProxy[index_.index_parent()].p_adapt_child_ready();
+
+    adapt_end_();
 
   }
 
@@ -413,11 +451,21 @@ void Block::pup(PUP::er &p)
   p | is_leaf_;
   p | age_;
   p | face_level_last_;
+  p | adapt_round_;
+  p | adapt_round_max_;
+  PUParray(p,adapt_round_count_,2);
+  p | adapt_round_changed_;
+  p | adapt_ack_count_;
   p | name_;
   p | index_method_;
   p | index_solver_;
   p | refresh_;
   // SKIP method_: initialized when needed
+  p | balance_time_;
+  p | balance_cycle_;
+  p | subcycle_cycle_;
+  p | subcycle_level_min_;
+  p | subcycle_level_max_;
 
   if (up) DEBUG_FACES("PUP");
 
@@ -660,6 +708,8 @@ Block::~Block()
   delete child_data_;
   child_data_ = 0;
 
+  refresh_plan_clear_();
+
   if (simulation) simulation->data_delete_block(this);
 
 }
@@ -719,10 +769,26 @@ Block::Block (CkMigrateMessage *m)
     is_leaf_(true),
     age_(0),
     face_level_last_(),
+    adapt_round_(0),
+    adapt_round_max_(-1),
+    adapt_round_count_(),
+    adapt_round_changed_(false),
+    adapt_ack_count_(0),
     name_(""),
     index_method_(-1),
     index_solver_(),
-    refresh_()
+    refresh_(),
+    refresh_plan_list_(),
+    refresh_plan_face_level_(),
+    refresh_plan_child_face_level_(),
+    refresh_plan_is_leaf_(true),
+  balance_time_(0.0),
+  balance_time_start_(-1.0),
+  balance_region_(perf_unknown),
+  balance_cycle_(0),
+  subcycle_cycle_(0),
+  subcycle_level_min_(0),
+  subcycle_level_max_(0)
 {
   
 #ifdef TRACE_BLOCK
@@ -1029,6 +1095,10 @@ void Block::performance_start_
   Simulation * simulation = cello::simulation();
   if (simulation)
     simulation->performance()->start_region(index_region,file,line);
+  if (balance_time_start_ < 0.0 && is_balance_region_(index_region)) {
+    balance_time_start_ = CkWallTimer();
+    balance_region_ = index_region;
+  }
 }
 
 //----------------------------------------------------------------------
@@ -1039,6 +1109,10 @@ void Block::performance_stop_
   Simulation * simulation = cello::simulation();
   if (simulation)
     simulation->performance()->stop_region(index_region,file,line);
+  if (balance_time_start_ >= 0.0 && index_region == balance_region_) {
+    balance_time_ += CkWallTimer() - balance_time_start_;
+    balance_time_start_ = -1.0;
+  }
 }
 
 //----------------------------------------------------------------------
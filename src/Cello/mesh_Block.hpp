@@ -18,6 +18,7 @@
 #endif
 
 class Data;
+class DataMsg;
 class MsgRefresh;
 class MsgRefine;
 class MsgCoarsen;
@@ -30,6 +31,7 @@ class Method;
 class Particle;
 class ParticleData;
 class Refresh;
+class RefreshPlan;
 class Solver;
 
 //----------------------------------------------------------------------
@@ -112,10 +114,26 @@ public: // interface
     is_leaf_(true),
     age_(0),
     face_level_last_(),
+    adapt_round_(0),
+    adapt_round_max_(-1),
+    adapt_round_count_(),
+    adapt_round_changed_(false),
+    adapt_ack_count_(0),
     name_(""),
     index_method_(-1),
     index_solver_(),
-    refresh_()
+    refresh_(),
+    refresh_plan_list_(),
+    refresh_plan_face_level_(),
+    refresh_plan_child_face_level_(),
+    refresh_plan_is_leaf_(true),
+    balance_time_(0.0),
+    balance_time_start_(-1.0),
+    balance_region_(perf_unknown),
+    balance_cycle_(0),
+    subcycle_cycle_(0),
+    subcycle_level_min_(0),
+    subcycle_level_max_(0)
   {
     for (int i=0; i<3; i++) array_[i]=0;
   }
@@ -440,8 +458,12 @@ public:
   void r_adapt_next (CkReductionMsg * msg)
   {
     performance_start_(perf_adapt_update);
+    // (...exchange levels again if any Block's level changed in the
+    // last round)
+    const bool is_changed = *((int *)msg->getData());
     delete msg;    
-    adapt_next_();
+    if (is_changed) adapt_called_();
+    else            adapt_next_();
     performance_stop_(perf_adapt_update);
     performance_start_(perf_adapt_update_sync);
   }
@@ -473,7 +495,7 @@ public:
   {
     performance_start_(perf_adapt_end);
     delete msg;    
-    adapt_end_();
+    adapt_done_();
     performance_stop_(perf_adapt_end);
     performance_start_(perf_adapt_end_sync);
   }
@@ -497,8 +519,13 @@ public:
 
   /// Parent tells child to delete itself
   void p_adapt_delete();
+
+  /// New child tells parent it has been created
+  void p_adapt_child_ready();
+
   void p_adapt_recv_level 
   (Index index_debug, 
+   int round,
    int ic3[3], 
    int if3[3],
    int level_now, int level_new);
@@ -508,7 +535,9 @@ public:
   void adapt_recv (const int of3[3], const int ic3[3],
 		   int level_face_new, int level_relative);
 
-  void adapt_send_level();
+  /// Send desired level to neighbors and return the number of
+  /// messages sent
+  int adapt_send_level();
 
 protected:
   bool do_adapt_();
@@ -516,7 +545,10 @@ protected:
   void adapt_begin_ ();
   void adapt_next_ ();
   void adapt_end_ ();
+  void adapt_done_ ();
   void adapt_exit_();
+  void adapt_check_round_();
+  void adapt_check_ack_();
   void adapt_coarsen_();
   void adapt_refine_();
   void adapt_called_();
@@ -596,6 +628,10 @@ public:
 
   void p_refresh_store (MsgRefresh * msg);
 
+  /// Store a face packed by DataMsg::save_data() in an aggregated
+  /// message, called directly by Simulation::p_refresh_store_list()
+  void refresh_store_packed (char * buffer);
+
   /// Get restricted data from child when it is deleted
   void p_refresh_child (int n, char a[],int ic3[3]);
 
@@ -612,8 +648,30 @@ protected:
   /// Scatter particles in ghost zones to neighbors
   int refresh_load_particle_faces_ (Refresh * refresh);
 
+  /// Copy the given face directly to a neighbor on this process,
+  /// else pack it and send it or add it to face_list if remote
   void refresh_load_field_face_
-  (int refresh_type, Index index, int if3[3], int ic3[3]);
+  (Index index, FieldFace * field_face,
+   std::map<int, std::vector< std::pair<Index,DataMsg *> > > & face_list);
+
+  /// Return the cached RefreshPlan for refresh, building if needed
+  RefreshPlan * refresh_plan_ (Refresh * refresh);
+
+  /// Create the FieldFace for the given neighbor face
+  FieldFace * refresh_create_field_face_
+  (int refresh_type, int if3[3], int ic3[3], Refresh * refresh);
+
+  /// Delete all cached RefreshPlans
+  void refresh_plan_clear_ ();
+
+  /// Whether face levels or leaf status changed since RefreshPlans
+  /// were last cleared
+  bool refresh_plan_changed_ () const;
+
+  /// Send remote faces, aggregating faces bound for the same process
+  void refresh_send_field_faces_
+  (std::map<int, std::vector< std::pair<Index,DataMsg *> > > & face_list);
+
   void refresh_load_particle_face_
   (int refresh_type, Index index, int if3[3], int ic3[3]);
 
@@ -621,14 +679,14 @@ protected:
   // PARTICLES
   //--------------------------------------------------
 
-  /// Create ParticleData objects for particle_array[] (with possibly
-  /// duplicated pointers) and particle_list[] (with unique
-  /// ParticleData objects) Also calls
-  /// particle_determine_periodic_update_
+  /// Fill index_list[] with the neighbor indices, and
+  /// neighbor_array[] with the index_list[] element of the neighbor
+  /// overlapping each 4x4x4 particle array element (-1 if none).
+  /// Returns the number of neighbors
   int particle_create_array_neighbors_
   (Refresh * refresh,
-   ParticleData * particle_array[],
-   ParticleData * particle_list[],
+   int npa,
+   int neighbor_array[],
    Index index_list[]);
 
   /// Computes updates to positions (dpx[i],dpy[i],dpz[i]) for faces that
@@ -639,11 +697,20 @@ protected:
   ( int nl, ParticleData * particle_list[], Refresh * refresh);
 
   /// Scatter particles of given types in type_list, to appropriate
-  /// particle_array ParticleData elements
+  /// particle_array ParticleData elements.  ParticleData objects
+  /// are created in particle_list[] (and particle_array[]) only for
+  /// neighbors that receive particles
   void particle_scatter_neighbors_
   (int npa, ParticleData * particle_array[],
+   ParticleData * particle_list[],
+   const int neighbor_array[],
    std::vector<int> & type_list, Particle particle_src);
 
+  /// Report the first particle outside the 4x4x4 neighbor array and exit
+  void particle_scatter_error_
+  (int np, const double * xa, const double * ya, const double * za,
+   bool is_float);
+
   /// Scatter particles to appropriate partictle_list elements
   void particle_scatter_children_ (ParticleData * particle_list[],
 				   Particle particle_src);
@@ -685,6 +752,14 @@ public:
   /// Quiescence before load balancing
   void p_stopping_balance();
 
+  /// Migrate to the given process as determined by the cost-model
+  /// load balancer
+  void p_balance_migrate(int ip);
+
+  /// Exit the cost-model load balancer once all migrations have
+  /// completed
+  void p_balance_exit();
+
   /// Exit the stopping phase
   void p_stopping_exit () 
   {
@@ -706,6 +781,25 @@ protected:
   void stopping_balance_();
   void stopping_exit_();
 
+  /// Send this Block's measured cost to the cost-model load balancer
+  void balance_cost_enter_();
+
+  /// Number of cycles per time step of Blocks in the given level when
+  /// Method:subcycle is enabled
+  int subcycle_stride_ (int level) const;
+
+  /// Whether this Block advances in time this cycle: always true
+  /// unless Method:subcycle is enabled
+  bool subcycle_is_step_ () const;
+
+  /// Whether all levels are at the same time this cycle: always true
+  /// unless Method:subcycle is enabled
+  bool subcycle_is_synchronized_ () const;
+
+  /// Weight of current relative to previous field values for
+  /// interpolating this Block's values in time for finer neighbors
+  double subcycle_time_weight_ () const;
+
 public:
   /// Exit the stopping phase to exit
   void p_exit () 
@@ -736,6 +830,16 @@ protected:
   void performance_stop_
   (int index_region, std::string file="", int line=0);
 
+  /// Whether the Performance region contributes to the Block's
+  /// measured cost for cost-model load balancing
+  bool is_balance_region_ (int index_region) const
+  {
+    return (index_region == perf_compute ||
+	    index_region == perf_refresh_store ||
+	    index_region == perf_refresh_child ||
+	    index_region == perf_refresh_exit);
+  }
+
   //--------------------------------------------------
   // TESTING
   //--------------------------------------------------
@@ -986,6 +1090,24 @@ protected: // attributes
   /// Last face level received from given face
   std::vector<int> face_level_last_;
 
+  /// Current round of exchanging desired levels with neighbors
+  int adapt_round_;
+
+  /// Number of level messages expected from neighbors each round, or
+  /// -1 if not currently exchanging levels
+  int adapt_round_max_;
+
+  /// Number of level messages received from neighbors, indexed by
+  /// round parity since neighbors may be one round ahead
+  int adapt_round_count_[2];
+
+  /// Whether level_next_ changed during the current round
+  bool adapt_round_changed_;
+
+  /// Number of child (refine) or parent (coarsen) acknowledgments
+  /// remaining before the Block can end the adapt step
+  int adapt_ack_count_;
+
   /// String for storing bit ID name
   mutable std::string name_;
 
@@ -999,6 +1121,37 @@ protected: // attributes
   /// (Not a pointer since must be one per Block for synchronization counters)
   std::vector<Refresh*> refresh_;
 
+  /// Cached neighbor faces for each Refresh, indexed by sync_id (not
+  /// pup'ed: rebuilt as needed after migration)
+  std::vector<RefreshPlan *> refresh_plan_list_;
+
+  /// Face levels and leaf status when refresh_plan_list_ was last
+  /// cleared, used in adapt_end_() to detect when plans are invalid
+  std::vector<int> refresh_plan_face_level_;
+  std::vector<int> refresh_plan_child_face_level_;
+  bool refresh_plan_is_leaf_;
+
+  /// Wall-clock time spent in compute and refresh regions since the
+  /// last cost-model load balancing step
+  double balance_time_;
+
+  /// Start time and region of the current balance_time_ interval, or
+  /// -1.0 if none is active (not pup'ed)
+  double balance_time_start_;
+  int balance_region_;
+
+  /// Cycle at which balance_time_ measurement began
+  int balance_cycle_;
+
+  /// Cycle at which all levels were last synchronized in time when
+  /// Method:subcycle is enabled
+  int subcycle_cycle_;
+
+  /// Coarsest and finest (non-negative) levels in the mesh when the
+  /// level time steps were last computed
+  int subcycle_level_min_;
+  int subcycle_level_max_;
+
 };
 
 #endif /* COMM_BLOCK_HPP */
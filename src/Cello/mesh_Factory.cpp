@@ -65,15 +65,30 @@ CProxy_Block Factory::new_block_proxy
 
   CProxy_Block proxy_block;
 
-  CProxy_MappingArray array_map  = CProxy_MappingArray::ckNew(nbx,nby,nbz);
-
   CkArrayOptions opts;
-  opts.setMap(array_map);
+  opts.setMap(new_block_map(nbx,nby,nbz));
   proxy_block = CProxy_Block::ckNew(opts);
 
   return proxy_block;
 }
 
+//----------------------------------------------------------------------
+
+CkGroupID Factory::new_block_map (int nbx, int nby, int nbz) const throw()
+{
+  const std::string mapping = cello::config()->balance_mapping;
+
+  if (mapping == "morton") {
+    return CProxy_MappingTree::ckNew
+      (nbx,nby,nbz,cello::rank(),mapping_curve_morton);
+  } else if (mapping == "hilbert") {
+    return CProxy_MappingTree::ckNew
+      (nbx,nby,nbz,cello::rank(),mapping_curve_hilbert);
+  } else {
+    return CProxy_MappingArray::ckNew(nbx,nby,nbz);
+  }
+}
+
 //----------------------------------------------------------------------
   
 void Factory::create_block_array
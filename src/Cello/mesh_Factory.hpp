@@ -58,6 +58,10 @@ public: // interface
    DataMsg * data_msg,
    int nbx, int nby, int nbz) const throw();
 
+  /// Create the CHARM++ array map for a Block array given the root
+  /// array size, as determined by the Balance:mapping parameter
+  CkGroupID new_block_map (int nbx, int nby, int nbz) const throw();
+
   /// Create a new CHARM++ Block array
   virtual void create_block_array
   (
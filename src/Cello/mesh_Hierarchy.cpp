@@ -183,6 +183,39 @@ void Hierarchy::deallocate_blocks() throw()
 
 //----------------------------------------------------------------------
 
+void Hierarchy::insert_block (Block * block)
+{
+  block_map_[block->index()] = block_vec_.size();
+  block_vec_.push_back(block);
+}
+
+//----------------------------------------------------------------------
+
+bool Hierarchy::delete_block (Block * block)
+{
+  auto it = block_map_.find(block->index());
+
+  if (it == block_map_.end() || block_vec_[it->second] != block)
+    return false;
+
+  // move the last Block into the deleted Block's slot
+
+  const int i = it->second;
+  block_map_.erase(it);
+
+  Block * block_last = block_vec_.back();
+  block_vec_.pop_back();
+
+  if (block_last != block) {
+    block_vec_[i] = block_last;
+    block_map_[block_last->index()] = i;
+  }
+
+  return true;
+}
+
+//----------------------------------------------------------------------
+
 CProxy_Block Hierarchy::new_block_proxy ( bool allocate_data) throw()
 {
   TRACE("Creating block_array_");
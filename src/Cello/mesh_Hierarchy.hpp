@@ -31,6 +31,7 @@ public: // interface
     num_blocks_(0),
     num_blocks_level_(),
     block_vec_(),
+    block_map_(),
     num_particles_(0), 
     num_zones_total_(0), 
     num_zones_real_(0), 
@@ -134,23 +135,20 @@ public: // interface
   }
 
   /// Add Block to the list of blocks (block_vec_ and block_map_)
-  void insert_block (Block * block)
-  {
-    block_vec_.push_back(block);
-  }
-  
-  /// Remove Block from the list of blocks (block_vec_) and return
-  /// true iff Block is found in the list
-  bool delete_block (Block * block)
+  void insert_block (Block * block);
+
+  /// Remove Block from the list of blocks (block_vec_ and
+  /// block_map_) and return true iff Block is found in the list.
+  /// The last Block is moved into the removed Block's slot, so the
+  /// order of blocks in block_vec_ is not preserved.
+  bool delete_block (Block * block);
+
+  /// Return the Block with the given Index if it is on this process,
+  /// otherwise NULL
+  Block * find_block (const Index & index) const
   {
-    const int n = block_vec_.size();
-    bool found = false;
-    for (int i=0; i<n; i++) {
-      if (found) block_vec_[i-1] = block_vec_[i];
-      if (block_vec_[i] == block) found=true;
-    }
-    if (found) block_vec_.resize(n-1);
-    return found;
+    auto it = block_map_.find(index);
+    return (it == block_map_.end()) ? NULL : block_vec_[it->second];
   }
   
   /// Increment (decrement) number of particles
@@ -227,6 +225,9 @@ protected: // attributes
   /// Pointers to Blocks on this process
   std::vector<Block *> block_vec_;
 
+  /// Position in block_vec_ of each Block on this process
+  std::unordered_map<Index,int,Index::Hash> block_map_;
+
   /// Current number of particles on this process
   int64_t num_particles_;
 
@@ -152,6 +152,17 @@ public:
 
   std::string bit_string (int max_level,int rank, const int nb3[3]) const;
 
+  /// Hash function object for unordered containers of Index
+  struct Hash {
+    size_t operator () (const Index & index) const
+    {
+      size_t h = (unsigned) index.v_[0];
+      h = h*0x9E3779B1u + (unsigned) index.v_[1];
+      h = h*0x9E3779B1u + (unsigned) index.v_[2];
+      return h ^ (h >> 16);
+    }
+  };
+
   /// Comparison operator required for Charm++ pup()
   friend bool operator < (const Index & x, const Index & y) {
     if (x.v_[2] < y.v_[2]) return true;
@@ -0,0 +1,61 @@
+// See LICENSE_CELLO file for license and copyright information
+
+/// @file     mesh_RefreshPlan.cpp
+/// @author   James Bordner (jobordner@ucsd.edu)
+/// @date     2020-03-02
+/// @brief    [\ref Mesh] Implementation of the RefreshPlan class
+
+#include "mesh.hpp"
+
+//----------------------------------------------------------------------
+
+RefreshPlan::RefreshPlan(Refresh * refresh) throw()
+  : min_face_rank_(refresh->min_face_rank()),
+    neighbor_type_(refresh->neighbor_type()),
+    root_level_(refresh->root_level()),
+    all_fields_(refresh->all_fields()),
+    field_list_src_(refresh->field_list_src()),
+    field_list_dst_(refresh->field_list_dst()),
+    ghost_depth_(refresh->ghost_depth()),
+    accumulate_(refresh->accumulate()),
+    index_list_(),
+    face_list_()
+{
+}
+
+//----------------------------------------------------------------------
+
+RefreshPlan::~RefreshPlan() throw()
+{
+  for (size_t i=0; i<face_list_.size(); i++) {
+    delete face_list_[i];
+    face_list_[i] = NULL;
+  }
+}
+
+//----------------------------------------------------------------------
+
+bool RefreshPlan::matches (Refresh * refresh) const
+{
+  return (min_face_rank_ == refresh->min_face_rank() &&
+	  neighbor_type_ == refresh->neighbor_type() &&
+	  root_level_    == refresh->root_level() &&
+	  all_fields_    == refresh->all_fields() &&
+	  ghost_depth_   == refresh->ghost_depth() &&
+	  accumulate_    == refresh->accumulate() &&
+	  field_list_src_ == refresh->field_list_src() &&
+	  field_list_dst_ == refresh->field_list_dst());
+}
+
+//----------------------------------------------------------------------
+
+FieldFace * RefreshPlan::field_face (int i, Refresh * refresh)
+{
+  // Refresh objects are copied per refresh by Block::set_refresh(),
+  // so update the FieldFace's (non-owning) pointer before use.  The
+  // plan only matches() Refresh objects with the same fields, so the
+  // FieldFace keeps its cached array size
+  FieldFace * field_face = face_list_[i];
+  field_face->update_refresh(refresh);
+  return field_face;
+}
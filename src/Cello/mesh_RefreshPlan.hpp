@@ -0,0 +1,82 @@
+// See LICENSE_CELLO file for license and copyright information
+
+/// @file     mesh_RefreshPlan.hpp
+/// @author   James Bordner (jobordner@ucsd.edu)
+/// @date     2020-03-02
+/// @brief    [\ref Mesh] Declaration of the RefreshPlan class
+///
+
+#ifndef MESH_REFRESH_PLAN_HPP
+#define MESH_REFRESH_PLAN_HPP
+
+class FieldFace;
+class Refresh;
+
+class RefreshPlan {
+
+  /// @class    RefreshPlan
+  /// @ingroup  Mesh
+  /// @brief [\ref Mesh] Cached list of a Block's neighbor faces for a
+  /// given Refresh, avoiding repeated neighbor iteration and FieldFace
+  /// creation between mesh adaptations.  Not pup'ed: rebuilt after
+  /// migration
+
+public: // interface
+
+  /// Constructor for the given Refresh
+  RefreshPlan(Refresh * refresh) throw();
+
+  /// Destructor: deletes the FieldFace objects
+  ~RefreshPlan() throw();
+
+  /// Whether the plan was built for a Refresh with the same
+  /// neighbors, fields, ghost depth and accumulate flag
+  bool matches (Refresh * refresh) const;
+
+  /// Append a neighbor face, taking ownership of field_face
+  void add_face (Index index, FieldFace * field_face)
+  {
+    index_list_.push_back(index);
+    face_list_.push_back(field_face);
+  }
+
+  /// Number of neighbor faces
+  int num_faces () const
+  { return index_list_.size(); }
+
+  /// Index of the i'th neighbor Block
+  Index index (int i) const
+  { return index_list_[i]; }
+
+  /// FieldFace for the i'th neighbor, with Refresh set to refresh
+  FieldFace * field_face (int i, Refresh * refresh);
+
+private: // functions
+
+  /// Not copyable since FieldFace objects are owned
+  RefreshPlan(const RefreshPlan & refresh_plan);
+  RefreshPlan & operator= (const RefreshPlan & refresh_plan);
+
+private: // attributes
+
+  /// Refresh parameters determining the set of neighbors
+  int min_face_rank_;
+  int neighbor_type_;
+  int root_level_;
+
+  /// Refresh parameters determining the FieldFace data
+  bool all_fields_;
+  std::vector<int> field_list_src_;
+  std::vector<int> field_list_dst_;
+  int ghost_depth_;
+  bool accumulate_;
+
+  /// Neighbor Block indices
+  std::vector<Index> index_list_;
+
+  /// FieldFace objects for each neighbor
+  std::vector<FieldFace *> face_list_;
+
+};
+
+#endif /* MESH_REFRESH_PLAN_HPP */
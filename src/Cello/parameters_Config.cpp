@@ -44,6 +44,8 @@ void Config::pup (PUP::er &p)
   // Balance
 
   p | balance_schedule_index;
+  p | balance_mapping;
+  p | balance_type;
 
   // Boundary
 
@@ -107,6 +109,9 @@ void Config::pup (PUP::er &p)
 
   p | num_method;
   p | method_courant_global;
+  p | method_refresh_merge;
+  p | method_subcycle;
+  p | method_subcycle_nonconservative;
   p | method_list;
   p | method_schedule_index;
   p | method_courant;
@@ -139,6 +144,7 @@ void Config::pup (PUP::er &p)
   p | output_image_face_rank;
   p | output_image_min;
   p | output_image_max;
+  p | output_image_remote_precision;
   p | output_min_level;
   p | output_max_level;
   p | output_leaf_only;
@@ -147,6 +153,9 @@ void Config::pup (PUP::er &p)
   p | output_dir_global;
   p | output_stride_write;
   p | output_stride_wait;
+  p | output_async;
+  p | output_async_limit_mb;
+  p | output_layout;
   p | output_field_list;
   p | output_particle_list;
   p | output_name;
@@ -375,6 +384,45 @@ void Config::read_balance_ (Parameters * p) throw()
   } else {
     balance_schedule_index = -1;
   }
+
+  balance_mapping = p->value_string("Balance:mapping","array");
+
+  if (balance_mapping != "array" &&
+      balance_mapping != "morton" &&
+      balance_mapping != "hilbert") {
+    ERROR2 ("Config::read()", "Unknown %s %s",
+	    "Balance:mapping",balance_mapping.c_str());
+  }
+
+  balance_type = p->value_string("Balance:type","charm");
+
+  if (balance_type != "charm" &&
+      balance_type != "cost") {
+    ERROR2 ("Config::read()", "Unknown %s %s",
+	    "Balance:type",balance_type.c_str());
+  }
+
+  if (balance_type == "cost" &&
+      balance_mapping != "morton" && balance_mapping != "hilbert") {
+    ERROR1 ("Config::read()",
+	    "Balance:type \"cost\" requires Balance:mapping "
+	    "\"morton\" or \"hilbert\", not \"%s\"",
+	    balance_mapping.c_str());
+  }
+
+  // Curve mappings split each level evenly over processes by possible
+  // rather than existing Blocks, so refined regions would be mapped to
+  // few processes without the cost-model load balancer
+
+  if ((balance_mapping == "morton" || balance_mapping == "hilbert") &&
+      p->value_integer("Adapt:max_level",0) > 0 &&
+      balance_type != "cost") {
+    ERROR2 ("Config::read()",
+	    "Balance:mapping \"%s\" requires a uniform mesh "
+	    "(Adapt:max_level = %d) unless Balance:type is \"cost\"",
+	    balance_mapping.c_str(),
+	    p->value_integer("Adapt:max_level",0));
+  }
   
 }  
 
@@ -705,6 +753,16 @@ void Config::read_method_ (Parameters * p) throw()
   method_trace_name.resize(num_method);
   
   method_courant_global = p->value_float ("Method:courant",1.0);
+
+  method_refresh_merge = p->value_logical ("Method:refresh_merge",false);
+  method_subcycle = p->value_logical ("Method:subcycle",false);
+  method_subcycle_nonconservative = p->value_logical
+    ("Method:subcycle_nonconservative",false);
+
+  // ... subcycling interpolates coarse ghost values in time between
+  // the old and new coarse values, so requires field history
+
+  if (method_subcycle && field_history < 1) field_history = 1;
   
   for (int index_method=0; index_method<num_method; index_method++) {
 
@@ -788,6 +846,7 @@ void Config::read_output_ (Parameters * p) throw()
   output_image_face_rank.resize(num_output);
   output_image_min.resize(num_output);
   output_image_max.resize(num_output);
+  output_image_remote_precision.resize(num_output);
   output_min_level.resize(num_output);
   output_max_level.resize(num_output);
   output_leaf_only.resize(num_output);
@@ -795,6 +854,9 @@ void Config::read_output_ (Parameters * p) throw()
   output_dir.resize(num_output);
   output_stride_write.resize(num_output);
   output_stride_wait.resize(num_output);
+  output_async.resize(num_output);
+  output_async_limit_mb.resize(num_output);
+  output_layout.resize(num_output);
   output_field_list.resize(num_output);
   output_particle_list.resize(num_output);
   output_name.resize(num_output);
@@ -822,6 +884,13 @@ void Config::read_output_ (Parameters * p) throw()
 
     output_stride_wait[index_output] = p->value_integer("stride_wait",0);
 
+    output_async[index_output] = p->value_logical("async",false);
+
+    output_async_limit_mb[index_output] =
+      p->value_float("async_limit_mb",1024.0);
+
+    output_layout[index_output] = p->value_string("layout","block");
+
     if (p->type("dir") == parameter_string) {
       output_dir[index_output].resize(1);
       output_dir[index_output][0] = p->value_string("dir","");
@@ -933,6 +1002,9 @@ void Config::read_output_ (Parameters * p) throw()
       output_image_max[index_output] =
 	p->value_float("image_max",-std::numeric_limits<double>::max());
 
+      output_image_remote_precision[index_output] =
+	p->value_string("image_remote_precision","double");
+
       output_min_level[index_output] = p->value_integer("min_level",0);
       output_max_level[index_output] =
 	p->value_integer("max_level",std::numeric_limits<int>::max());
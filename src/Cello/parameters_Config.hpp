@@ -39,6 +39,8 @@ public: // interface
     adapt_output(),
     adapt_schedule_index(),
     balance_schedule_index(0),
+    balance_mapping("array"),
+    balance_type("charm"),
     num_boundary(0),
     boundary_list(),
     boundary_type(),
@@ -75,6 +77,9 @@ public: // interface
     mesh_max_initial_level(0),
     num_method(0),
     method_courant_global(1.0),
+    method_refresh_merge(false),
+    method_subcycle(false),
+    method_subcycle_nonconservative(false),
     method_list(),
     method_schedule_index(),
     method_courant(),
@@ -101,6 +106,7 @@ public: // interface
     output_image_face_rank(),
     output_image_min(),
     output_image_max(),
+    output_image_remote_precision(),
     output_schedule_index(),
     output_max_level(),
     output_min_level(),
@@ -108,6 +114,9 @@ public: // interface
     output_dir(),
     output_stride_write(),
     output_stride_wait(),
+    output_async(),
+    output_async_limit_mb(),
+    output_layout(),
     output_field_list(),
     output_particle_list(),
     output_name(),
@@ -187,6 +196,8 @@ public: // interface
       adapt_output(),
       adapt_schedule_index(),
       balance_schedule_index(-1),
+      balance_mapping("array"),
+      balance_type("charm"),
       num_boundary(0),
       boundary_list(),
       boundary_type(),
@@ -223,6 +234,9 @@ public: // interface
       mesh_max_initial_level(0),
       num_method(0),
       method_courant_global(1.0),
+      method_refresh_merge(false),
+      method_subcycle(false),
+      method_subcycle_nonconservative(false),
       method_list(),
       method_schedule_index(),
       method_courant(),
@@ -249,6 +263,7 @@ public: // interface
       output_image_face_rank(),
       output_image_min(),
       output_image_max(),
+      output_image_remote_precision(),
       output_schedule_index(),
       output_max_level(),
       output_min_level(),
@@ -256,6 +271,9 @@ public: // interface
       output_dir(),
       output_stride_write(),
       output_stride_wait(),
+      output_async(),
+      output_async_limit_mb(),
+      output_layout(),
       output_field_list(),
       output_particle_list(),
       output_name(),
@@ -353,6 +371,8 @@ public: // attributes
   // Balance (dynamic load balancing)
 
   int                        balance_schedule_index;
+  std::string                balance_mapping;
+  std::string                balance_type;
 
   // Boundary
 
@@ -418,6 +438,9 @@ public: // attributes
 
   int                        num_method;
   double                     method_courant_global;
+  bool                       method_refresh_merge;
+  bool                       method_subcycle;
+  bool                       method_subcycle_nonconservative;
   std::vector<std::string>   method_list;
   std::vector<int>           method_schedule_index;
   std::vector<double>        method_courant;
@@ -450,6 +473,7 @@ public: // attributes
   std::vector < int >         output_image_face_rank;
   std::vector < double>       output_image_min;
   std::vector < double>       output_image_max;
+  std::vector < std::string > output_image_remote_precision;
   std::vector < int >         output_schedule_index;
   std::vector < int >         output_max_level;
   std::vector < int >         output_min_level;
@@ -458,6 +482,9 @@ public: // attributes
   std::string                 output_dir_global;
   std::vector < int >         output_stride_write;
   std::vector < int >         output_stride_wait;
+  std::vector < char >        output_async;
+  std::vector < double >      output_async_limit_mb;
+  std::vector < std::string > output_layout;
   std::vector < std::vector <std::string> >  output_field_list;
   std::vector < std::vector <std::string> > output_particle_list;
   std::vector < std::vector <std::string> >  output_name;
@@ -62,6 +62,25 @@ public: // virtual functions
   virtual bool expects_blocks_allocated() const throw()
   { return true; }
 
+  /// Return whether read_collective() should be called on all
+  /// processes before the root-level Blocks are created
+  virtual bool is_collective() const throw()
+  { return false; }
+
+  /// Read data for root-level Blocks on a subset of processes, and
+  /// send each Block's data to the process that will own it using
+  /// Simulation::p_initial_data().  Adds the number of files opened,
+  /// hyperslabs read, bytes read, and seconds reading to stats[]
+  virtual void read_collective (int index_initial,
+				const Hierarchy * hierarchy,
+				double stats[4]) throw()
+  { }
+
+  /// Receive Block data sent by read_collective() for use in
+  /// enforce_block()
+  virtual void receive_collective (int n, char * buffer) throw()
+  { }
+
 protected: // functions
 
 
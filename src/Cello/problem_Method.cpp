@@ -22,6 +22,31 @@ Method::~Method() throw()
 
 //----------------------------------------------------------------------
 
+void Method::add_field_written (std::string field_name)
+{
+  const int id_field = cello::field_descr()->field_id(field_name);
+  all_fields_written_ = false;
+  if (id_field >= 0 && ! is_field_written(id_field)) {
+    field_list_written_.push_back(id_field);
+  }
+}
+
+//----------------------------------------------------------------------
+
+void Method::add_group_written (std::string group_name)
+{
+  FieldDescr * field_descr = cello::field_descr();
+  all_fields_written_ = false;
+  for (int id_field=0; id_field<field_descr->field_count(); id_field++) {
+    const std::string name = field_descr->field_name(id_field);
+    if (field_descr->groups()->is_in(name,group_name)) {
+      add_field_written(name);
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+
 void Method::pup (PUP::er &p)
 { TRACEPUP;
   PUP::able::pup(p);
@@ -40,6 +65,9 @@ void Method::pup (PUP::er &p)
   p | refresh_list_;
   p | schedule_; // pupable
   p | courant_;
+  p | all_fields_written_;
+  p | field_list_written_;
+  p | is_refresh_merged_;
 }
 
 //----------------------------------------------------------------------
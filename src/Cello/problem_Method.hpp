@@ -23,7 +23,10 @@ public: // interface
   Method (double courant = 1.0) throw()
     : refresh_list_(),
       schedule_(NULL),
-      courant_(courant)
+      courant_(courant),
+      all_fields_written_(true),
+      field_list_written_(),
+      is_refresh_merged_(false)
   { }
 
   /// Destructor
@@ -36,7 +39,10 @@ public: // interface
     : PUP::able(m),
       refresh_list_(),
       schedule_(NULL),
-      courant_(1.0)
+      courant_(1.0),
+      all_fields_written_(true),
+      field_list_written_(),
+      is_refresh_merged_(false)
   { }
       
   /// CHARM++ Pack / Unpack function
@@ -62,6 +68,16 @@ public: // virtual functions
     /* This function intentionally empty */
   }
 
+  /// Return whether compute() performs reductions over all Blocks,
+  /// and so must be called on every Block or none
+  virtual bool is_global_reduction () const throw()
+  { return false; }
+
+  /// Return whether compute() updates conserved quantities with
+  /// fluxes, which requires flux correction at level boundaries
+  virtual bool is_conservative () const throw()
+  { return false; }
+
   int add_refresh (int ghost_depth, 
 		   int min_face_rank, 
 		   int neighbor_type, 
@@ -93,6 +109,44 @@ public: // virtual functions
   void set_courant(double courant) throw ()
   { courant_ = courant; }
 
+  /// Declare the only fields that compute() may modify.  By default
+  /// a Method is assumed to modify all fields
+  void set_field_list_written (const std::vector<int> & field_list)
+  {
+    all_fields_written_ = false;
+    field_list_written_ = field_list;
+  }
+
+  /// Add the named field, if defined, to the fields that compute()
+  /// may modify
+  void add_field_written (std::string field_name);
+
+  /// Add all fields in the named group to the fields that compute()
+  /// may modify
+  void add_group_written (std::string group_name);
+
+  /// Return whether compute() may modify the given field
+  bool is_field_written (int id_field) const
+  {
+    return all_fields_written_ ||
+      (std::find (field_list_written_.begin(),field_list_written_.end(),
+		  id_field) != field_list_written_.end());
+  }
+
+  /// Return whether compute() may modify any field
+  bool any_field_written () const
+  { return all_fields_written_ || (field_list_written_.size() > 0); }
+
+  /// Return whether the Method's Refresh has been merged into that
+  /// of an earlier Method, and can be skipped
+  bool is_refresh_merged () const
+  { return is_refresh_merged_; }
+
+  /// Set whether the Method's Refresh has been merged into that of
+  /// an earlier Method
+  void set_refresh_merged (bool is_refresh_merged)
+  { is_refresh_merged_ = is_refresh_merged; }
+
 protected: // functions
 
   /// Perform vector copy X <- Y
@@ -122,6 +176,15 @@ protected: // attributes
   /// Courant condition for the Method
   double courant_;
 
+  /// Whether compute() may modify any field
+  bool all_fields_written_;
+
+  /// Fields that compute() may modify if not all_fields_written_
+  std::vector<int> field_list_written_;
+
+  /// Whether the Refresh is merged into that of an earlier Method
+  bool is_refresh_merged_;
+
 };
 
 #endif /* PROBLEM_METHOD_HPP */
@@ -453,6 +453,15 @@ void Problem::initialize_method ( Config * config ) throw()
 
     if (method) {
 
+      if (config->method_subcycle && method->is_conservative() &&
+	  ! config->method_subcycle_nonconservative) {
+	ERROR1("Problem::initialize_method",
+	       "Method %s is conservative but Method:subcycle does not "
+	       "correct fluxes at level boundaries: set "
+	       "Method:subcycle_nonconservative = true to run anyway",
+	       name.c_str());
+      }
+
       method_list_.push_back(method); 
 
       int index_schedule = config->method_schedule_index[index_method];
@@ -472,6 +481,75 @@ void Problem::initialize_method ( Config * config ) throw()
 	     "Unknown Method %s",name.c_str());
     }
   }
+
+  if (config->method_refresh_merge) merge_method_refresh_();
+}
+
+//----------------------------------------------------------------------
+
+void Problem::merge_method_refresh_() throw()
+{
+  // Index of the Method whose Refresh later Refresh objects may be
+  // merged into, or -1 if none
+  int index_merge = -1;
+
+  int num_merged = 0;
+
+  for (size_t index_method=0; index_method<method_list_.size();
+       index_method++) {
+
+    Method * method = method_list_[index_method];
+    Refresh * refresh = method->refresh();
+
+    if (refresh == NULL) continue;
+
+    Refresh * refresh_merge =
+      (index_merge >= 0) ? method_list_[index_merge]->refresh() : NULL;
+
+    if (refresh_merge &&
+	refresh_merge->can_merge(refresh) &&
+	! is_refresh_written_(refresh,index_merge,index_method)) {
+
+      refresh_merge->merge(refresh);
+      method->set_refresh_merged(true);
+      ++num_merged;
+
+      cello::monitor()->print
+	("Method","refresh for method %s merged into method %s",
+	 method->name().c_str(),
+	 method_list_[index_merge]->name().c_str());
+
+    } else {
+
+      index_merge = index_method;
+
+    }
+  }
+
+  if (num_merged > 0) {
+    cello::monitor()->print
+      ("Method","%d of %d method refreshes merged",
+       num_merged, int(method_list_.size()));
+  }
+}
+
+//----------------------------------------------------------------------
+
+bool Problem::is_refresh_written_
+(Refresh * refresh, int index_begin, int index_end) throw()
+{
+  for (int i=index_begin; i<index_end; i++) {
+    const Method * method = method_list_[i];
+    if (refresh->all_fields()) {
+      if (method->any_field_written()) return true;
+    } else {
+      std::vector<int> & field_list = refresh->field_list_src();
+      for (size_t j=0; j<field_list.size(); j++) {
+	if (method->is_field_written(field_list[j])) return true;
+      }
+    }
+  }
+  return false;
 }
 
 //----------------------------------------------------------------------
@@ -876,6 +954,8 @@ Output * Problem::create_output_
       config->output_image_color_particle_attribute[index];
     double      image_min = config->output_image_min[index];
     double      image_max = config->output_image_max[index];
+    std::string image_remote_precision =
+      config->output_image_remote_precision[index];
 
     double image_lower[3] = { config->output_image_lower[index][0],
 			      config->output_image_lower[index][1],
@@ -906,7 +986,8 @@ Output * Problem::create_output_
 			      image_log,
 			      image_abs,
 			      image_ghost,
-			      image_min, image_max);
+			      image_min, image_max,
+			      image_remote_precision);
 
   } else if (name == "data") {
 
@@ -94,6 +94,27 @@ public: // interface
   bool is_periodic () const throw() 
   { return is_periodic_; }
 
+  /// Return whether any initialization object reads data
+  /// collectively before Blocks are created
+  bool initial_is_collective() const throw()
+  {
+    for (size_t i=0; i<initial_list_.size(); i++) {
+      if (initial_list_[i]->is_collective()) return true;
+    }
+    return false;
+  }
+
+  /// Read data collectively for initialization objects that do so
+  void initial_read_collective
+  (const Hierarchy * hierarchy, double stats[4]) throw()
+  {
+    for (size_t i=0; i<initial_list_.size(); i++) {
+      if (initial_list_[i]->is_collective()) {
+	initial_list_[i]->read_collective(i,hierarchy,stats);
+      }
+    }
+  }
+
   /// Return the ith initialization object
   Initial *  initial(size_t i) const throw()
   {
@@ -165,6 +186,12 @@ public: // interface
   /// proceed with next output
   void output_write (Simulation * simulation, int n, char * buffer) throw();
 
+  /// Write all data staged for asynchronous output on this process
+  void output_flush () throw()
+  {
+    for (size_t i=0; i<output_list_.size(); i++) output_list_[i]->flush();
+  }
+
   /// Return the stopping object
   Stopping * stopping() const throw() { return stopping_; }
 
@@ -219,6 +246,15 @@ protected: // functions
   /// Deallocate components
   void deallocate_() throw();
 
+  /// Merge each Method's Refresh into that of an earlier Method if
+  /// no Method in between modifies the refreshed fields
+  void merge_method_refresh_() throw();
+
+  /// Return whether Methods in [index_begin,index_end) may modify
+  /// any field refreshed by the given Refresh
+  bool is_refresh_written_
+  (Refresh * refresh, int index_begin, int index_end) throw();
+
   /// Create named boundary object
   virtual Boundary * create_boundary_
   (std::string type,
@@ -7,6 +7,8 @@
 
 #include "problem.hpp"
 
+long Refresh::counter_merged[CONFIG_NODE_SIZE] = {0};
+
 //----------------------------------------------------------------------
 
 void Refresh::add_field(std::string field_name)
@@ -17,6 +19,39 @@ void Refresh::add_field(std::string field_name)
 
 //----------------------------------------------------------------------
 
+bool Refresh::can_merge (const Refresh * refresh) const
+{
+  // fields must map to themselves in both Refresh objects, since
+  // add_field() would otherwise mis-pair source and destination fields
+
+  const bool is_same_src_dst =
+    (field_list_src_ == field_list_dst_) &&
+    (refresh->field_list_src_ == refresh->field_list_dst_);
+
+  return (is_same_src_dst &&
+	  ! accumulate_ && ! refresh->accumulate_ &&
+	  ! refresh->any_particles() &&
+	  refresh->neighbor_type_ == neighbor_type_ &&
+	  refresh->root_level_    == root_level_);
+}
+
+//----------------------------------------------------------------------
+
+void Refresh::merge (const Refresh * refresh)
+{
+  if (refresh->all_fields_) {
+    add_all_fields();
+  } else if (! all_fields_) {
+    for (size_t i=0; i<refresh->field_list_src_.size(); i++) {
+      add_field(refresh->field_list_src_[i]);
+    }
+  }
+  ghost_depth_   = std::max(ghost_depth_,  refresh->ghost_depth_);
+  min_face_rank_ = std::min(min_face_rank_,refresh->min_face_rank_);
+}
+
+//----------------------------------------------------------------------
+
 int Refresh::data_size () const
 {
   int count = 0;
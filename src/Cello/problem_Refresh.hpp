@@ -159,6 +159,15 @@ public: // interface
   bool any_fields() const
   { return (all_fields_ || (field_list_src_.size() > 0)); }
 
+  /// Return whether the given Refresh can be merged into this one:
+  /// it must refresh only fields, each to itself, with the same
+  /// neighbor type and without accumulating
+  bool can_merge (const Refresh * refresh) const;
+
+  /// Add the fields of the given Refresh to this one, increasing the
+  /// ghost depth and decreasing the minimum face rank if needed
+  void merge (const Refresh * refresh);
+
   /// Return the list of source fields participating in the Refresh operation
   std::vector<int> & field_list_src()
   { return field_list_src_; }
@@ -276,6 +285,10 @@ public: // interface
   int sync_id() 
   {  return sync_id_; }
 
+  /// Number of Refresh operations skipped since merged into an
+  /// earlier Refresh (for performance monitoring)
+  static long counter_merged[CONFIG_NODE_SIZE];
+
 
   void print() const 
   {
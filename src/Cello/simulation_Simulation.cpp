@@ -884,10 +884,15 @@ void Simulation::monitor_performance()
   // 5 field_face
   // 6 particle_data
   // 7 num-particles
+  // 8 num-refresh-merged
+  // 9 data-msg-pool-hit
+  // 10 data-msg-pool-miss
+  // 11 field-face-pool-hit
+  // 12 field-face-pool-miss
   // NL num-blocks-<L>
   // 
   
-  int n = 1 + 7 + ( 1 + hierarchy_->max_level()) + nr*nc;
+  int n = 1 + 12 + ( 1 + hierarchy_->max_level()) + nr*nc;
 
   long long * counters_region = new long long [nc];
   long long * counters_reduce = new long long [n];
@@ -903,6 +908,16 @@ void Simulation::monitor_performance()
   counters_reduce[m++] = FieldFace::counter[in];      // 5
   counters_reduce[m++] = ParticleData::counter[in];   // 6
   counters_reduce[m++] = hierarchy_->num_particles(); // 7
+  counters_reduce[m++] = Refresh::counter_merged[in]; // 8
+  counters_reduce[m++] = DataMsg::pool.num_hits(in);     // 9
+  counters_reduce[m++] = DataMsg::pool.num_misses(in);   // 10
+  counters_reduce[m++] = FieldFace::pool.num_hits(in);   // 11
+  counters_reduce[m++] = FieldFace::pool.num_misses(in); // 12
+
+  // (...merged refresh and pool counters are reported per cycle)
+  Refresh::counter_merged[in] = 0;
+  DataMsg::pool.reset_counters(in);
+  FieldFace::pool.reset_counters(in);
 
   for (int i=0; i<=hierarchy_->max_level(); i++) 
     counters_reduce[m++] = hierarchy_->num_blocks(i);
@@ -952,6 +967,11 @@ void Simulation::r_monitor_performance(CkReductionMsg * msg)
   long long field_face  = counters_reduce[m++];   // 5
   long long particle_data = counters_reduce[m++]; // 6
   long long num_particles = counters_reduce[m++]; // 7
+  long long refresh_merged = counters_reduce[m++]; // 8
+  long long data_msg_hit   = counters_reduce[m++]; // 9
+  long long data_msg_miss  = counters_reduce[m++]; // 10
+  long long field_face_hit  = counters_reduce[m++]; // 11
+  long long field_face_miss = counters_reduce[m++]; // 12
 
   monitor()->print("Performance","counter num-msg-coarsen %ld", msg_coarsen);
   monitor()->print("Performance","counter num-msg-refine %ld", msg_refine);
@@ -959,6 +979,24 @@ void Simulation::r_monitor_performance(CkReductionMsg * msg)
   monitor()->print("Performance","counter num-data-msg %ld", data_msg);
   monitor()->print("Performance","counter num-field-face %ld", field_face);
   monitor()->print("Performance","counter num-particle-data %ld", particle_data);
+  monitor()->print("Performance","counter num-refresh-merged %ld",
+		   refresh_merged);
+  monitor()->print("Performance","counter num-data-msg-pool-hit %ld",
+		   data_msg_hit);
+  monitor()->print("Performance","counter num-data-msg-pool-miss %ld",
+		   data_msg_miss);
+  monitor()->print("Performance","counter num-field-face-pool-hit %ld",
+		   field_face_hit);
+  monitor()->print("Performance","counter num-field-face-pool-miss %ld",
+		   field_face_miss);
+  if (data_msg_hit + data_msg_miss > 0) {
+    monitor()->print("Performance","counter data-msg-pool-hit-rate %f",
+		     double(data_msg_hit) / (data_msg_hit + data_msg_miss));
+  }
+  if (field_face_hit + field_face_miss > 0) {
+    monitor()->print("Performance","counter field-face-pool-hit-rate %f",
+		     double(field_face_hit) / (field_face_hit + field_face_miss));
+  }
 
   monitor()->print("Performance","simulation num-particles total %ld",
 		   num_particles);
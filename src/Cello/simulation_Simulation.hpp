@@ -234,6 +234,19 @@ public: // virtual functions
   /// Wait for all local patches to be created before calling run
   void r_initialize_hierarchy(CkReductionMsg * msg);
 
+  /// Read initial data collectively before root-level Blocks are created
+  void p_initial_read();
+
+  /// Report collective initial data read statistics and create Blocks
+  void r_initial_read(CkReductionMsg * msg);
+
+  /// Receive initial data for a local Block from a reader process
+  void p_initial_data(int index_initial, int n, char * buffer);
+
+  /// Create the root-level Blocks
+  void p_initialize_block_array()
+  { initialize_block_array_(); }
+
   /// Send Config and Parameters from ip==0 to all other processes
 
   void send_config();
@@ -278,12 +291,36 @@ public: // virtual functions
   /// proceed with next output
   void p_output_write (int n, char * buffer);
 
+  /// Write the next Block staged for asynchronous output, and resend
+  /// to self until all are written
+  void p_output_drain (int index_output);
+
+  /// Write all data staged for asynchronous output before exiting
+  void p_output_flush ();
+  void r_output_flush (CkReductionMsg * msg);
+
   //--------------------------------------------------
   // Compute
   //--------------------------------------------------
   
   void compute ();
 
+  //--------------------------------------------------
+  // Refresh
+  //--------------------------------------------------
+
+  /// Receive ghost zone faces aggregated by process and store each
+  /// in its Block, or send it to p_refresh_store() if it has migrated
+  void p_refresh_store_list (int n, char * buffer);
+
+  //--------------------------------------------------
+  // Balance
+  //--------------------------------------------------
+
+  /// Compute the cost-model load balance from all Blocks' measured
+  /// costs, and migrate Blocks accordingly
+  void r_balance_plan (CkReductionMsg * msg);
+
   //--------------------------------------------------
   // Monitor
   //--------------------------------------------------
@@ -9,6 +9,7 @@
 #include "test.hpp"
 
 #include "data.hpp"
+#include "performance.hpp" /* for Timer */
 
 //----------------------------------------------------------------------
 
@@ -392,6 +393,166 @@ PARALLEL_MAIN_BEGIN
   unit_func("face_to_array / array_to_face");
   unit_assert(test_fields(field_descr,field_data,nbx,nby,nbz,mx,my,mz));
 
+  //----------------------------------------------------------------------
+  // Fused packing of fields with the same layout, and pack / unpack
+  // rates for each face orientation
+  //----------------------------------------------------------------------
+
+  {
+    const int num_fields = 10;
+
+    FieldDescr * perf_descr = new FieldDescr;
+    for (int k=0; k<num_fields; k++) {
+      char name[20];
+      snprintf (name,sizeof(name),"perf_%d",k);
+      perf_descr->insert_permanent(name);
+      perf_descr->set_precision(k, precision_double);
+      perf_descr->set_ghost_depth(k, 3,3,3);
+    }
+
+    const int n = 32;
+    FieldData * perf_data = new FieldData (perf_descr, n,n,n);
+    perf_data->allocate_permanent(perf_descr,true);
+
+    Field field (perf_descr,perf_data);
+
+    int m3[3];
+    field.field_size(0,&m3[0],&m3[1],&m3[2]);
+    const int m = m3[0]*m3[1]*m3[2];
+    for (int k=0; k<num_fields; k++) {
+      double * values = (double *) field.values(k);
+      for (int i=0; i<m; i++) values[i] = k*m + i;
+    }
+
+    std::vector<int> field_list;
+    for (int k=0; k<num_fields; k++) field_list.push_back(k);
+    Refresh refresh;
+    refresh.set_field_list(field_list);
+
+    const char * axis_name[3] = {"x","y","z"};
+    const int num_iter = 100;
+
+    for (int axis=0; axis<3; axis++) {
+
+      int if3[3] = {0,0,0};
+      if3[axis] = 1;
+
+      FieldFace face (field);
+      face.set_refresh_type(refresh_same);
+      face.set_ghost(true,true,true);
+      face.set_face(if3[0],if3[1],if3[2]);
+      face.set_refresh(&refresh,false);
+
+      const int bytes = face.num_bytes_array(field);
+      char * array = new char [bytes];
+
+      // fused packing must match packing each field separately
+
+      unit_func("face_to_array (fused)");
+
+      face.face_to_array(field,array);
+
+      bool match = true;
+      for (int k=0; k<num_fields; k++) {
+	std::vector<int> field_list_k (1,k);
+	Refresh refresh_k;
+	refresh_k.set_field_list(field_list_k);
+	FieldFace face_k (field);
+	face_k.set_refresh_type(refresh_same);
+	face_k.set_ghost(true,true,true);
+	face_k.set_face(if3[0],if3[1],if3[2]);
+	face_k.set_refresh(&refresh_k,false);
+	const int bytes_k = face_k.num_bytes_array(field);
+	char * array_k = new char [bytes_k];
+	face_k.face_to_array(field,array_k);
+	match = match && (bytes_k*num_fields == bytes) &&
+	  (memcmp(array_k,array + k*bytes_k,bytes_k) == 0);
+	delete [] array_k;
+      }
+      unit_assert(match);
+
+      Timer timer;
+
+      timer.clear();
+      timer.start();
+      for (int i=0; i<num_iter; i++) face.face_to_array(field,array);
+      const double time_load = timer.stop();
+
+      timer.clear();
+      timer.start();
+      for (int i=0; i<num_iter; i++) face.array_to_face(array,field);
+      const double time_store = timer.stop();
+
+      PARALLEL_PRINTF
+	("FieldFace %s face %d fields %d bytes: "
+	 "face_to_array %g bytes/s array_to_face %g bytes/s\n",
+	 axis_name[axis], num_fields, bytes,
+	 (time_load  > 0.0) ? num_iter*bytes/time_load  : 0.0,
+	 (time_store > 0.0) ? num_iter*bytes/time_store : 0.0);
+
+      delete [] array;
+    }
+
+    //--------------------------------------------------
+    // Array size is kept across refresh cycles with the same fields,
+    // and tracks the field list otherwise
+    //--------------------------------------------------
+
+    unit_func("update_refresh()");
+
+    {
+      FieldFace face (field);
+      face.set_refresh_type(refresh_same);
+      face.set_face(1,0,0);
+      face.set_refresh(&refresh,false);
+
+      const int bytes = face.num_bytes_array(field);
+
+      // Refresh copies for later cycles, as made by Block::set_refresh()
+
+      bool is_same = true;
+      for (int cycle=0; cycle<3; cycle++) {
+	Refresh refresh_cycle;
+	refresh_cycle.set_field_list(field_list);
+	face.update_refresh(&refresh_cycle);
+	is_same = is_same && (face.num_bytes_array(field) == bytes);
+      }
+      unit_assert (is_same);
+
+      // Dropping the last field reduces the size by that field's face,
+      // and restoring it restores the size
+
+      std::vector<int> field_list_fewer (field_list.begin(),
+					 field_list.end() - 1);
+      Refresh refresh_fewer;
+      refresh_fewer.set_field_list(field_list_fewer);
+      face.update_refresh(&refresh_fewer);
+      const int bytes_fewer = face.num_bytes_array(field);
+
+      Refresh refresh_last;
+      refresh_last.set_field_list
+	(std::vector<int> (1,field_list[field_list.size()-1]));
+      face.update_refresh(&refresh_last);
+      const int bytes_last = face.num_bytes_array(field);
+
+      unit_assert (bytes_fewer < bytes);
+      unit_assert (bytes_fewer + bytes_last == bytes);
+
+      face.update_refresh(&refresh);
+      unit_assert (face.num_bytes_array(field) == bytes);
+
+      unit_func("set_refresh()");
+
+      Refresh refresh_new;
+      refresh_new.set_field_list(field_list_fewer);
+      face.set_refresh(&refresh_new,false);
+      unit_assert (face.num_bytes_array(field) == bytes_fewer);
+    }
+
+    delete perf_data;
+    delete perf_descr;
+  }
+
   //----------------------------------------------------------------------	
   // clean up
   //----------------------------------------------------------------------	
@@ -342,6 +342,28 @@ PARALLEL_MAIN_BEGIN
     }
   }
 
+  //==================================================
+  // Hash
+  //==================================================
+
+  unit_func ("Hash");
+
+  Index::Hash hash;
+
+  std::unordered_map<Index,int,Index::Hash> index_map;
+  for (int i=0; i<N+1; i++) {
+    Index copy = i8[i];
+    unit_assert (hash(copy) == hash(i8[i]));
+    index_map[i8[i]] = i;
+  }
+  unit_assert (index_map.size() == N+1);
+  bool map_ok = true;
+  for (int i=0; i<N+1; i++) {
+    map_ok = map_ok && (index_map.find(i8[i]) != index_map.end())
+      && (index_map[i8[i]] == i);
+  }
+  unit_assert (map_ok);
+
   //==================================================
   // Subtree
   //==================================================
@@ -0,0 +1,286 @@
+// See LICENSE_CELLO file for license and copyright information
+
+/// @file     test_OutputStage.cpp
+/// @author   James Bordner (jobordner@ucsd.edu)
+/// @date     2020-04-06
+/// @brief    Test program for the OutputStage class
+///
+/// Stages the same Blocks with the "block" and "level" layouts, and
+/// checks that each Block's rows of the per-level datasets, located
+/// using the "block_offset" table, match its datasets and metadata
+/// in the "block" layout file.
+
+#include "main.hpp"
+#include "test.hpp"
+
+#include "io.hpp"
+#include "disk.hpp"
+
+//----------------------------------------------------------------------
+
+const int num_blocks = 5;
+const int nx = 4;
+const int ny = 3;
+
+/// Blocks alternate between levels, so that levels are interleaved
+/// as they are staged
+const int block_level[num_blocks] = { 0, 1, 0, 1, 0 };
+
+/// Particle counts vary between Blocks, including none
+const int block_particles[num_blocks] = { 3, 0, 5, 2, 1 };
+
+double field_value_ (int ib, int i)
+{ return 1000.0*ib + i; }
+
+double particle_value_ (int ib, int ip)
+{ return -1000.0*ib - ip; }
+
+//----------------------------------------------------------------------
+
+void stage_blocks_ (OutputStage * stage)
+{
+  for (int ib=0; ib<num_blocks; ib++) {
+
+    char group_name[20];
+    snprintf (group_name,sizeof(group_name),"/B%d",ib);
+
+    stage->new_block(group_name,block_level[ib]);
+
+    int index[3] = { ib, 10*ib, 100*ib };
+    double lower[3] = { 0.5*ib, 0.25*ib, 0.0 };
+    stage->add_meta(index,"index",type_int,3,0,0);
+    stage->add_meta(lower,"lower",type_double,3,0,0);
+
+    double * field = (double *) stage->new_data
+      ("field_density",type_double,nx,ny,1,nx,ny,1);
+    for (int i=0; i<nx*ny; i++) field[i] = field_value_(ib,i);
+
+    const int np = block_particles[ib];
+    double * particle = (double *) stage->new_data
+      ("particle_dark_x",type_double,np,1,1,np,1,1);
+    for (int ip=0; ip<np; ip++) particle[ip] = particle_value_(ib,ip);
+  }
+}
+
+//----------------------------------------------------------------------
+
+/// Read the named dataset from the open group, returning its size
+int read_data_ (FileHdf5 * file, std::string name, std::vector<char> * values,
+		int * m4, int * column = NULL)
+{
+  int type = type_unknown;
+  m4[0] = m4[1] = m4[2] = m4[3] = 0;
+  file->data_open (name,&type,&m4[0],&m4[1],&m4[2],&m4[3]);
+  const int n = m4[0]*std::max(m4[1],1)*std::max(m4[2],1)*std::max(m4[3],1);
+  values->resize(n*cello::type_bytes[type]);
+  if (n > 0) {
+    file->mem_create(n,1,1,n,1,1,0,0,0);
+    file->data_read(values->data());
+    file->mem_close();
+  }
+  if (column) file->data_read_meta(column,"block_offset_column",&type);
+  file->data_close();
+  return n;
+}
+
+//----------------------------------------------------------------------
+
+PARALLEL_MAIN_BEGIN
+{
+
+  PARALLEL_INIT;
+
+  unit_init(0,1);
+
+  unit_class ("OutputStage");
+
+  const long long bytes_expected = num_blocks *
+    (3*sizeof(int) + 3*sizeof(double) + nx*ny*sizeof(double))
+    + (3+0+5+2+1)*sizeof(double);
+
+  //--------------------------------------------------
+
+  unit_func ("OutputStage(output_layout_block)");
+
+  FileHdf5 * file_block = new FileHdf5 ("./","test_output_stage_block.h5");
+  file_block->file_create();
+
+  OutputStage * stage_block = new OutputStage (file_block,output_layout_block);
+
+  stage_blocks_(stage_block);
+
+  unit_assert (stage_block->bytes() == bytes_expected);
+  unit_assert (! stage_block->is_empty());
+
+  stage_block->write_all();
+
+  unit_assert (stage_block->bytes() == 0);
+  unit_assert (stage_block->is_empty());
+
+  delete stage_block;
+
+  //--------------------------------------------------
+
+  unit_func ("OutputStage(output_layout_level)");
+
+  FileHdf5 * file_level = new FileHdf5 ("./","test_output_stage_level.h5");
+  file_level->file_create();
+
+  OutputStage * stage_level = new OutputStage (file_level,output_layout_level);
+
+  stage_blocks_(stage_level);
+
+  unit_assert (stage_level->bytes() == bytes_expected);
+  unit_assert (! stage_level->is_empty());
+
+  // levels are written one at a time
+
+  unit_assert (stage_level->write_next());
+  unit_assert (! stage_level->write_next());
+
+  unit_assert (stage_level->bytes() == 0);
+  unit_assert (stage_level->is_empty());
+
+  delete stage_level;
+
+  //--------------------------------------------------
+
+  FileHdf5 block ("./","test_output_stage_block.h5");
+  FileHdf5 level ("./","test_output_stage_level.h5");
+  block.file_open();
+  level.file_open();
+
+  const int nd = 2;
+  const char * data_name[nd] = { "field_density", "particle_dark_x" };
+
+  for (int il=0; il<2; il++) {
+
+    char group_name[20];
+    snprintf (group_name,sizeof(group_name),"/level_%d",il);
+    level.group_chdir(group_name);
+    level.group_open();
+
+    int nb_expected = 0;
+    for (int ib=0; ib<num_blocks; ib++) {
+      if (block_level[ib] == il) ++nb_expected;
+    }
+
+    //--------------------------------------------------
+
+    unit_func ("num_blocks");
+
+    int type = type_unknown;
+    int nb = 0, level_value = -1;
+    level.group_read_meta (&nb,"num_blocks",&type);
+    level.group_read_meta (&level_value,"level",&type);
+    unit_assert (nb == nb_expected);
+    unit_assert (level_value == il);
+
+    //--------------------------------------------------
+
+    unit_func ("block_offset");
+
+    std::vector<char> offset_values;
+    int m4[4];
+    read_data_(&level,"block_offset",&offset_values,m4);
+    unit_assert (m4[0] == nb && m4[1] == nd);
+    const long long * block_offset = (const long long *) offset_values.data();
+
+    std::vector<char> level_values[nd];
+    int level_size[nd], column[nd];
+    for (int id=0; id<nd; id++) {
+      level_size[id] = read_data_
+	(&level,data_name[id],&level_values[id],m4,&column[id]);
+      if (id == 0) {
+	// fields are stacked along a leading Block axis
+	unit_assert (m4[0] == nb && m4[1] == ny && m4[2] == nx);
+      } else {
+	// particle attributes vary in size, so are concatenated
+	unit_assert (m4[1] == 1 && m4[2] == 1);
+      }
+    }
+    unit_assert (column[0] != column[1]);
+    unit_assert (0 <= column[0] && column[0] < nd);
+    unit_assert (0 <= column[1] && column[1] < nd);
+
+    std::vector<char> index_values, lower_values;
+    read_data_(&level,"block_index",&index_values,m4);
+    unit_assert (m4[0] == nb && m4[1] == 3);
+    read_data_(&level,"block_lower",&lower_values,m4);
+    unit_assert (m4[0] == nb && m4[1] == 3);
+
+    //--------------------------------------------------
+
+    unit_func ("layout");
+
+    // Blocks in a level are written in the order staged
+
+    bool match_meta = true;
+    bool match_data = true;
+    bool match_offset = true;
+    long long offset_end[nd] = {0};
+    int jb = 0;
+
+    for (int ib=0; ib<num_blocks; ib++) {
+
+      if (block_level[ib] != il) continue;
+
+      snprintf (group_name,sizeof(group_name),"/B%d",ib);
+      block.group_chdir(group_name);
+      block.group_open();
+
+      int index[3];
+      double lower[3];
+      block.group_read_meta (index,"index",&type);
+      block.group_read_meta (lower,"lower",&type);
+
+      const int * level_index = (const int *) index_values.data();
+      const double * level_lower = (const double *) lower_values.data();
+      for (int i=0; i<3; i++) {
+	match_meta = match_meta && (level_index[3*jb+i] == index[i]);
+	match_meta = match_meta && (level_lower[3*jb+i] == lower[i]);
+      }
+
+      for (int id=0; id<nd; id++) {
+
+	std::vector<char> block_values;
+	const int n = read_data_(&block,data_name[id],&block_values,m4);
+
+	// each Block's data follow those of the previous Block
+
+	const long long offset = block_offset[jb*nd + column[id]];
+	match_offset = match_offset && (offset == offset_end[id]);
+	offset_end[id] = offset + n;
+
+	const double * a = (const double *) block_values.data();
+	const double * b = (const double *) level_values[id].data();
+	for (int i=0; i<n && offset+i < level_size[id]; i++) {
+	  match_data = match_data && (a[i] == b[offset + i]);
+	}
+      }
+
+      block.group_close();
+      ++jb;
+    }
+
+    unit_assert (jb == nb);
+    unit_assert (match_meta);
+    unit_assert (match_offset);
+    unit_assert (match_data);
+    unit_assert (offset_end[0] == level_size[0]);
+    unit_assert (offset_end[1] == level_size[1]);
+
+    level.group_close();
+  }
+
+  block.file_close();
+  level.file_close();
+
+  //--------------------------------------------------
+
+  unit_finalize();
+
+  exit_();
+}
+
+PARALLEL_MAIN_END
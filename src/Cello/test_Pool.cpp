@@ -0,0 +1,84 @@
+// See LICENSE_CELLO file for license and copyright information
+
+/// @file      test_Pool.cpp
+/// @author    James Bordner (jobordner@ucsd.edu)
+/// @date      2020-03-23
+/// @brief     Program implementing unit tests for the Pool class
+
+#include "main.hpp"
+#include "test.hpp"
+
+#include "memory.hpp"
+
+PARALLEL_MAIN_BEGIN
+{
+
+  PARALLEL_INIT;
+
+  unit_init(0,1);
+
+  unit_class("Pool");
+
+  const int in = cello::index_static();
+
+  Pool pool (sizeof(double[4]),2);
+
+  //----------------------------------------------------------------------
+
+  unit_func("allocate");
+
+  void * a = pool.allocate(sizeof(double[4]));
+  void * b = pool.allocate(sizeof(double[4]));
+
+  unit_assert (a != NULL && b != NULL && a != b);
+  unit_assert (pool.num_hits(in) == 0);
+  unit_assert (pool.num_misses(in) == 2);
+
+  //----------------------------------------------------------------------
+
+  unit_func("deallocate");
+
+  pool.deallocate(a);
+  pool.deallocate(b);
+
+  // freed objects are reused in stack order
+
+  unit_assert (pool.allocate(sizeof(double[4])) == b);
+  unit_assert (pool.allocate(sizeof(double[4])) == a);
+  unit_assert (pool.num_hits(in) == 2);
+  unit_assert (pool.num_misses(in) == 2);
+
+  // objects of a different size are not taken from the free list
+
+  pool.deallocate(a);
+  void * c = pool.allocate(sizeof(double[8]));
+  unit_assert (c != a);
+  unit_assert (pool.num_misses(in) == 3);
+  ::operator delete (c);
+
+  // free list is limited to max_free_list objects
+
+  void * d = pool.allocate(sizeof(double[4]));
+  void * e = pool.allocate(sizeof(double[4]));
+  pool.deallocate(b);
+  pool.deallocate(d);
+  pool.deallocate(e);
+  unit_assert (pool.allocate(sizeof(double[4])) == d);
+  unit_assert (pool.allocate(sizeof(double[4])) == b);
+
+  //----------------------------------------------------------------------
+
+  unit_func("reset_counters");
+
+  pool.reset_counters(in);
+  unit_assert (pool.num_hits(in) == 0);
+  unit_assert (pool.num_misses(in) == 0);
+
+  //----------------------------------------------------------------------
+
+  unit_finalize();
+
+  exit_();
+}
+
+PARALLEL_MAIN_END
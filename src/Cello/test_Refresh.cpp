@@ -51,6 +51,41 @@ PARALLEL_MAIN_BEGIN
 
   //--------------------------------------------------
 
+  unit_func ("can_merge()");
+
+  Refresh * refresh_2 = new Refresh (4,0,neighbor_leaf,sync_barrier,1,true);
+  refresh_2->add_field (9);
+  refresh_2->add_field (5);
+
+  unit_assert (refresh->can_merge(refresh_2));
+
+  Refresh * refresh_3 = new Refresh (4,0,neighbor_level,sync_barrier,2,true);
+  refresh_3->add_field (5);
+  unit_assert (! refresh->can_merge(refresh_3));
+  delete refresh_3;
+
+  refresh_3 = new Refresh (4,0,neighbor_leaf,sync_barrier,2,true);
+  refresh_3->add_field (5);
+  refresh_3->add_particle (0);
+  unit_assert (! refresh->can_merge(refresh_3));
+  delete refresh_3;
+
+  unit_func ("merge()");
+
+  refresh->merge(refresh_2);
+
+  field_list = refresh->field_list_src();
+  unit_assert (field_list.size() == 3);
+  unit_assert (find (field_list.begin(),field_list.end(),5)
+	       != field_list.end());
+  unit_assert (refresh->field_list_dst() == refresh->field_list_src());
+  unit_assert(refresh->ghost_depth() == 4);
+  unit_assert(refresh->min_face_rank() == 0);
+
+  delete refresh_2;
+
+  //--------------------------------------------------
+
   delete refresh;
 
   unit_finalize();
@@ -0,0 +1,98 @@
+// See LICENSE_CELLO file for license and copyright information
+
+/// @file      test_Scratch.cpp
+/// @author    James Bordner (jobordner@ucsd.edu)
+/// @date      2020-03-16
+/// @brief     Program implementing unit tests for the Scratch class
+
+#include "main.hpp"
+#include "test.hpp"
+
+#include "memory.hpp"
+
+PARALLEL_MAIN_BEGIN
+{
+
+  PARALLEL_INIT;
+
+  unit_init(0,1);
+
+  unit_class("Scratch");
+
+  Scratch * scratch = Scratch::instance();
+
+  unit_assert (scratch != NULL);
+
+  //----------------------------------------------------------------------
+
+  unit_func("allocate");
+
+  const size_t mark = scratch->mark();
+
+  unit_assert (mark == 0);
+
+  double * a = scratch->allocate<double>(1000);
+  int    * b = scratch->allocate<int>(10,7);
+
+  unit_assert (a != NULL && b != NULL);
+  unit_assert ((size_t)a % 64 == 0);
+  unit_assert ((size_t)b % 64 == 0);
+  unit_assert ((char *)b >= (char *)(a + 1000));
+
+  bool b_ok = true;
+  for (int i=0; i<10; i++) b_ok = b_ok && (b[i] == 7);
+  unit_assert (b_ok);
+
+  unit_assert (scratch->num_heap_allocations() == 1);
+
+  // force a second chunk
+
+  const int nc = 1 << 19;
+  float * c = scratch->allocate<float>(nc);
+  for (int i=0; i<nc; i++) c[i] = i;
+  unit_assert (c[nc-1] == float(nc-1));
+  unit_assert (scratch->num_heap_allocations() == 2);
+
+  //----------------------------------------------------------------------
+
+  unit_func("release");
+
+  scratch->release(mark);
+
+  unit_assert (scratch->mark() == 0);
+
+  // chunks combined to the high-water size
+
+  unit_assert (scratch->num_heap_allocations() == 3);
+  unit_assert (scratch->bytes_capacity() >= scratch->bytes_high());
+
+  // steady state: no more heap allocations
+
+  for (int k=0; k<10; k++) {
+    const size_t m = scratch->mark();
+    scratch->allocate<double>(1000);
+    scratch->allocate<int>(10);
+    scratch->allocate<float>(nc);
+    scratch->release(m);
+  }
+  unit_assert (scratch->num_heap_allocations() == 3);
+
+  // nested release
+
+  const size_t m1 = scratch->mark();
+  scratch->allocate<double>(100);
+  const size_t m2 = scratch->mark();
+  scratch->allocate<double>(100);
+  scratch->release(m2);
+  unit_assert (scratch->mark() == m2);
+  scratch->release(m1);
+  unit_assert (scratch->mark() == m1);
+
+  //----------------------------------------------------------------------
+
+  unit_finalize();
+
+  exit_();
+}
+
+PARALLEL_MAIN_END
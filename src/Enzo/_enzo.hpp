@@ -87,10 +87,15 @@ enum enzo_sync_id {
   enzo_sync_id_solver_bicgstab,
   enzo_sync_id_solver_bicgstab_loop_25,
   enzo_sync_id_solver_bicgstab_loop_85,
+  enzo_sync_id_solver_bicgstab_ca_0,
+  enzo_sync_id_solver_bicgstab_ca_1,
   enzo_sync_id_solver_cg,
   enzo_sync_id_solver_cg_loop_0a,
   enzo_sync_id_solver_cg_loop_0b,
   enzo_sync_id_solver_cg_loop_2a,
+  enzo_sync_id_solver_cg_pipe_0,
+  enzo_sync_id_solver_cg_pipe_1,
+  enzo_sync_id_solver_cg_precon,
   enzo_sync_id_solver_dd,
   enzo_sync_id_solver_dd_coarse,
   enzo_sync_id_solver_dd_domain,
@@ -199,6 +204,7 @@ extern "C" {
 #include "enzo_EnzoMethodCosmology.hpp"
 #include "enzo_EnzoMethodGrackle.hpp"
 #include "enzo_EnzoMethodGravity.hpp"
+#include "enzo_EnzoHydroSweep.hpp"
 #include "enzo_EnzoMethodHydro.hpp"
 #include "enzo_EnzoMethodHeat.hpp"
 #include "enzo_EnzoMethodNull.hpp"
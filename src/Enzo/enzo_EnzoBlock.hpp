@@ -233,6 +233,12 @@ public: /// entry methods
   /// EnzoSolverCg entry method
   void p_solver_cg_loop_2 () ;
 
+  /// EnzoSolverCg entry method: return from initial preconditioner
+  void p_solver_cg_precon_0 () ;
+
+  /// EnzoSolverCg entry method: return from preconditioner in loop_4
+  void p_solver_cg_loop_4 () ;
+
   /// EnzoSolverCg entry method: DOT(P,AP)
   void r_solver_cg_loop_3 (CkReductionMsg * msg) ;
 
@@ -245,6 +251,18 @@ public: /// entry methods
 
   void r_solver_cg_matvec();
 
+  /// EnzoSolverCg (pipelined) entry method: SUM(B), COUNT(B)
+  void r_solver_cg_pipe_shift (CkReductionMsg * msg);
+
+  /// EnzoSolverCg (pipelined) entry method: W = MATVEC(A,R)
+  void p_solver_cg_pipe_start ();
+
+  /// EnzoSolverCg (pipelined) entry method: DOT(R,R), DOT(W,R)
+  void r_solver_cg_pipe_dot (CkReductionMsg * msg);
+
+  /// EnzoSolverCg (pipelined) entry method: Q = MATVEC(A,W)
+  void p_solver_cg_pipe_matvec ();
+
   //--------------------------------------------------
   
   /// EnzoSolverBiCGStab entry method: SUM(B) and COUNT(B)
@@ -277,6 +295,12 @@ public: /// entry methods
   /// EnzoSolverBiCGStab entry method: ITER++
   void r_solver_bicgstab_loop_15(CkReductionMsg* msg);
 
+  /// EnzoSolverBiCGStab (s-step) entry method: refresh P_k and R_k
+  void p_solver_bicgstab_ca_powers();
+
+  /// EnzoSolverBiCGStab (s-step) entry method: Y'*Y, Y'*R0 and SUM(Y)
+  void r_solver_bicgstab_ca_gram(CkReductionMsg* msg);
+
   void p_dot_recv_parent  (int n, long double * dot_block,
 			   std::vector<int> is_array,
 			   int i_function);
@@ -71,6 +71,8 @@ EnzoConfig::EnzoConfig() throw ()
   initial_music_particle_coords(),
   initial_music_particle_types(),
   initial_music_particle_attributes(),
+  initial_music_stride_read(0),
+  initial_music_slab_max_bytes(0),
   // EnzoInitialPm
   initial_pm_field(""),
   initial_pm_mpp(0.0),
@@ -147,6 +149,8 @@ EnzoConfig::EnzoConfig() throw ()
   solver_local(),
   solver_coarse_level(),
   solver_is_unigrid(),
+  solver_pipelined(),
+  solver_s_step(),
   stopping_redshift()
 
 {
@@ -268,6 +272,8 @@ void EnzoConfig::pup (PUP::er &p)
   p | initial_music_particle_coords;
   p | initial_music_particle_types;
   p | initial_music_particle_attributes;
+  p | initial_music_stride_read;
+  p | initial_music_slab_max_bytes;
 
   p | initial_pm_field;
   p | initial_pm_mpp;
@@ -318,6 +324,8 @@ void EnzoConfig::pup (PUP::er &p)
   p | solver_local;
   p | solver_coarse_level;
   p | solver_is_unigrid;
+  p | solver_pipelined;
+  p | solver_s_step;
 
   p | stopping_redshift;
 
@@ -403,6 +411,12 @@ void EnzoConfig::read(Parameters * p) throw()
   // InitialMusic
 
   std::string name_initial = "Initial:music:";
+
+  initial_music_stride_read = p->value_integer
+    (name_initial + "stride_read",0);
+  initial_music_slab_max_bytes = p->value_integer
+    (name_initial + "slab_max_bytes",256*1024*1024);
+
   int num_files = p->list_length (name_initial + "file_list");
   for (int index_file=0; index_file<num_files; index_file++) {
     std::string file_id = name_initial +
@@ -702,6 +716,8 @@ void EnzoConfig::read(Parameters * p) throw()
   solver_local.       resize(num_solvers);
   solver_coarse_level.resize(num_solvers);
   solver_is_unigrid.resize(num_solvers);
+  solver_pipelined.resize(num_solvers);
+  solver_s_step.resize(num_solvers);
 
   for (int index_solver=0; index_solver<num_solvers; index_solver++) {
 
@@ -768,6 +784,12 @@ void EnzoConfig::read(Parameters * p) throw()
     solver_is_unigrid[index_solver] =
       p->value_logical (solver_name + ":is_unigrid",false);
 
+    solver_pipelined[index_solver] =
+      p->value_logical (solver_name + ":pipelined",false);
+
+    solver_s_step[index_solver] =
+      p->value_integer (solver_name + ":s_step",1);
+
   }
 
   //======================================================================
@@ -158,6 +158,8 @@ public: // interface
       initial_music_particle_coords(),
       initial_music_particle_types(),
       initial_music_particle_attributes(),
+      initial_music_stride_read(0),
+      initial_music_slab_max_bytes(0),
       // EnzoInitialPm
       initial_pm_field(""),
       initial_pm_mpp(0.0),
@@ -235,6 +237,8 @@ public: // interface
       solver_local(),
       solver_coarse_level(),
       solver_is_unigrid(),
+      solver_pipelined(),
+      solver_s_step(),
       // EnzoStopping
       stopping_redshift()
 
@@ -332,6 +336,9 @@ public: // attributes
   std::vector < std::string > initial_music_particle_types;
   std::vector < std::string > initial_music_particle_attributes;
 
+  int                        initial_music_stride_read;
+  int                        initial_music_slab_max_bytes;
+
   /// EnzoInitialPm
   std::string                initial_pm_field;
   double                     initial_pm_mpp;
@@ -461,6 +468,12 @@ public: // attributes
   std::vector<int>           solver_coarse_level;
   std::vector<int>           solver_is_unigrid;
 
+  /// Whether to use the pipelined single-reduction variant (cg only)
+  std::vector<int>           solver_pipelined;
+
+  /// Number of iterations per reduction in s-step variant (bicgstab only)
+  std::vector<int>           solver_s_step;
+
   /// Stop at specified redshift for cosmology
   double                     stopping_redshift;
 
@@ -39,12 +39,8 @@ CProxy_Block EnzoFactory::new_block_proxy
 {
   CProxy_EnzoBlock enzo_block_array;
 
-  //  CProxy_MappingTree array_map  = CProxy_MappingTree::ckNew(nbx,nby,nbz);
-  CProxy_MappingArray array_map  = CProxy_MappingArray::ckNew(nbx,nby,nbz);
-
-
   CkArrayOptions opts;
-  opts.setMap(array_map);
+  opts.setMap(new_block_map(nbx,nby,nbz));
   TRACE_CHARM("ckNew(nbx,nby,nbz)");
   enzo_block_array = CProxy_EnzoBlock::ckNew(opts);
 
@@ -130,11 +126,8 @@ void EnzoFactory::create_subblock_array
     if (nby > 1) nby = ceil(0.5*nby);
     if (nbz > 1) nbz = ceil(0.5*nbz);
 
-    // CProxy_MappingTree array_map  = CProxy_MappingTree::ckNew(nbx,nby,nbz);
-    CProxy_MappingArray array_map  = CProxy_MappingArray::ckNew(nbx,nby,nbz);
-
     CkArrayOptions opts;
-    opts.setMap(array_map);
+    opts.setMap(new_block_map(nbx,nby,nbz));
     TRACE_CHARM("ckNew(nbx,nby,nbz)");
 
     int count_adapt;
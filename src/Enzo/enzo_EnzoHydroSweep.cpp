@@ -0,0 +1,1693 @@
+// See LICENSE_CELLO file for license and copyright information
+
+/// @file     enzo_EnzoHydroSweep.cpp
+/// @author   James Bordner (jobordner@ucsd.edu)
+/// @date     2020-03-18
+/// @brief    Implementation of directional PPM sweeps over pencil tiles
+///
+/// Each function corresponds to one of Enzo's Fortran PPM routines,
+/// with the slice index j replaced by the pencil index p.  Loops are
+/// over the tile index k = i*num_pencils + p, so that neighbors along
+/// the sweep axis are at k +/- num_pencils.  Cell widths are uniform
+/// in Cello, so the Fortran dx(i) arrays reduce to scalars.
+
+#include "cello.hpp"
+#include "enzo.hpp"
+
+// Small values from fortran_types.h, enzo_defines.hpp, and euler.F
+
+const enzo_float sweep_tiny        = 1.0e-20;
+const enzo_float sweep_color_floor = 1.0e-35;
+const enzo_float sweep_min_color   = 1.0e-5*sweep_tiny;
+
+// Newton iterations and tolerance in twoshock.F
+
+const int sweep_twoshock_iterations = 8;
+#ifdef CONFIG_PRECISION_SINGLE
+const enzo_float sweep_twoshock_tolerance = 1.0e-7;
+#else
+const enzo_float sweep_twoshock_tolerance = 1.0e-14;
+#endif
+
+//----------------------------------------------------------------------
+
+struct EnzoHydroSweep::Interface {
+  enzo_float * la;
+  enzo_float * ra;
+  enzo_float * l0;
+  enzo_float * r0;
+};
+
+//----------------------------------------------------------------------
+
+struct EnzoHydroSweep::Tile {
+
+  /// Pencil length and first and last active cell
+  int m, i1, i2;
+
+  /// Number of color fields
+  int nc;
+
+  /// Time step, cell width, and dt / h
+  enzo_float dt, h, qc;
+
+  /// Interpolation coefficients (inteuler)
+  enzo_float c1, c2, c3, c4, c5, c6, dx2i, dxdt2;
+
+  /// Transverse velocity difference coefficients (calcdiss)
+  enzo_float coef_v, coef_w;
+  bool use_v, use_w;
+
+  /// Cell values (u is the velocity along the sweep axis)
+  enzo_float *d, *e, *u, *v, *w, *ge, *gr, **c;
+
+  /// Pressure, shock flag, flattening, and diffusion
+  enzo_float *p, *wflag, *flattemp, *flatten, *diffcoef, *vdiff, *wdiff;
+
+  /// Steepening and characteristic speeds
+  enzo_float *steepen, *d2d, *cs, *char1, *char2, *cm, *c0, *cp;
+
+  /// Interpolation slopes, face values, and curvature
+  enzo_float *dd, *dl, *dr, *d6;
+  enzo_float *dp, *pl, *pr, *p6;
+  enzo_float *du, *ul, *ur, *u6;
+  enzo_float *dv, *vl, *vr, *v6;
+  enzo_float *dw, *wl, *wr, *w6;
+  enzo_float *dq, *ql, *qr, *q6;
+
+  /// Averages over domains of dependence
+  Interface da, pa, ua, va, wa, gea, *ca;
+
+  /// Left and right states at faces
+  enzo_float *dls, *drs, *pls, *prs, *uls, *urs;
+  enzo_float *vls, *vrs, *wls, *wrs, *gels, *gers, **colls, **colrs;
+
+  /// Riemann solution at faces
+  enzo_float *pbar, *ubar;
+
+  /// twoshock iteration
+  enzo_float *cl, *cr, *ps, *old_ps, *zl, *zr, *ubl, *ubr, *dpdul, *dpdur;
+  int * mask;
+
+  /// Fluxes, and gas energy source term at cells
+  enzo_float *df, *ef, *uf, *vf, *wf, *gef, *ges, **colf;
+
+  /// Face density and velocity (two-shock), or weights and left and
+  /// right advection speeds (HLL and HLLC)
+  enzo_float *db, *ub, *sl, *sr, *fl, *fr;
+};
+
+//----------------------------------------------------------------------
+
+EnzoHydroSweep::EnzoHydroSweep
+(enzo_float gamma,
+ int gravity,
+ int dual_energy,
+ enzo_float dual_energy_eta1,
+ enzo_float dual_energy_eta2,
+ int reconstruct_conservative,
+ int reconstruct_positive,
+ enzo_float density_floor,
+ enzo_float pressure_floor,
+ int pressure_free,
+ int diffusion,
+ int flattening,
+ int steepening,
+ int riemann_solver) throw()
+  : gamma_(gamma),
+    gravity_(gravity),
+    dual_energy_(dual_energy),
+    dual_energy_eta1_(dual_energy_eta1),
+    dual_energy_eta2_(dual_energy_eta2),
+    reconstruct_conservative_(reconstruct_conservative),
+    reconstruct_positive_(reconstruct_positive),
+    density_floor_(density_floor),
+    pressure_floor_(pressure_floor),
+    pressure_free_(pressure_free),
+    diffusion_(diffusion),
+    flattening_(flattening),
+    steepening_(steepening),
+    riemann_solver_(riemann_solver)
+{
+  ASSERT1 ("EnzoHydroSweep::EnzoHydroSweep()",
+	   "Unsupported PPM diffusion parameter %d",
+	   diffusion, (diffusion == 0 || diffusion == 1));
+  ASSERT1 ("EnzoHydroSweep::EnzoHydroSweep()",
+	   "Unsupported PPM flattening parameter %d",
+	   flattening, (0 <= flattening && flattening <= 3));
+}
+
+//----------------------------------------------------------------------
+
+void EnzoHydroSweep::sweep
+(int axis, enzo_float dt, const enzo_float h3[3],
+ const int m3[3], const int g3[3], const int n3[3],
+ enzo_float * d, enzo_float * e, enzo_float * ge,
+ enzo_float * v3[3], enzo_float * a,
+ int nc, enzo_float ** c) const throw()
+{
+  ASSERT1 ("EnzoHydroSweep::sweep()",
+	   "PPM requires at least 3 ghost zones along the sweep axis, not %d",
+	   g3[axis], g3[axis] >= 3);
+  ASSERT ("EnzoHydroSweep::sweep()",
+	  "Missing internal energy with dual energy formalism",
+	  ! (dual_energy_ && ge == NULL));
+  ASSERT ("EnzoHydroSweep::sweep()",
+	  "Missing acceleration with gravity",
+	  ! (gravity_ && a == NULL));
+
+  const int np = num_pencils;
+
+  // Velocity components along and transverse to the sweep axis
+
+  const int t1 = (axis + 1) % 3;
+  const int t2 = (axis + 2) % 3;
+
+  // Tiles are formed from pencils adjacent along axis ia, and
+  // "slices" of tiles are ordered along axis ib.  Diffusion couples
+  // neighboring pencils, so it requires the slice order of the
+  // Fortran sweeps (ia = t1, ib = t2) to give the same result.
+  // Otherwise tiles are formed along x when possible so that gathers
+  // are contiguous.
+
+  const int ia = (diffusion_ || axis == 0) ? t1 : 0;
+  const int ib = 3 - axis - ia;
+
+  const int s3[3] = { 1, m3[0], m3[0]*m3[1] };
+
+  const int m  = m3[axis];
+  const int s  = s3[axis];
+
+  Scratch * scratch = Scratch::instance();
+  const size_t scratch_mark = scratch->mark();
+
+  Tile t;
+
+  allocate_tile_ (t, m, nc);
+
+  t.i1 = g3[axis];
+  t.i2 = g3[axis] + n3[axis] - 1;
+  t.dt = dt;
+
+  // Coefficients for uniform cell widths, in the order of operations
+  // of inteuler.F and calcdiss.F
+
+  const enzo_float h = h3[axis];
+
+  t.h  = h;
+  t.qc = dt/h;
+  {
+    enzo_float qa = h/(h + h + h);
+    t.c1 = qa*(2.0*h + h)/(h + h);
+    t.c2 = qa*(2.0*h + h)/(h + h);
+    qa = h + h + h + h;
+    enzo_float qb = h/(h + h);
+    const enzo_float qc = (h + h)/(2.0*h + h);
+    const enzo_float qd = (h + h)/(2.0*h + h);
+    qb = qb + 2.0*h*qb/qa*(qc-qd);
+    t.c3 = 1.0 - qb;
+    t.c4 = qb;
+    t.c5 =  h/qa*qd;
+    t.c6 = -h/qa*qc;
+    t.dx2i = 0.5/h;
+    t.dxdt2 = 0.5*dt/h;
+  }
+
+  const enzo_float h1 = h3[t1];
+  const enzo_float h2 = h3[t2];
+  t.coef_v = (0.25*(h + h)) / (0.5*(h1 + h1) + h1);
+  t.coef_w = (0.25*(h + h)) / (0.5*(h2 + h2) + h2);
+  t.use_v = (m3[t1] > 1);
+  t.use_w = (n3[t2] > 1);
+
+  enzo_float * vt1 = v3[t1];
+  enzo_float * vt2 = v3[t2];
+
+  // Diffusion uses transverse velocities of neighboring pencils in
+  // the same slice before they are updated
+
+  enzo_float * v_slice = (diffusion_ == 1) ?
+    scratch->allocate<enzo_float>(m*m3[t1]) : NULL;
+
+  int offset[np];
+  int index_a[np];
+
+  for (int jb=0; jb<m3[ib]; jb++) {
+
+    if (v_slice) {
+      for (int j=0; j<m3[t1]; j++) {
+	const int o = j*s3[t1] + jb*s3[ib];
+	for (int i=0; i<m; i++) v_slice[i+m*j] = vt1[o+i*s];
+      }
+    }
+
+    for (int ja0=0; ja0<m3[ia]; ja0+=np) {
+
+      // Pencils past the end of the block duplicate the last one
+
+      const int num_valid = std::min(np, m3[ia]-ja0);
+      for (int ip=0; ip<np; ip++) {
+	index_a[ip] = ja0 + std::min(ip,num_valid-1);
+	offset[ip]  = index_a[ip]*s3[ia] + jb*s3[ib];
+      }
+
+      // Gather pencils into the tile
+
+      for (int i=0; i<m; i++) {
+	for (int ip=0; ip<np; ip++) {
+	  const int k = i*np + ip;
+	  const int o = offset[ip] + i*s;
+	  t.d[k] = d[o];
+	  t.e[k] = e[o];
+	  t.u[k] = v3[axis][o];
+	  t.v[k] = vt1[o];
+	  t.w[k] = vt2[o];
+	}
+      }
+      if (dual_energy_) {
+	for (int i=0; i<m; i++) {
+	  for (int ip=0; ip<np; ip++) t.ge[i*np+ip] = ge[offset[ip]+i*s];
+	}
+      }
+      if (gravity_) {
+	for (int i=0; i<m; i++) {
+	  for (int ip=0; ip<np; ip++) t.gr[i*np+ip] = a[offset[ip]+i*s];
+	}
+      }
+      for (int ic=0; ic<nc; ic++) {
+	for (int i=0; i<m; i++) {
+	  for (int ip=0; ip<np; ip++) t.c[ic][i*np+ip] = c[ic][offset[ip]+i*s];
+	}
+      }
+
+      // Transverse velocity differences for diffusion (calcdiss.F)
+
+      if (diffusion_ == 1) {
+	for (int ip=0; ip<np; ip++) {
+	  const int j = index_a[ip];
+	  const bool ok_v = (m3[t1] > 1 && 0 < j && j < m3[t1]-1);
+	  const bool ok_w = (m3[t2] > 1 && 0 < jb && jb < m3[t2]-1);
+	  const int om = j*s3[t1] + (jb-1)*s3[t2];
+	  const int op = j*s3[t1] + (jb+1)*s3[t2];
+	  for (int i=t.i1; i<=t.i2+1; i++) {
+	    const int k = i*np + ip;
+	    t.vdiff[k] = ok_v ?
+	      ((v_slice[i+m*(j-1)] + v_slice[i-1+m*(j-1)])
+	       - (v_slice[i+m*(j+1)] + v_slice[i-1+m*(j+1)])) : 0.0;
+	    t.wdiff[k] = ok_w ?
+	      ((vt2[om+i*s] + vt2[om+(i-1)*s])
+	       - (vt2[op+i*s] + vt2[op+(i-1)*s])) : 0.0;
+	  }
+	}
+      }
+
+      // Update the tile
+
+      pgas_ (t);
+
+      if (diffusion_ || flattening_) calcdiss_ (t);
+
+      inteuler_ (t);
+
+      if (riemann_solver_ == riemann_hll) {
+	flux_hll_ (t);
+      } else if (riemann_solver_ == riemann_hllc) {
+	flux_hllc_ (t);
+      } else {
+	twoshock_ (t);
+	flux_twoshock_ (t);
+      }
+
+      euler_ (t);
+
+      if (dual_energy_) pgas_ (t);
+
+      // Scatter whole pencils back, since pgas_() with dual energy
+      // also updates the energies in ghost zones
+
+      for (int i=0; i<m; i++) {
+	for (int ip=0; ip<num_valid; ip++) {
+	  const int k = i*np + ip;
+	  const int o = offset[ip] + i*s;
+	  d[o]        = t.d[k];
+	  e[o]        = t.e[k];
+	  v3[axis][o] = t.u[k];
+	  vt1[o]      = t.v[k];
+	  vt2[o]      = t.w[k];
+	}
+      }
+      if (dual_energy_) {
+	for (int i=0; i<m; i++) {
+	  for (int ip=0; ip<num_valid; ip++) ge[offset[ip]+i*s] = t.ge[i*np+ip];
+	}
+      }
+      for (int ic=0; ic<nc; ic++) {
+	for (int i=0; i<m; i++) {
+	  for (int ip=0; ip<num_valid; ip++) c[ic][offset[ip]+i*s] = t.c[ic][i*np+ip];
+	}
+      }
+    }
+  }
+
+  scratch->release(scratch_mark);
+}
+
+//----------------------------------------------------------------------
+
+void EnzoHydroSweep::allocate_tile_ (Tile & t, int m, int nc) const throw()
+{
+  Scratch * scratch = Scratch::instance();
+
+  const int n = m*num_pencils;
+
+  t.m  = m;
+  t.nc = nc;
+
+  enzo_float ** arrays[] = {
+    &t.d, &t.e, &t.u, &t.v, &t.w, &t.ge, &t.gr,
+    &t.p, &t.wflag, &t.flattemp, &t.flatten, &t.diffcoef, &t.vdiff, &t.wdiff,
+    &t.steepen, &t.d2d, &t.cs, &t.char1, &t.char2, &t.cm, &t.c0, &t.cp,
+    &t.dd, &t.dl, &t.dr, &t.d6,   &t.dp, &t.pl, &t.pr, &t.p6,
+    &t.du, &t.ul, &t.ur, &t.u6,   &t.dv, &t.vl, &t.vr, &t.v6,
+    &t.dw, &t.wl, &t.wr, &t.w6,   &t.dq, &t.ql, &t.qr, &t.q6,
+    &t.da.la,  &t.da.ra,  &t.da.l0,  &t.da.r0,
+    &t.pa.la,  &t.pa.ra,  &t.pa.l0,  &t.pa.r0,
+    &t.ua.la,  &t.ua.ra,  &t.ua.l0,  &t.ua.r0,
+    &t.va.la,  &t.va.ra,  &t.va.l0,  &t.va.r0,
+    &t.wa.la,  &t.wa.ra,  &t.wa.l0,  &t.wa.r0,
+    &t.gea.la, &t.gea.ra, &t.gea.l0, &t.gea.r0,
+    &t.dls, &t.drs, &t.pls, &t.prs, &t.uls, &t.urs,
+    &t.vls, &t.vrs, &t.wls, &t.wrs, &t.gels, &t.gers,
+    &t.pbar, &t.ubar,
+    &t.cl, &t.cr, &t.ps, &t.old_ps, &t.zl, &t.zr,
+    &t.ubl, &t.ubr, &t.dpdul, &t.dpdur,
+    &t.df, &t.ef, &t.uf, &t.vf, &t.wf, &t.gef, &t.ges,
+    &t.db, &t.ub, &t.sl, &t.sr, &t.fl, &t.fr
+  };
+  const int num_arrays = sizeof(arrays) / sizeof(arrays[0]);
+
+  for (int i=0; i<num_arrays; i++) {
+    *arrays[i] = scratch->allocate<enzo_float>(n);
+  }
+
+  t.mask = scratch->allocate<int>(n);
+
+  t.c     = scratch->allocate<enzo_float *>(nc);
+  t.colls = scratch->allocate<enzo_float *>(nc);
+  t.colrs = scratch->allocate<enzo_float *>(nc);
+  t.colf  = scratch->allocate<enzo_float *>(nc);
+  t.ca    = scratch->allocate<Interface>(nc);
+  for (int ic=0; ic<nc; ic++) {
+    t.c[ic]     = scratch->allocate<enzo_float>(n);
+    t.colls[ic] = scratch->allocate<enzo_float>(n);
+    t.colrs[ic] = scratch->allocate<enzo_float>(n);
+    t.colf[ic]  = scratch->allocate<enzo_float>(n);
+    t.ca[ic].la = scratch->allocate<enzo_float>(n);
+    t.ca[ic].ra = scratch->allocate<enzo_float>(n);
+    t.ca[ic].l0 = scratch->allocate<enzo_float>(n);
+    t.ca[ic].r0 = scratch->allocate<enzo_float>(n);
+  }
+}
+
+//----------------------------------------------------------------------
+
+void EnzoHydroSweep::pgas_ (Tile & t) const throw()
+{
+  const int np = num_pencils;
+  const int ilo = t.i1 - 3;
+  const int ihi = t.i2 + 3;
+
+  const enzo_float * d = t.d;
+  const enzo_float * u = t.u;
+  const enzo_float * v = t.v;
+  const enzo_float * w = t.w;
+  enzo_float * e = t.e;
+  enzo_float * p = t.p;
+
+  if (! dual_energy_) {
+
+    // pgas2d.F
+
+    for (int k=ilo*np; k<(ihi+1)*np; k++) {
+      p[k] = (gamma_ - 1.0)*d[k]*(e[k] - 0.5*(u[k]*u[k] + v[k]*v[k] + w[k]*w[k]));
+      if (p[k] < pressure_floor_) p[k] = pressure_floor_;
+    }
+
+  } else {
+
+    // pgas2d_dual.F: the maximum energy density uses the total energy
+    // of cell i-1 after it is updated, so loop over i sequentially
+
+    enzo_float * ge = t.ge;
+
+    for (int i=ilo; i<=ihi; i++) {
+      const int km0 = std::max(i-1,ilo)*np;
+      const int kp0 = std::min(i+1,ihi)*np;
+      for (int ip=0; ip<np; ip++) {
+	const int k  = i*np + ip;
+	const int km = km0 + ip;
+	const int kp = kp0 + ip;
+	const enzo_float ke = 0.5*(u[k]*u[k] + v[k]*v[k] + w[k]*w[k]);
+	const enzo_float ge1 = e[k] - ke;
+	const enzo_float demax = std::max(std::max(d[k]*e[k], d[km]*e[km]),
+					  d[kp]*e[kp]);
+	if (ge1*d[k]/demax > dual_energy_eta2_) ge[k] = ge1;
+	enzo_float ge2 = (ge1/e[k] > dual_energy_eta1_) ? ge1 : ge[k];
+	ge2 = std::max(ge2, (enzo_float)(pressure_floor_/((gamma_ - 1.0)*d[k])));
+	e[k] = e[k] - ge1 + ge2;
+	p[k] = (gamma_ - 1.0)*d[k]*ge2;
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+
+void EnzoHydroSweep::calcdiss_ (Tile & t) const throw()
+{
+  const int np = num_pencils;
+  const int i1 = t.i1;
+  const int i2 = t.i2;
+
+  const enzo_float * d = t.d;
+  const enzo_float * e = t.e;
+  const enzo_float * u = t.u;
+  const enzo_float * p = t.p;
+  enzo_float * wflag    = t.wflag;
+  enzo_float * flattemp = t.flattemp;
+
+  const enzo_float epsilon = 0.33;
+  const enzo_float kappa1  = 2.0;
+  const enzo_float kappa2  = 0.01;
+  const enzo_float Kparam  = 0.1;
+  const enzo_float omega1  = 0.75;
+  const enzo_float omega2  = 10.0;
+  const enzo_float sigma1  = 0.5;
+  const enzo_float sigma2  = 1.0;
+
+  // Shock flag
+
+  for (int k=(i1-2)*np; k<(i2+3)*np; k++) {
+    const enzo_float qb = fabs(p[k+np] - p[k-np]) / std::min(p[k+np], p[k-np]);
+    wflag[k] = (qb > epsilon && u[k-np] > u[k+np]) ? 1.0 : 0.0;
+  }
+
+  // Diffusion coefficient
+
+  if (diffusion_ == 1) {
+    for (int k=i1*np; k<(i2+2)*np; k++) {
+      enzo_float diffcoef = u[k-np] - u[k];
+      if (t.use_v) diffcoef = diffcoef + t.coef_v*t.vdiff[k];
+      if (t.use_w) diffcoef = diffcoef + t.coef_w*t.wdiff[k];
+      t.diffcoef[k] = Kparam*std::max(enzo_float(0.0), diffcoef);
+    }
+  }
+
+  if (flattening_ == 0) return;
+
+  // Flattening coefficient
+
+  if (flattening_ == 1) {
+
+    for (int k=(i1-1)*np; k<(i2+2)*np; k++) {
+      enzo_float qa;
+      if (fabs(p[k+2*np] - p[k-2*np])/std::min(p[k+2*np],p[k-2*np]) < epsilon) {
+	qa = 1.0;
+      } else {
+	qa = (p[k+np] - p[k-np]) / (p[k+2*np] - p[k-2*np]);
+      }
+      flattemp[k] = std::min(enzo_float(1.0), (qa-omega1)*omega2*wflag[k]);
+      flattemp[k] = std::max(enzo_float(0.0), flattemp[k]);
+    }
+
+  } else if (flattening_ == 2) {
+
+    for (int k=(i1-1)*np; k<(i2+2)*np; k++) {
+      const enzo_float dp1 = p[k+np] - p[k-np];
+      const int ks = k + ((dp1 >= 0.0) ? 2*np : -2*np);
+      const enzo_float omega = std::max
+	(enzo_float(0.0), omega1*(omega2 - dp1/(p[k+2*np] - p[k-2*np])));
+      const enzo_float Z = sqrt
+	((std::max(p[k+2*np],p[k-2*np]) +
+	  0.5*(p[k+2*np]+p[k-2*np])*(gamma_-1.0))
+	 / std::max(enzo_float(1.0)/d[k+2*np],enzo_float(1.0)/d[k-2*np]));
+      const enzo_float kappa_tilde = (Z + sqrt(gamma_*p[ks]*d[ks])) / Z;
+      const enzo_float kappa = std::max
+	(enzo_float(0.0), (kappa_tilde - kappa1)/(kappa_tilde + kappa2));
+      flattemp[k] = std::min(wflag[k]*omega, kappa);
+    }
+
+  } else if (flattening_ == 3) {
+
+    for (int k=(i1-1)*np; k<(i2+2)*np; k++) {
+      const enzo_float dp1 = p[k+np] - p[k-np];
+      const enzo_float dp2 = p[k+2*np] - p[k-2*np];
+      const enzo_float de1 = e[k+np] - e[k-np];
+      const enzo_float de2 = e[k+2*np] - e[k-2*np];
+      const enzo_float dpp = (dp2 != 0.0) ? dp1/dp2 : 0.0;
+      const enzo_float dee = (de2 != 0.0) ? de1/de2 : 0.0;
+      const enzo_float omega_tilde = std::max(dpp, dee);
+      // post-shock (ism) and upstream (isp) zones
+      const int is2 = (dp1 >= 0.0) ? 2*np : -2*np;
+      const int kism = k + is2;
+      const int kisp = k - is2;
+      enzo_float s = (dp1 >= 0.0) ? -1.0 : 1.0;
+      if (dp1 == 0.0) s = 0.0;
+      const enzo_float sigma_tilde =
+	wflag[k]*fabs(dp2)/std::min(p[k+2*np],p[k-2*np]);
+      const enzo_float sigma = std::max
+	(enzo_float(0.0), (sigma_tilde - sigma1)/(sigma_tilde + sigma2));
+      const enzo_float omega = std::max
+	(enzo_float(0.0), omega2*(omega_tilde - omega1));
+      const enzo_float Z = sqrt
+	((std::max(p[k+2*np],p[k-2*np]) +
+	  0.5*(p[k+2*np]+p[k-2*np])*(gamma_-1.0))
+	 / std::max(enzo_float(1.0)/d[k+2*np],enzo_float(1.0)/d[k-2*np]));
+      const enzo_float ZE = s*Z/d[kism] + u[kism] + sweep_tiny;
+      const enzo_float cj2s = sqrt(gamma_*p[kisp]/d[kisp]);
+      const enzo_float kappa_tilde = fabs((ZE - u[kisp] + s*cj2s)/ZE);
+      const enzo_float kappa = std::max
+	(enzo_float(0.0), (kappa_tilde - kappa1)/(kappa_tilde + kappa2));
+      flattemp[k] = std::min(std::min(kappa, wflag[k]*omega),
+			     wflag[k]*sigma);
+    }
+  }
+
+  for (int ip=0; ip<np; ip++) {
+    flattemp[(i1-2)*np+ip] = flattemp[(i1-1)*np+ip];
+    flattemp[(i2+2)*np+ip] = flattemp[(i2+1)*np+ip];
+  }
+
+  for (int k=(i1-1)*np; k<(i2+2)*np; k++) {
+    t.flatten[k] = (p[k+np] - p[k-np] < 0.0) ?
+      std::max(flattemp[k],flattemp[k+np]) :
+      std::max(flattemp[k],flattemp[k-np]);
+  }
+}
+
+//----------------------------------------------------------------------
+
+void EnzoHydroSweep::inteuler_ (Tile & t) const throw()
+{
+  const int np = num_pencils;
+  const int i1 = t.i1;
+  const int i2 = t.i2;
+  const enzo_float dt = t.dt;
+  const enzo_float ft = enzo_float(4.0)/enzo_float(3.0);
+
+  const enzo_float * d = t.d;
+  const enzo_float * p = t.p;
+  const enzo_float * u = t.u;
+
+  // Steepening coefficients
+
+  if (steepening_) {
+    const enzo_float h = t.h;
+    const enzo_float qa = h + h + h;
+    const enzo_float dxb = 0.5*(h + h);
+    const enzo_float dxb3 = dxb*dxb*dxb;
+    for (int k=(i1-2)*np; k<(i2+3)*np; k++) {
+      const enzo_float d2d = (d[k+np] - d[k])/(h + h);
+      t.d2d[k] = (d2d - (d[k]-d[k-np])/(h + h))/qa;
+    }
+    for (int k=(i1-1)*np; k<(i2+2)*np; k++) {
+      const enzo_float qc = fabs(d[k+np] - d[k-np])
+	- 0.01*std::min(fabs(d[k+np]),fabs(d[k-np]));
+      enzo_float s1 = (t.d2d[k-np] - t.d2d[k+np])*(dxb3 + dxb3)
+	/((dxb + dxb)*(d[k+np] - d[k-np] + sweep_tiny));
+      if (t.d2d[k+np]*t.d2d[k-np] > 0.0) s1 = 0.0;
+      if (qc <= 0.0) s1 = 0.0;
+      const enzo_float s2 = std::max
+	(enzo_float(0.0), std::min(enzo_float(20.0)*(s1-enzo_float(0.05)),
+				   enzo_float(1.0)));
+      const enzo_float qa = fabs(d[k+np] - d[k-np])/std::min(d[k+np],d[k-np]);
+      const enzo_float qb = fabs(p[k+np] - p[k-np])/std::min(p[k+np],p[k-np]);
+      t.steepen[k] = (gamma_*0.1*qa >= qb) ? s2 : 0.0;
+    }
+  }
+
+  // Sound speeds and characteristic distances
+
+  for (int k=(i1-3)*np; k<(i2+4)*np; k++) {
+    enzo_float cs = sqrt(gamma_*p[k]/d[k]);
+    if (pressure_free_ == 1) cs = sweep_tiny;
+    t.cs[k] = cs;
+    t.char1[k] = std::max(enzo_float(0.0), dt*(u[k]+cs))*t.dx2i;
+    t.char2[k] = std::max(enzo_float(0.0),-dt*(u[k]-cs))*t.dx2i;
+    t.cm[k] = dt*(u[k]-cs)*t.dx2i;
+    t.c0[k] = dt*(u[k]   )*t.dx2i;
+    t.cp[k] = dt*(u[k]+cs)*t.dx2i;
+  }
+
+  // Interpolate
+
+  if (reconstruct_conservative_) {
+    intprim_ (t);
+  } else {
+    intvar_ (t, t.d, steepening_, t.dd, t.dl, t.dr, t.d6, t.da);
+    intvar_ (t, t.p, 0, t.dp, t.pl, t.pr, t.p6, t.pa);
+    intvar_ (t, t.u, 0, t.du, t.ul, t.ur, t.u6, t.ua);
+    intvar_ (t, t.v, 0, t.dv, t.vl, t.vr, t.v6, t.va);
+    intvar_ (t, t.w, 0, t.dw, t.wl, t.wr, t.w6, t.wa);
+    if (reconstruct_positive_) intpos_ (t);
+  }
+
+  if (dual_energy_) {
+    intvar_ (t, t.ge, 0, t.dq, t.ql, t.qr, t.q6, t.gea);
+  }
+  for (int ic=0; ic<t.nc; ic++) {
+    intvar_ (t, t.c[ic], 0, t.dq, t.ql, t.qr, t.q6, t.ca[ic]);
+  }
+
+  // Correct the averages for characteristics that do not reach
+  // the face
+
+  const enzo_float * cm = t.cm;
+  const enzo_float * c0 = t.c0;
+  const enzo_float * cp = t.cp;
+  const enzo_float * dp = t.dp;
+  const enzo_float * pl = t.pl;
+  const enzo_float * pr = t.pr;
+  const enzo_float * p6 = t.p6;
+  const enzo_float * du = t.du;
+  const enzo_float * ul = t.ul;
+  const enzo_float * ur = t.ur;
+  const enzo_float * u6 = t.u6;
+
+  for (int k=i1*np; k<(i2+2)*np; k++) {
+
+    const int km = k - np;
+
+    const enzo_float plm = pr[km]-cm[km]*(dp[km]-(1.0-ft*cm[km])*p6[km]);
+    const enzo_float prm = pl[k ]-cm[k ]*(dp[k ]+(1.0+ft*cm[k ])*p6[k ]);
+    const enzo_float plp = pr[km]-cp[km]*(dp[km]-(1.0-ft*cp[km])*p6[km]);
+    const enzo_float prp = pl[k ]-cp[k ]*(dp[k ]+(1.0+ft*cp[k ])*p6[k ]);
+    const enzo_float ulm = ur[km]-cm[km]*(du[km]-(1.0-ft*cm[km])*u6[km]);
+    const enzo_float urm = ul[k ]-cm[k ]*(du[k ]+(1.0+ft*cm[k ])*u6[k ]);
+    const enzo_float ulp = ur[km]-cp[km]*(du[km]-(1.0-ft*cp[km])*u6[km]);
+    const enzo_float urp = ul[k ]-cp[k ]*(du[k ]+(1.0+ft*cp[k ])*u6[k ]);
+
+    const enzo_float dla = t.da.la[k], dra = t.da.ra[k];
+    const enzo_float dl0 = t.da.l0[k], dr0 = t.da.r0[k];
+    const enzo_float pla = t.pa.la[k], pra = t.pa.ra[k];
+    const enzo_float pl0 = t.pa.l0[k], pr0 = t.pa.r0[k];
+    const enzo_float ula = t.ua.la[k], ura = t.ua.ra[k];
+
+    const enzo_float cla = sqrt(std::max(gamma_*pla*dla, enzo_float(0.0)));
+    const enzo_float cra = sqrt(std::max(gamma_*pra*dra, enzo_float(0.0)));
+
+    enzo_float f1 = 1.0/cla;
+    enzo_float betalp = (ula-ulp) + (pla-plp)*f1;
+    enzo_float betalm = (ula-ulm) - (pla-plm)*f1;
+    enzo_float betal0 = (pla-pl0)*(f1*f1) + 1.0/dla - 1.0/dl0;
+    if (gravity_) {
+      betalp = betalp - 0.25*dt*(t.gr[km] + t.gr[k]);
+      betalm = betalm - 0.25*dt*(t.gr[km] + t.gr[k]);
+    }
+    f1 = 0.5/cla;
+    betalp = -betalp*f1;
+    betalm = +betalm*f1;
+    if (cp[km] <= 0.0) betalp = 0.0;
+    if (cm[km] <= 0.0) betalm = 0.0;
+    if (c0[km] <= 0.0) betal0 = 0.0;
+
+    f1 = 1.0/cra;
+    enzo_float betarp = (ura-urp) + (pra-prp)*f1;
+    enzo_float betarm = (ura-urm) - (pra-prm)*f1;
+    enzo_float betar0 = (pra-pr0)*(f1*f1) + 1.0/dra - 1.0/dr0;
+    if (gravity_) {
+      betarp = betarp - 0.25*dt*(t.gr[km] + t.gr[k]);
+      betarm = betarm - 0.25*dt*(t.gr[km] + t.gr[k]);
+    }
+    f1 = 0.5/cra;
+    betarp = -betarp*f1;
+    betarm = +betarm*f1;
+    if (cp[k] >= 0.0) betarp = 0.0;
+    if (cm[k] >= 0.0) betarm = 0.0;
+    if (c0[k] >= 0.0) betar0 = 0.0;
+
+    t.pls[k] = pla + (betalp+betalm)*(cla*cla);
+    t.prs[k] = pra + (betarp+betarm)*(cra*cra);
+    t.uls[k] = ula + (betalp-betalm)*cla;
+    t.urs[k] = ura + (betarp-betarm)*cra;
+    t.dls[k] = 1.0/(1.0/dla - (betal0+betalp+betalm));
+    t.drs[k] = 1.0/(1.0/dra - (betar0+betarp+betarm));
+
+    // Transverse velocities and gas energy are advected
+
+    if (u[km] <= 0.0) {
+      t.vls[k] = t.va.la[k];
+      t.wls[k] = t.wa.la[k];
+    } else {
+      t.vls[k] = t.va.l0[k];
+      t.wls[k] = t.wa.l0[k];
+    }
+    if (u[k] >= 0.0) {
+      t.vrs[k] = t.va.ra[k];
+      t.wrs[k] = t.wa.ra[k];
+    } else {
+      t.vrs[k] = t.va.r0[k];
+      t.wrs[k] = t.wa.r0[k];
+    }
+  }
+
+  if (dual_energy_) {
+    for (int k=i1*np; k<(i2+2)*np; k++) {
+      t.gels[k] = (u[k-np] <= 0.0) ? t.gea.la[k] : t.gea.l0[k];
+      t.gers[k] = (u[k]    >= 0.0) ? t.gea.ra[k] : t.gea.r0[k];
+    }
+  }
+
+  for (int ic=0; ic<t.nc; ic++) {
+    const Interface & ca = t.ca[ic];
+    enzo_float * colls = t.colls[ic];
+    enzo_float * colrs = t.colrs[ic];
+    for (int k=i1*np; k<(i2+2)*np; k++) {
+      colls[k] = (u[k-np] <= 0.0) ?
+	ca.la[k] * t.dls[k]/t.da.la[k] : ca.l0[k] * t.dls[k]/t.da.l0[k];
+      colrs[k] = (u[k] >= 0.0) ?
+	ca.ra[k] * t.drs[k]/t.da.ra[k] : ca.r0[k] * t.drs[k]/t.da.r0[k];
+    }
+  }
+
+  // Revert to the averages where the dual energy formalism would
+  // be inaccurate
+
+  if (dual_energy_) {
+    const enzo_float eta2 = dual_energy_eta2_;
+    for (int k=i1*np; k<(i2+2)*np; k++) {
+      const int km = k - np;
+      const enzo_float dla = t.da.la[k], dra = t.da.ra[k];
+      const enzo_float pla = t.pa.la[k], pra = t.pa.ra[k];
+      const enzo_float ula = t.ua.la[k], ura = t.ua.ra[k];
+      if (gamma_*pla/dla < eta2*(ula*ula) ||
+	  std::max(std::max(fabs(cm[km]),fabs(c0[km])),fabs(cp[km])) < 1.0e-3 ||
+	  t.dls[k]/dla > 5.0) {
+	for (int ic=0; ic<t.nc; ic++) {
+	  t.colls[ic][k] = t.colls[ic][k] * dla/t.dls[k];
+	}
+	t.pls[k] = pla;
+	t.uls[k] = ula;
+	t.dls[k] = dla;
+      }
+      if (gamma_*pra/dra < eta2*(ura*ura) ||
+	  std::max(std::max(fabs(cm[k]),fabs(c0[k])),fabs(cp[k])) < 1.0e-3 ||
+	  t.drs[k]/dra > 5.0) {
+	for (int ic=0; ic<t.nc; ic++) {
+	  t.colrs[ic][k] = t.colrs[ic][k] * dra/t.drs[k];
+	}
+	t.prs[k] = pra;
+	t.urs[k] = ura;
+	t.drs[k] = dra;
+      }
+    }
+  }
+
+  // Floors
+
+  for (int k=i1*np; k<(i2+2)*np; k++) {
+    t.pls[k] = std::max(t.pls[k], sweep_tiny);
+    t.prs[k] = std::max(t.prs[k], sweep_tiny);
+    t.dls[k] = std::max(t.dls[k], sweep_tiny);
+    t.drs[k] = std::max(t.drs[k], sweep_tiny);
+  }
+  for (int ic=0; ic<t.nc; ic++) {
+    for (int k=i1*np; k<(i2+2)*np; k++) {
+      t.colls[ic][k] = std::max(t.colls[ic][k], sweep_color_floor);
+      t.colrs[ic][k] = std::max(t.colrs[ic][k], sweep_color_floor);
+    }
+  }
+
+  if (pressure_free_ == 1) {
+    for (int k=i1*np; k<(i2+2)*np; k++) {
+      t.dls[k] = t.da.la[k];
+      t.drs[k] = t.da.ra[k];
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+
+void EnzoHydroSweep::intvar_
+(Tile & t, const enzo_float * q, int isteep,
+ enzo_float * dq, enzo_float * ql, enzo_float * qr,
+ enzo_float * q6, Interface & qi) const throw()
+{
+  const int np = num_pencils;
+
+  // Monotonized slopes
+
+  for (int k=(t.i1-2)*np; k<(t.i2+3)*np; k++) {
+    const enzo_float qplus = q[k+np] - q[k];
+    const enzo_float qmnus = q[k] - q[k-np];
+    if (qplus*qmnus > 0.0) {
+      const enzo_float qcent = t.c1*qplus + t.c2*qmnus;
+      const enzo_float qvanl = 2.0*qplus*qmnus/(qmnus+qplus);
+      const enzo_float temp1 = std::min
+	(std::min(fabs(qcent), fabs(qvanl)),
+	 std::min(enzo_float(2.0)*fabs(qmnus), enzo_float(2.0)*fabs(qplus)));
+      dq[k] = temp1*std::copysign(enzo_float(1.0), qcent);
+    } else {
+      dq[k] = 0.0;
+    }
+  }
+
+  lr_states_ (t, q, dq, ql, qr);
+
+  if (isteep) steepen_ (t, q, dq, ql, qr);
+
+  mono_flat_ (t, q, ql, qr);
+
+  lr_interface_ (t, q, ql, qr, dq, q6, qi);
+}
+
+//----------------------------------------------------------------------
+
+void EnzoHydroSweep::lr_states_
+(const Tile & t, const enzo_float * q, const enzo_float * dq,
+ enzo_float * ql, enzo_float * qr) const throw()
+{
+  const int np = num_pencils;
+
+  for (int k=(t.i1-1)*np; k<(t.i2+3)*np; k++) {
+    ql[k] = t.c3*q[k-np] + t.c4*q[k] + t.c5*dq[k-np] + t.c6*dq[k];
+    qr[k-np] = ql[k];
+  }
+}
+
+//----------------------------------------------------------------------
+
+void EnzoHydroSweep::steepen_
+(const Tile & t, const enzo_float * q, const enzo_float * dq,
+ enzo_float * ql, enzo_float * qr) const throw()
+{
+  const int np = num_pencils;
+  const enzo_float * steepen = t.steepen;
+
+  for (int k=(t.i1-1)*np; k<(t.i2+2)*np; k++) {
+    ql[k] = (1.0-steepen[k])*ql[k] + steepen[k]*(q[k-np]+0.5*dq[k-np]);
+    qr[k] = (1.0-steepen[k])*qr[k] + steepen[k]*(q[k+np]-0.5*dq[k+np]);
+  }
+}
+
+//----------------------------------------------------------------------
+
+void EnzoHydroSweep::mono_flat_
+(const Tile & t, const enzo_float * q,
+ enzo_float * ql, enzo_float * qr) const throw()
+{
+  const int np = num_pencils;
+  const enzo_float * flatten = t.flatten;
+
+  for (int k=(t.i1-1)*np; k<(t.i2+2)*np; k++) {
+
+    // monotonicity
+
+    const enzo_float temp1 = (qr[k]-q[k])*(q[k]-ql[k]);
+    const enzo_float temp2 = qr[k]-ql[k];
+    const enzo_float temp3 = 6.0*(q[k]-0.5*(qr[k]+ql[k]));
+    if (temp1 <= 0.0) {
+      ql[k] = q[k];
+      qr[k] = q[k];
+    }
+    const enzo_float temp22 = temp2*temp2;
+    const enzo_float temp23 = temp2*temp3;
+    if (temp22 <  temp23) ql[k] = 3.0*q[k] - 2.0*qr[k];
+    if (temp22 < -temp23) qr[k] = 3.0*q[k] - 2.0*ql[k];
+
+    // flattening
+
+    if (flattening_ != 0) {
+      ql[k] = q[k]*flatten[k] + ql[k]*(1.0-flatten[k]);
+      qr[k] = q[k]*flatten[k] + qr[k]*(1.0-flatten[k]);
+    }
+
+    // bound by neighboring values
+
+    ql[k] = std::max(std::min(q[k], q[k-np]), ql[k]);
+    ql[k] = std::min(std::max(q[k], q[k-np]), ql[k]);
+    qr[k] = std::max(std::min(q[k], q[k+np]), qr[k]);
+    qr[k] = std::min(std::max(q[k], q[k+np]), qr[k]);
+  }
+}
+
+//----------------------------------------------------------------------
+
+void EnzoHydroSweep::lr_interface_
+(const Tile & t, const enzo_float * q,
+ enzo_float * ql, enzo_float * qr,
+ enzo_float * dq, enzo_float * q6,
+ Interface & qi) const throw()
+{
+  const int np = num_pencils;
+  const enzo_float ft = enzo_float(4.0)/enzo_float(3.0);
+  const enzo_float * char1 = t.char1;
+  const enzo_float * char2 = t.char2;
+  const enzo_float * c0 = t.c0;
+
+  for (int k=(t.i1-1)*np; k<(t.i2+2)*np; k++) {
+    q6[k] = 6.0*(q[k]-0.5*(ql[k]+qr[k]));
+    dq[k] = qr[k] - ql[k];
+  }
+
+  for (int k=t.i1*np; k<(t.i2+2)*np; k++) {
+    const int km = k - np;
+    qi.la[k] = qr[km]-char1[km]*(dq[km] - (1.0-ft*char1[km])*q6[km]);
+    qi.ra[k] = ql[k ]+char2[k ]*(dq[k ] + (1.0-ft*char2[k ])*q6[k ]);
+    qi.l0[k] = qr[km]-c0[km]*(dq[km] - (1.0-ft*c0[km])*q6[km]);
+    qi.r0[k] = ql[k ]-c0[k ]*(dq[k ] + (1.0+ft*c0[k ])*q6[k ]);
+  }
+}
+
+//----------------------------------------------------------------------
+
+void EnzoHydroSweep::intprim_ (Tile & t) const throw()
+{
+  const int np = num_pencils;
+
+  const enzo_float * q[5]  = { t.d,  t.u,  t.v,  t.w,  t.p  };
+  enzo_float       * dq[5] = { t.dd, t.du, t.dv, t.dw, t.dp };
+
+  // Slopes of characteristic variables (calc_eigen, linslope, and
+  // char2prim)
+
+  for (int k=(t.i1-2)*np; k<(t.i2+3)*np; k++) {
+
+    enzo_float qplus[5], qmnus[5], qcent[5], qvanl[5];
+    for (int n=0; n<5; n++) {
+      qplus[n] = q[n][k+np] - q[n][k];
+      qmnus[n] = q[n][k] - q[n][k-np];
+      qcent[n] = t.c1*qplus[n] + t.c2*qmnus[n];
+      qvanl[n] = (qplus[n]*qmnus[n] > 0.0) ?
+	2.0*qplus[n]*qmnus[n]/(qmnus[n]+qplus[n]) : 0.0;
+    }
+
+    // left and right eigenvectors
+
+    const enzo_float cs   = t.cs[k];
+    const enzo_float csi  = 1.0/cs;
+    const enzo_float csq  = cs*cs;
+    const enzo_float csqi = 1.0/csq;
+
+    enzo_float lem[5][5] = { { 0.0 } };
+    enzo_float rem[5][5] = { { 0.0 } };
+
+    lem[1][0] = -0.5*t.d[k]*csi;
+    lem[4][0] = 0.5*csqi;
+    lem[0][1] = 1.0;
+    lem[4][1] = -csqi;
+    lem[2][2] = 1.0;
+    lem[3][3] = 1.0;
+    lem[1][4] = -lem[1][0];
+    lem[4][4] = lem[4][0];
+
+    rem[0][0] = 1.0;
+    rem[0][1] = -cs/t.d[k];
+    rem[0][4] = csq;
+    rem[1][0] = 1.0;
+    rem[2][2] = 1.0;
+    rem[3][3] = 1.0;
+    rem[4][0] = 1.0;
+    rem[4][1] = -rem[0][1];
+    rem[4][4] = csq;
+
+    enzo_float dqc[5];
+    for (int n=0; n<5; n++) {
+      enzo_float qplusc = qplus[0] * lem[0][n];
+      enzo_float qmnusc = qmnus[0] * lem[0][n];
+      enzo_float qcentc = qcent[0] * lem[0][n];
+      enzo_float qvanlc = qvanl[0] * lem[0][n];
+      for (int m=1; m<5; m++) {
+	qplusc = qplusc + qplus[m] * lem[m][n];
+	qmnusc = qmnusc + qmnus[m] * lem[m][n];
+	qcentc = qcentc + qcent[m] * lem[m][n];
+	qvanlc = qvanlc + qvanl[m] * lem[m][n];
+      }
+      if (qmnusc*qplusc > 0.0) {
+	const enzo_float temp1 = std::min(fabs(qmnusc), fabs(qplusc));
+	const enzo_float temp2 = std::min(fabs(qcentc), fabs(qvanlc));
+	dqc[n] = std::min(enzo_float(2.0)*temp1, temp2) *
+	  std::copysign(enzo_float(1.0), qcentc);
+      } else {
+	dqc[n] = 0.0;
+      }
+    }
+
+    if (reconstruct_positive_) {
+      const enzo_float gamma1 = gamma_ - 1.0;
+      const enzo_float limit = 0.5*t.d[k];
+      if (dqc[0] > limit)   dqc[0] = limit;
+      if (dqc[1] > t.dxdt2) dqc[1] = t.dxdt2;
+      enzo_float du2 = dqc[1]*dqc[1];
+      for (int n=2; n<4; n++) du2 = du2 + dqc[n]*dqc[n];
+      const enzo_float rhoc = t.d[k] - dqc[0];
+      const enzo_float pc   = t.p[k] - dqc[4];
+      const enzo_float dplim = 2.0*fabs(0.125*rhoc*du2*gamma1 + pc);
+      if (dqc[4] > dplim) dqc[4] = dplim;
+    }
+
+    for (int n=0; n<5; n++) {
+      enzo_float dqn = dqc[0] * rem[0][n];
+      for (int m=1; m<5; m++) dqn = dqn + dqc[m] * rem[m][n];
+      dq[n][k] = dqn;
+    }
+  }
+
+  // Face values and averages
+
+  enzo_float * ql[5] = { t.dl, t.ul, t.vl, t.wl, t.pl };
+  enzo_float * qr[5] = { t.dr, t.ur, t.vr, t.wr, t.pr };
+  enzo_float * q6[5] = { t.d6, t.u6, t.v6, t.w6, t.p6 };
+  Interface  * qi[5] = { &t.da, &t.ua, &t.va, &t.wa, &t.pa };
+
+  for (int n=0; n<5; n++) {
+    lr_states_ (t, q[n], dq[n], ql[n], qr[n]);
+    if (n == 0 && steepening_) steepen_ (t, q[n], dq[n], ql[n], qr[n]);
+    mono_flat_ (t, q[n], ql[n], qr[n]);
+    lr_interface_ (t, q[n], ql[n], qr[n], dq[n], q6[n], *qi[n]);
+  }
+}
+
+//----------------------------------------------------------------------
+
+void EnzoHydroSweep::intpos_ (Tile & t) const throw()
+{
+  // As in intpos.F, only the first two active cells are limited
+
+  const int np = num_pencils;
+  const enzo_float gamma1i = 1.0 / (gamma_ + 1.0);
+
+  const int kb = t.i1*np;
+  const int ke = (t.i1+2)*np;
+
+  const enzo_float * d = t.d;
+  const enzo_float * u = t.u;
+  const enzo_float * p = t.p;
+
+  for (int k=kb; k<ke; k++) {
+    if (t.dd[k] > 0.5*d[k]) {
+      t.dd[k] = 0.5*d[k];
+      t.da.la[k] = d[k] - 0.5*t.dd[k];
+      t.da.ra[k] = d[k] + 0.5*t.dd[k];
+      t.da.l0[k] = t.da.la[k];
+      t.da.r0[k] = t.da.ra[k];
+    }
+  }
+  for (int k=kb; k<ke; k++) {
+    const enzo_float limit = 2.0 * gamma1i * t.dxdt2;
+    if (t.du[k] > limit) {
+      t.du[k] = limit;
+      t.ua.la[k] = u[k] - 0.5*t.du[k];
+      t.ua.ra[k] = u[k] + 0.5*t.du[k];
+      t.ua.l0[k] = t.ua.la[k];
+      t.ua.r0[k] = t.ua.ra[k];
+    }
+  }
+  for (int k=kb; k<ke; k++) {
+    const enzo_float limit = p[k] * gamma1i;
+    if (t.du[k] > limit) {
+      t.dp[k] = limit;
+      t.pa.la[k] = p[k] - 0.5*t.dp[k];
+      t.pa.ra[k] = p[k] + 0.5*t.dp[k];
+      t.pa.l0[k] = t.pa.la[k];
+      t.pa.r0[k] = t.pa.ra[k];
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+
+void EnzoHydroSweep::twoshock_ (Tile & t) const throw()
+{
+  const int np = num_pencils;
+  const int kb = t.i1*np;
+  const int ke = (t.i2+2)*np;
+  const enzo_float pmin = pressure_floor_;
+
+  const enzo_float * dls = t.dls;
+  const enzo_float * drs = t.drs;
+  const enzo_float * uls = t.uls;
+  const enzo_float * urs = t.urs;
+  enzo_float * pls = t.pls;
+  enzo_float * prs = t.prs;
+
+  if (pressure_free_ == 1) {
+    for (int k=kb; k<ke; k++) {
+      t.pbar[k] = pmin;
+      t.ubar[k] = 0.5*(uls[k]+urs[k]);
+      pls[k] = pmin;
+      prs[k] = pmin;
+    }
+    return;
+  }
+
+  const enzo_float qa = (gamma_ + 1.0)/(2.0*gamma_);
+
+  enzo_float * cl = t.cl;
+  enzo_float * cr = t.cr;
+  enzo_float * ps = t.ps;
+  enzo_float * old_ps = t.old_ps;
+  enzo_float * zl = t.zl;
+  enzo_float * zr = t.zr;
+  enzo_float * ubl = t.ubl;
+  enzo_float * ubr = t.ubr;
+  enzo_float * dpdul = t.dpdul;
+  enzo_float * dpdur = t.dpdur;
+  int * mask = t.mask;
+
+  // Linearized guess
+
+  for (int k=kb; k<ke; k++) {
+    cl[k] = sqrt(gamma_*pls[k]*dls[k]);
+    cr[k] = sqrt(gamma_*prs[k]*drs[k]);
+    ps[k] = (cr[k]*pls[k] + cl[k]*prs[k]
+	     + cr[k]*cl[k]*(uls[k] - urs[k]))/(cr[k]+cl[k]);
+    if (ps[k] < pmin) ps[k] = pmin;
+    old_ps[k] = ps[k];
+    mask[k] = 1;
+  }
+
+  // Newton iterations, stopping each face separately on convergence
+
+  for (int n=2; n<=sweep_twoshock_iterations; n++) {
+    for (int k=kb; k<ke; k++) {
+      if (mask[k] > 0) {
+	zl[k] = cl[k]*sqrt((1.0+qa*(ps[k]/pls[k]-1.0)));
+	zr[k] = cr[k]*sqrt((1.0+qa*(ps[k]/prs[k]-1.0)));
+	ubl[k] = uls[k] - (ps[k]-pls[k])/zl[k];
+	ubr[k] = urs[k] + (ps[k]-prs[k])/zr[k];
+	dpdul[k] = -4.0*(zl[k]*zl[k]*zl[k])/dls[k]
+	  /(4.0*(zl[k]*zl[k])/dls[k] - (gamma_+1.0)*(ps[k]-pls[k]));
+	dpdur[k] =  4.0*(zr[k]*zr[k]*zr[k])/drs[k]
+	  /(4.0*(zr[k]*zr[k])/drs[k] - (gamma_+1.0)*(ps[k]-prs[k]));
+	ps[k] = ps[k] + (ubr[k]-ubl[k])*dpdur[k]*dpdul[k]
+	  /(dpdur[k]-dpdul[k]);
+	if (ps[k] < pmin) ps[k] = pmin;
+	const enzo_float delta_ps = ps[k] - old_ps[k];
+	old_ps[k] = ps[k];
+	if (fabs(delta_ps/ps[k]) < sweep_twoshock_tolerance) mask[k] = 0;
+      }
+    }
+  }
+
+  for (int k=kb; k<ke; k++) {
+    if (ps[k] < pmin) ps[k] = std::min(pls[k],prs[k]);
+    t.pbar[k] = ps[k];
+    t.ubar[k] = ubl[k] + (ubr[k]-ubl[k])*dpdur[k]/(dpdur[k]-dpdul[k]);
+  }
+}
+
+//----------------------------------------------------------------------
+
+void EnzoHydroSweep::flux_twoshock_ (Tile & t) const throw()
+{
+  const int np = num_pencils;
+  const int i1 = t.i1;
+  const int i2 = t.i2;
+  const enzo_float qa = (gamma_ + 1.0)/(2.0*gamma_);
+  const enzo_float qc = t.qc;
+
+  const enzo_float * d = t.d;
+  const enzo_float * e = t.e;
+  const enzo_float * u = t.u;
+  const enzo_float * v = t.v;
+  const enzo_float * w = t.w;
+  const enzo_float * ge = t.ge;
+
+  for (int k=i1*np; k<(i2+2)*np; k++) {
+
+    const int km = k - np;
+    const enzo_float pbar = t.pbar[k];
+    const enzo_float ubar = t.ubar[k];
+
+    // Upwind state, and state at the shock or rarefaction
+
+    const enzo_float sn = std::copysign(enzo_float(1.0), -ubar);
+    enzo_float u0, p0, d0;
+    if (sn < 0.0) {
+      u0 = t.uls[k];
+      p0 = t.pls[k];
+      d0 = t.dls[k];
+    } else {
+      u0 = t.urs[k];
+      p0 = t.prs[k];
+      d0 = t.drs[k];
+    }
+    const enzo_float c0 = sqrt(std::max(gamma_*p0/d0, sweep_tiny));
+    const enzo_float z0 = c0*d0*sqrt(std::max
+				     ((enzo_float)(1.0 + qa*(pbar/p0-1.0)), sweep_tiny));
+
+    const enzo_float dbar = 1.0/(1.0/d0 - (pbar-p0)/
+				 std::max(z0*z0, sweep_tiny));
+    const enzo_float cbar = sqrt(std::max(gamma_*pbar/dbar, sweep_tiny));
+
+    enzo_float l0, lbar;
+    if (pbar < p0) {
+      l0   = u0*sn + c0;
+      lbar = sn*ubar + cbar;
+    } else {
+      l0   = u0*sn + z0/d0;
+      lbar = l0;
+    }
+
+    // Interpolate within the rarefaction fan
+
+    enzo_float frac = l0 - lbar;
+    if (frac < sweep_tiny) frac = sweep_tiny;
+    frac = (0.0 - lbar)/frac;
+    frac = std::min(std::max(frac, enzo_float(0.0)), enzo_float(1.0));
+    enzo_float pb = p0*frac + pbar*(1.0 - frac);
+    enzo_float db = d0*frac + dbar*(1.0 - frac);
+    enzo_float ub = u0*frac + ubar*(1.0 - frac);
+
+    if (lbar >= 0.0) {
+      pb = pbar;
+      db = dbar;
+      ub = ubar;
+    }
+    if (l0 < 0.0) {
+      pb = p0;
+      db = d0;
+      ub = u0;
+    }
+
+    enzo_float vb, wb, geb = 0.0;
+    if (ub > 0.0) {
+      vb = t.vls[k];
+      wb = t.wls[k];
+      if (dual_energy_) geb = t.gels[k];
+    } else {
+      vb = t.vrs[k];
+      wb = t.wrs[k];
+      if (dual_energy_) geb = t.gers[k];
+    }
+
+    const enzo_float eb = pb/((gamma_-1.0)*db) + 0.5*(ub*ub + vb*vb + wb*wb);
+
+    // Fluxes, with diffusion
+
+    const enzo_float upb = pb*ub;
+    enzo_float dub  = ub*db;
+    enzo_float duub, duvb, duwb, dueb, dugeb = 0.0;
+    if (diffusion_) {
+      const enzo_float diffcoef = t.diffcoef[k];
+      duub = dub*ub + diffcoef*(d[km]*u[km] - d[k]*u[k]);
+      duvb = dub*vb + diffcoef*(d[km]*v[km] - d[k]*v[k]);
+      duwb = dub*wb + diffcoef*(d[km]*w[km] - d[k]*w[k]);
+      dueb = dub*eb + diffcoef*(d[km]*e[km] - d[k]*e[k]);
+      dub  = dub    + diffcoef*(d[km]       - d[k]      );
+      if (dual_energy_) {
+	dugeb = dub*geb + diffcoef*(d[km]*ge[km] - d[k]*ge[k]);
+      }
+    } else {
+      duub = dub*ub;
+      duvb = dub*vb;
+      duwb = dub*wb;
+      dueb = dub*eb;
+      if (dual_energy_) dugeb = dub*geb;
+    }
+
+    t.df[k] = qc*dub;
+    t.ef[k] = qc*(dueb + upb);
+    t.uf[k] = qc*(duub + pb);
+    t.vf[k] = qc*duvb;
+    t.wf[k] = qc*duwb;
+    if (dual_energy_) t.gef[k] = qc*dugeb;
+
+    t.db[k] = db;
+    t.ub[k] = ub;
+  }
+
+  for (int ic=0; ic<t.nc; ic++) {
+    const enzo_float * colls = t.colls[ic];
+    const enzo_float * colrs = t.colrs[ic];
+    enzo_float * colf = t.colf[ic];
+    for (int k=i1*np; k<(i2+2)*np; k++) {
+      const enzo_float colb = (t.ub[k] > 0.0) ?
+	colls[k] * t.db[k]/t.dls[k] : colrs[k] * t.db[k]/t.drs[k];
+      colf[k] = t.dt*t.ub[k]*colb;
+    }
+  }
+
+  // Gas energy source term (computed for active cells only)
+
+  if (dual_energy_) {
+    for (int k=i1*np; k<(i2+1)*np; k++) {
+      const enzo_float pcent =
+	std::max((enzo_float)((gamma_-1.0)*ge[k]*d[k]), sweep_tiny);
+      t.ges[k] = qc * pcent * (t.ub[k] - t.ub[k+np]);
+    }
+  }
+
+  fallback_hll_ (t, true);
+}
+
+//----------------------------------------------------------------------
+
+void EnzoHydroSweep::flux_hll_face_ (Tile & t, int k) const throw()
+{
+  const int np = num_pencils;
+  const int km = k - np;
+  const enzo_float gamma1  = gamma_ - 1.0;
+  const enzo_float gamma1i = 1.0 / gamma1;
+  const enzo_float qc = t.qc;
+
+  const enzo_float dl = t.dls[k], dr = t.drs[k];
+  const enzo_float pl = t.pls[k], pr = t.prs[k];
+  const enzo_float ul = t.uls[k], ur = t.urs[k];
+  const enzo_float vl = t.vls[k], vr = t.vrs[k];
+  const enzo_float wl = t.wls[k], wr = t.wrs[k];
+
+  // Roe averages and wave speed estimates
+
+  const enzo_float sqrtdl = sqrt(dl);
+  const enzo_float sqrtdr = sqrt(dr);
+  const enzo_float isdlpdr = 1.0 / (sqrtdl + sqrtdr);
+  const enzo_float vroe1 = (sqrtdl * ul + sqrtdr * ur) * isdlpdr;
+  const enzo_float vroe2 = (sqrtdl * vl + sqrtdr * vr) * isdlpdr;
+  const enzo_float vroe3 = (sqrtdl * wl + sqrtdr * wr) * isdlpdr;
+  const enzo_float v2 = vroe1*vroe1 + vroe2*vroe2 + vroe3*vroe3;
+  const enzo_float el = gamma1i * pl + 0.5*dl*(ul*ul + vl*vl + wl*wl);
+  const enzo_float er = gamma1i * pr + 0.5*dr*(ur*ur + vr*vr + wr*wr);
+  const enzo_float hroe = ((el + pl)/sqrtdl + (er + pr)/sqrtdr) * isdlpdr;
+  const enzo_float cs = sqrt(gamma1*std::max((enzo_float)(hroe - 0.5*v2), sweep_tiny));
+  const enzo_float char1 = vroe1 - cs;
+  const enzo_float char2 = vroe1 + cs;
+
+  const enzo_float csl0 = sqrt(gamma_*pl/dl);
+  const enzo_float csr0 = sqrt(gamma_*pr/dr);
+  const enzo_float csl = std::min(ul-csl0, char1);
+  const enzo_float csr = std::max(ur+csr0, char2);
+  const enzo_float bm = std::min(csl, enzo_float(0.0));
+  const enzo_float bp = std::max(csr, enzo_float(0.0));
+  const enzo_float bm0 = ul - bm;
+  const enzo_float bp0 = ur - bp;
+
+  const enzo_float q1 = (bp + bm) / (bp - bm);
+  const enzo_float sl = 0.5 * (1.0 + q1);
+  const enzo_float sr = 0.5 * (1.0 - q1);
+
+  enzo_float diffd = 0.0, diffuu = 0.0, diffuv = 0.0, diffuw = 0.0;
+  enzo_float diffue = 0.0, diffuge = 0.0;
+  if (diffusion_) {
+    const enzo_float * d = t.d;
+    const enzo_float diffcoef = t.diffcoef[k];
+    diffd  = diffcoef * (d[km] - d[k]);
+    diffuu = diffcoef * (d[km]*t.u[km] - d[k]*t.u[k]);
+    diffuv = diffcoef * (d[km]*t.v[km] - d[k]*t.v[k]);
+    diffuw = diffcoef * (d[km]*t.w[km] - d[k]*t.w[k]);
+    diffue = diffcoef * (d[km]*t.e[km] - d[k]*t.e[k]);
+    if (dual_energy_) {
+      diffuge = diffcoef * (d[km]*t.ge[km] - d[k]*t.ge[k]);
+    }
+  }
+
+  const enzo_float dubl = dl * ul;
+  const enzo_float dubr = dr * ur;
+  const enzo_float dfl = dl * bm0;
+  const enzo_float dfr = dr * bp0;
+  const enzo_float ufl = dubl * bm0 + pl;
+  const enzo_float ufr = dubr * bp0 + pr;
+  const enzo_float vfl = dl*vl * bm0;
+  const enzo_float vfr = dr*vr * bp0;
+  const enzo_float wfl = dl*wl * bm0;
+  const enzo_float wfr = dr*wr * bp0;
+  const enzo_float efl = el * bm0 + pl*ul;
+  const enzo_float efr = er * bp0 + pr*ur;
+
+  t.df[k] = qc*(sl*dfl + sr*dfr + diffd);
+  t.uf[k] = qc*(sl*ufl + sr*ufr + diffuu);
+  t.vf[k] = qc*(sl*vfl + sr*vfr + diffuv);
+  t.wf[k] = qc*(sl*wfl + sr*wfr + diffuw);
+  t.ef[k] = qc*(sl*efl + sr*efr + diffue);
+
+  if (dual_energy_) {
+    const enzo_float gefl = bm0 * t.gels[k] * dl;
+    const enzo_float gefr = bp0 * t.gers[k] * dr;
+    t.gef[k] = qc*(sl*gefl + sr*gefr + diffuge);
+  }
+
+  for (int ic=0; ic<t.nc; ic++) {
+    const enzo_float colfl = bm0 * t.colls[ic][k];
+    const enzo_float colfr = bp0 * t.colrs[ic][k];
+    t.colf[ic][k] = t.dt*(sl*colfl + sr*colfr);
+  }
+
+  t.sl[k] = sl;
+  t.sr[k] = sr;
+  t.fl[k] = bm0;
+  t.fr[k] = bp0;
+}
+
+//----------------------------------------------------------------------
+
+void EnzoHydroSweep::flux_hll_ (Tile & t) const throw()
+{
+  const int np = num_pencils;
+
+  for (int k=t.i1*np; k<(t.i2+2)*np; k++) {
+    flux_hll_face_ (t, k);
+  }
+
+  if (dual_energy_) {
+    for (int k=t.i1*np; k<(t.i2+1)*np; k++) {
+      const enzo_float pcent =
+	std::max((enzo_float)((gamma_-1.0)*t.ge[k]*t.d[k]), sweep_tiny);
+      t.ges[k] = t.qc * pcent *
+	(t.sl[k   ]*t.fl[k   ] + t.sr[k   ]*t.fr[k   ] -
+	 t.sl[k+np]*t.fl[k+np] - t.sr[k+np]*t.fr[k+np]);
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+
+void EnzoHydroSweep::flux_hllc_ (Tile & t) const throw()
+{
+  const int np = num_pencils;
+  const int i1 = t.i1;
+  const int i2 = t.i2;
+  const enzo_float gamma1  = gamma_ - 1.0;
+  const enzo_float gamma1i = 1.0 / gamma1;
+  const enzo_float qc = t.qc;
+
+  for (int k=i1*np; k<(i2+2)*np; k++) {
+
+    const int km = k - np;
+
+    const enzo_float dl = t.dls[k], dr = t.drs[k];
+    const enzo_float pl = t.pls[k], pr = t.prs[k];
+    const enzo_float ul = t.uls[k], ur = t.urs[k];
+    const enzo_float vl = t.vls[k], vr = t.vrs[k];
+    const enzo_float wl = t.wls[k], wr = t.wrs[k];
+
+    // Roe averages and wave speed estimates
+
+    const enzo_float sqrtdl = sqrt(dl);
+    const enzo_float sqrtdr = sqrt(dr);
+    const enzo_float isdlpdr = 1.0 / (sqrtdl + sqrtdr);
+    const enzo_float vroe1 = (sqrtdl * ul + sqrtdr * ur) * isdlpdr;
+    const enzo_float vroe2 = (sqrtdl * vl + sqrtdr * vr) * isdlpdr;
+    const enzo_float vroe3 = (sqrtdl * wl + sqrtdr * wr) * isdlpdr;
+    const enzo_float v2 = vroe1*vroe1 + vroe2*vroe2 + vroe3*vroe3;
+    const enzo_float el = gamma1i * pl + 0.5*dl*(ul*ul + vl*vl + wl*wl);
+    const enzo_float er = gamma1i * pr + 0.5*dr*(ur*ur + vr*vr + wr*wr);
+    const enzo_float hroe = ((el + pl)/sqrtdl + (er + pr)/sqrtdr) * isdlpdr;
+    const enzo_float cs = sqrt(gamma1*std::max((enzo_float)(hroe - 0.5*v2), sweep_tiny));
+    const enzo_float char1 = vroe1 - cs;
+    const enzo_float char2 = vroe1 + cs;
+
+    const enzo_float csl0 = sqrt(gamma_*pl/dl);
+    const enzo_float csr0 = sqrt(gamma_*pr/dr);
+    const enzo_float csl = std::min(ul-csl0, char1);
+    const enzo_float csr = std::max(ur+csr0, char2);
+    const enzo_float bm = std::min(csl, enzo_float(0.0));
+    const enzo_float bp = std::max(csr, enzo_float(0.0));
+
+    // Contact wave speed and pressure
+
+    const enzo_float tl = pl - (csl - ul) * dl * ul;
+    const enzo_float tr = pr - (csr - ur) * dr * ur;
+    const enzo_float dL =  dl * (csl - ul);
+    const enzo_float dR = -dr * (csr - ur);
+    const enzo_float q1 = 1.0 / (dL+dR);
+    const enzo_float cw = (tr - tl)*q1;
+    enzo_float cp = (dL*tr + dR*tl)*q1;
+    enzo_float sl, sr, sm;
+    if (cw >= 0.0) {
+      sl =  cw / (cw - bm);
+      sr = 0.0;
+      sm = -bm / (cw - bm);
+    } else {
+      sl = 0.0;
+      sr = -cw / (bp - cw);
+      sm =  bp / (bp - cw);
+    }
+    cp = std::max(cp, enzo_float(0.0));
+
+    enzo_float diffd = 0.0, diffuu = 0.0, diffuv = 0.0, diffuw = 0.0;
+    enzo_float diffue = 0.0, diffuge = 0.0;
+    if (diffusion_) {
+      const enzo_float * d = t.d;
+      const enzo_float diffcoef = t.diffcoef[k];
+      diffd  = diffcoef * (d[km] - d[k]);
+      diffuu = diffcoef * (d[km]*t.u[km] - d[k]*t.u[k]);
+      diffuv = diffcoef * (d[km]*t.v[km] - d[k]*t.v[k]);
+      diffuw = diffcoef * (d[km]*t.w[km] - d[k]*t.w[k]);
+      diffue = diffcoef * (d[km]*t.e[km] - d[k]*t.e[k]);
+      if (dual_energy_) {
+	diffuge = diffcoef * (d[km]*t.ge[km] - d[k]*t.ge[k]);
+      }
+    }
+
+    const enzo_float dubl = dl * ul;
+    const enzo_float dubr = dr * ur;
+    const enzo_float dfl = dubl - bm*dl;
+    const enzo_float dfr = dubr - bp*dr;
+    const enzo_float ufl = dubl * (ul - bm) + pl;
+    const enzo_float ufr = dubr * (ur - bp) + pr;
+    const enzo_float vfl = dl*vl * (ul - bm);
+    const enzo_float vfr = dr*vr * (ur - bp);
+    const enzo_float wfl = dl*wl * (ul - bm);
+    const enzo_float wfr = dr*wr * (ur - bp);
+    const enzo_float efl = el * (ul - bm) + pl*ul;
+    const enzo_float efr = er * (ur - bp) + pr*ur;
+
+    const enzo_float uf = sl*ufl + sr*ufr + diffuu;
+    const enzo_float ef = sl*efl + sr*efr + diffue;
+
+    t.df[k] = qc*(sl*dfl + sr*dfr + diffd);
+    t.uf[k] = qc*(uf + sm * cp);
+    t.vf[k] = qc*(sl*vfl + sr*vfr + diffuv);
+    t.wf[k] = qc*(sl*wfl + sr*wfr + diffuw);
+    t.ef[k] = qc*(ef + sm * cp * cw);
+
+    if (dual_energy_) {
+      const enzo_float gefl = (ul-bm) * t.gels[k] * dl;
+      const enzo_float gefr = (ur-bp) * t.gers[k] * dr;
+      t.gef[k] = qc*(sl*gefl + sr*gefr + diffuge);
+    }
+
+    t.sl[k] = sl;
+    t.sr[k] = sr;
+    t.fl[k] = ul - bm;
+    t.fr[k] = ur - bp;
+  }
+
+  for (int ic=0; ic<t.nc; ic++) {
+    for (int k=i1*np; k<(i2+2)*np; k++) {
+      const enzo_float colfl = t.fl[k] * t.colls[ic][k];
+      const enzo_float colfr = t.fr[k] * t.colrs[ic][k];
+      t.colf[ic][k] = t.dt*(t.sl[k]*colfl + t.sr[k]*colfr);
+    }
+  }
+
+  if (dual_energy_) {
+    for (int k=i1*np; k<(i2+1)*np; k++) {
+      const enzo_float pcent =
+	std::max((enzo_float)((gamma_-1.0)*t.ge[k]*t.d[k]), sweep_tiny);
+      t.ges[k] = qc * pcent *
+	(t.sl[k   ]*t.fl[k   ] + t.sr[k   ]*t.fr[k   ] -
+	 t.sl[k+np]*t.fl[k+np] - t.sr[k+np]*t.fr[k+np]);
+    }
+  }
+
+  fallback_hll_ (t, false);
+}
+
+//----------------------------------------------------------------------
+
+void EnzoHydroSweep::fallback_hll_ (Tile & t, bool check_energy) const throw()
+{
+  const int np = num_pencils;
+
+  // Cells are checked in order along each pencil, since falling back
+  // changes the flux through the next face
+
+  for (int ip=0; ip<np; ip++) {
+    for (int i=t.i1; i<=t.i2; i++) {
+      const int k = i*np + ip;
+      const bool fail = check_energy ?
+	(t.d[k] + (t.df[k]-t.df[k+np]) <= 0.0 || t.e[k] < 0.0) :
+	(t.d[k] + t.df[k] - t.df[k+np] <= 0.0);
+      if (fail) {
+	flux_hll_face_ (t, k);
+	flux_hll_face_ (t, k+np);
+	if (dual_energy_) {
+	  const enzo_float pcent =
+	    std::max((enzo_float)((gamma_-1.0)*t.ge[k]*t.d[k]), sweep_tiny);
+	  t.ges[k] = t.qc * pcent *
+	    (t.sl[k   ]*t.fl[k   ] + t.sr[k   ]*t.fr[k   ] -
+	     t.sl[k+np]*t.fl[k+np] - t.sr[k+np]*t.fr[k+np]);
+	}
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+
+void EnzoHydroSweep::euler_ (Tile & t) const throw()
+{
+  const int np = num_pencils;
+  const int i1 = t.i1;
+  const int i2 = t.i2;
+  const enzo_float dt = t.dt;
+  const enzo_float dfloor = density_floor_;
+
+  enzo_float * d  = t.d;
+  enzo_float * e  = t.e;
+  enzo_float * u  = t.u;
+  enzo_float * v  = t.v;
+  enzo_float * w  = t.w;
+  enzo_float * ge = t.ge;
+
+  const enzo_float * df = t.df;
+
+  for (int k=i1*np; k<(i2+1)*np; k++) {
+
+    const int kp = k + np;
+
+    enzo_float dnu = d[k] + (df[k] - df[kp]);
+    enzo_float dnuinv = 1.0/dnu;
+    if (dfloor > 0.0) {
+      dnu    = std::max(dnu, dfloor);
+      dnuinv = 1.0 / dnu;
+    }
+
+    const enzo_float uold = u[k];
+    u[k] = (u[k]*d[k] + (t.uf[k] - t.uf[kp])) * dnuinv;
+    v[k] = (v[k]*d[k] + (t.vf[k] - t.vf[kp])) * dnuinv;
+    w[k] = (w[k]*d[k] + (t.wf[k] - t.wf[kp])) * dnuinv;
+    e[k] = std::max(enzo_float(0.1)*e[k],
+		    (e[k]*d[k] + (t.ef[k] - t.ef[kp])) * dnuinv);
+
+    if (dual_energy_) {
+      ge[k] = std::max((ge[k]*d[k] + (t.gef[k] - t.gef[kp]) + t.ges[k])
+		       * dnuinv, enzo_float(0.5)*ge[k]);
+    }
+
+    if (gravity_) {
+      const enzo_float gr = t.gr[k];
+      u[k] = u[k] + dt*gr*0.5*(d[k]*dnuinv + 1.0);
+      e[k] = e[k] + dt*gr*0.5*(u[k] + uold*d[k]*dnuinv);
+      e[k] = std::max(e[k], sweep_tiny);
+    }
+
+    d[k] = dnu;
+  }
+
+  // Colors are conserved densities
+
+  for (int ic=0; ic<t.nc; ic++) {
+    enzo_float * c    = t.c[ic];
+    enzo_float * colf = t.colf[ic];
+    for (int k=i1*np; k<(i2+2)*np; k++) {
+      colf[k] = colf[k]/t.h;
+    }
+    for (int k=i1*np; k<(i2+1)*np; k++) {
+      c[k] = c[k] + (colf[k] - colf[k+np]);
+      c[k] = std::max(c[k], sweep_min_color);
+    }
+  }
+}
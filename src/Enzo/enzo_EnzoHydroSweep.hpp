@@ -0,0 +1,174 @@
+// See LICENSE_CELLO file for license and copyright information
+
+/// @file     enzo_EnzoHydroSweep.hpp
+/// @author   James Bordner (jobordner@ucsd.edu)
+/// @date     2020-03-18
+/// @brief    [\ref Enzo] Declaration of the EnzoHydroSweep class
+
+#ifndef ENZO_ENZO_HYDRO_SWEEP_HPP
+#define ENZO_ENZO_HYDRO_SWEEP_HPP
+
+class EnzoHydroSweep {
+
+  /// @class    EnzoHydroSweep
+  /// @ingroup  Enzo
+  /// @brief    [\ref Enzo] Directional PPM sweeps over batches of pencils
+  ///
+  /// Updates the hydro fields of a block along one axis using Enzo's
+  /// PPM scheme (pgas2d, calcdiss, inteuler, twoshock, flux_twoshock /
+  /// flux_hll / flux_hllc, and euler).  Instead of copying one 2D
+  /// slice at a time, num_pencils pencils along the sweep axis are
+  /// gathered into a structure-of-arrays tile, with value (i,p)
+  /// stored at i*num_pencils + p, so that the inner loops run across
+  /// pencils and vectorize.  Arithmetic follows the operation order
+  /// of the Fortran routines, so results agree with EnzoMethodPpm up
+  /// to floating-point contraction by the compiler.
+
+public: // interface
+
+  /// Number of pencils processed together
+  enum { num_pencils = 8 };
+
+  /// Riemann solvers
+  enum { riemann_two_shock, riemann_hll, riemann_hllc };
+
+  /// Create a new EnzoHydroSweep object
+  EnzoHydroSweep(enzo_float gamma,
+		 int gravity,
+		 int dual_energy,
+		 enzo_float dual_energy_eta1,
+		 enzo_float dual_energy_eta2,
+		 int reconstruct_conservative,
+		 int reconstruct_positive,
+		 enzo_float density_floor,
+		 enzo_float pressure_floor,
+		 int pressure_free,
+		 int diffusion,
+		 int flattening,
+		 int steepening,
+		 int riemann_solver) throw();
+
+  /// Update the fields along the given axis.  Arrays have
+  /// dimensions m3 with g3 ghost zones and n3 active zones; h3 are
+  /// the cell widths.  v3 must contain all three velocity
+  /// components, ge is required with dual energy, and a is the
+  /// acceleration along axis (required with gravity).  c is the
+  /// list of nc color fields.
+  void sweep (int axis, enzo_float dt, const enzo_float h3[3],
+	      const int m3[3], const int g3[3], const int n3[3],
+	      enzo_float * d, enzo_float * e, enzo_float * ge,
+	      enzo_float * v3[3], enzo_float * a,
+	      int nc, enzo_float ** c) const throw();
+
+private: // classes
+
+  /// Temporary arrays for one tile of pencils
+  struct Tile;
+
+  /// Interface values of one quantity (the Fortran qla, qra, ql0, qr0)
+  struct Interface;
+
+private: // functions
+
+  /// Allocate tile arrays from the Scratch arena
+  void allocate_tile_ (Tile & tile, int m, int nc) const throw();
+
+  /// Gas pressure (pgas2d and pgas2d_dual)
+  void pgas_ (Tile & tile) const throw();
+
+  /// Flattening and diffusion coefficients (calcdiss)
+  void calcdiss_ (Tile & tile) const throw();
+
+  /// Left and right states at cell faces (inteuler)
+  void inteuler_ (Tile & tile) const throw();
+
+  /// Monotonic piecewise parabolic interpolation (intvar)
+  void intvar_ (Tile & tile, const enzo_float * q, int isteep,
+		enzo_float * dq, enzo_float * ql, enzo_float * qr,
+		enzo_float * q6, Interface & qi) const throw();
+
+  /// Interpolation of characteristic variables (intprim)
+  void intprim_ (Tile & tile) const throw();
+
+  /// Limit slopes to enforce positive pressure (intpos)
+  void intpos_ (Tile & tile) const throw();
+
+  /// Face states ql and qr from slopes dq (lr_states)
+  void lr_states_ (const Tile & tile, const enzo_float * q,
+		   const enzo_float * dq,
+		   enzo_float * ql, enzo_float * qr) const throw();
+
+  /// Steepen the interpolated density (inteuler steepening)
+  void steepen_ (const Tile & tile, const enzo_float * q,
+		 const enzo_float * dq,
+		 enzo_float * ql, enzo_float * qr) const throw();
+
+  /// Monotonize and flatten ql and qr (mono_n_flat)
+  void mono_flat_ (const Tile & tile, const enzo_float * q,
+		   enzo_float * ql, enzo_float * qr) const throw();
+
+  /// Averages over the domains of dependence (lr_interface)
+  void lr_interface_ (const Tile & tile, const enzo_float * q,
+		      enzo_float * ql, enzo_float * qr,
+		      enzo_float * dq, enzo_float * q6,
+		      Interface & qi) const throw();
+
+  /// Pressure and velocity at faces (twoshock)
+  void twoshock_ (Tile & tile) const throw();
+
+  /// Fluxes from the two-shock solution (flux_twoshock)
+  void flux_twoshock_ (Tile & tile) const throw();
+
+  /// Fluxes from the HLL solver (flux_hll)
+  void flux_hll_ (Tile & tile) const throw();
+
+  /// Fluxes from the HLLC solver (flux_hllc)
+  void flux_hllc_ (Tile & tile) const throw();
+
+  /// HLL fluxes at the face with tile index k
+  void flux_hll_face_ (Tile & tile, int k) const throw();
+
+  /// Recompute fluxes with HLL where the update would give a
+  /// non-positive density (or energy for flux_twoshock)
+  void fallback_hll_ (Tile & tile, bool check_energy) const throw();
+
+  /// Conservative update of the cells (euler)
+  void euler_ (Tile & tile) const throw();
+
+private: // attributes
+
+  /// Ratio of specific heats
+  enzo_float gamma_;
+
+  /// Whether to include gravitational acceleration
+  int gravity_;
+
+  /// Dual energy formalism parameters
+  int dual_energy_;
+  enzo_float dual_energy_eta1_;
+  enzo_float dual_energy_eta2_;
+
+  /// Whether to interpolate characteristic variables
+  int reconstruct_conservative_;
+
+  /// Whether to limit slopes to enforce positive pressure
+  int reconstruct_positive_;
+
+  /// Minimum density and pressure
+  enzo_float density_floor_;
+  enzo_float pressure_floor_;
+
+  /// Whether to assume pressure-free flow
+  int pressure_free_;
+
+  /// PPM diffusion, flattening, and steepening parameters
+  int diffusion_;
+  int flattening_;
+  int steepening_;
+
+  /// Riemann solver to use
+  int riemann_solver_;
+
+};
+
+#endif /* ENZO_ENZO_HYDRO_SWEEP_HPP */
@@ -17,6 +17,9 @@ EnzoInitialMusic::EnzoInitialMusic
  int level) throw()
   : Initial(cycle,time),
     level_(level),
+    stride_read_(enzo_config->initial_music_stride_read),
+    slab_max_bytes_(enzo_config->initial_music_slab_max_bytes),
+    block_data_(),
     field_files_     (enzo_config->initial_music_field_files),
     field_datasets_  (enzo_config->initial_music_field_datasets),
     field_coords_    (enzo_config->initial_music_field_coords),
@@ -36,6 +39,8 @@ void EnzoInitialMusic::pup (PUP::er &p)
   // NOTE: change this function whenever attributes change
 
   p | level_;
+  p | stride_read_;
+  p | slab_max_bytes_;
   
   p | field_files_;
   p | field_datasets_;
@@ -57,13 +62,6 @@ void EnzoInitialMusic::enforce_block
 
   if (block->level() != level_) return;
 
-  // Get the grid size at level_
-
-  double lower_domain[3];
-  double upper_domain[3];
-  hierarchy->lower(lower_domain, lower_domain+1, lower_domain+2);
-  hierarchy->upper(upper_domain, upper_domain+1, upper_domain+2);
-
   double lower_block[3];
   double upper_block[3];
   block->lower(lower_block, lower_block+1, lower_block+2);
@@ -71,152 +69,49 @@ void EnzoInitialMusic::enforce_block
 
   Field field = block->data()->field();
 
-  for (size_t index=0; index<field_files_.size(); index++) {
-
-    std::string file_name = field_files_[index];
-
-    // Block size
-
-    int mx,my,mz;
-    int nx,ny,nz;
-    int gx,gy,gz;
- 
-    field.dimensions (0,&mx,&my,&mz);
-    field.size         (&nx,&ny,&nz);
-    field.ghost_depth(0,&gx,&gy,&gz);
-
-    // Open the field file
-
-    FileHdf5 file("./",file_name);
-
-    file.file_open();
+  // Block size
 
-    // Read the domain dimensions
+  int mx,my,mz;
+  int nx,ny,nz;
+  int gx,gy,gz;
 
-    const int IX = field_coords_[index].find ("x");
-    const int IY = field_coords_[index].find ("y");
-    const int IZ = field_coords_[index].find ("z");
+  field.dimensions (0,&mx,&my,&mz);
+  field.size         (&nx,&ny,&nz);
+  field.ghost_depth(0,&gx,&gy,&gz);
 
-    ASSERT3 ("EnzoInitialMusic::enforce_block()",
-	    "bad field coordinates %d %d %d",
-	     IX,IY,IZ,
-	     ((IX<4)&&(IY<4)&&(IZ<4)) &&
-	     ((IX != IY) || (IY==-1 && IZ == -1)) &&
-	     ((IX != IY && IY != IZ) || (IZ == -1)));
-    
-    int m4[4] = {0};
-    int type_data = type_unknown;
-    file. data_open (field_datasets_[index], &type_data,
-		     m4,m4+1,m4+2,m4+3);
-    // compute cell widths
-    double h4[4] = {1};
-    h4[IX] = (upper_block[0] - lower_block[0]) / nx;
-    h4[IY] = (upper_block[1] - lower_block[1]) / ny;
-    h4[IZ] = (upper_block[2] - lower_block[2]) / nz;
-
-    // determine offsets
-    int o4[4] = {0};
-    o4[IX] = (lower_block[0] - lower_domain[0]) / h4[IX];
-    o4[IY] = (lower_block[1] - lower_domain[1]) / h4[IY];
-    o4[IZ] = (lower_block[2] - lower_domain[2]) / h4[IZ];
-
-    // adjust offsets if domain is larger than file input
-    // (e.g. to allow N=1024^3 using 512^3 input files
-    // for scaling tests)
+  for (size_t index=0; index<field_files_.size(); index++) {
 
-    if (o4[IX] >= m4[IX]) o4[IX] = o4[IX] % m4[IX];
-    if (o4[IY] >= m4[IY]) o4[IY] = o4[IY] % m4[IY];
-    if (o4[IZ] >= m4[IZ]) o4[IZ] = o4[IZ] % m4[IZ];
+    int IX,IY,IZ;
+    axes_ (field_coords_[index],&IX,&IY,&IZ);
 
     int n4[4] = {1};
-    n4[IX] = (upper_block[0] - lower_block[0]) / h4[IX];
-    n4[IY] = (upper_block[1] - lower_block[1]) / h4[IY];
-    n4[IZ] = (upper_block[2] - lower_block[2]) / h4[IZ];
-      
-    // open the dataspace
-    file. data_slice
-      (m4[0],m4[1],m4[2],m4[3],
-       n4[0],n4[1],n4[2],n4[3],
-       o4[0],o4[1],o4[2],o4[3]);
-
-    // create memory space
-    file.mem_create (n4[IX],n4[IY],n4[IZ],
-		     n4[IX],n4[IY],n4[IZ],
-		     0,0,0);
-    
-    // input domain size
-    union {
-      void   * data;
-      float  * data_float;
-      double * data_double;
-    };
-    
-    if (type_data == type_single) {
-      data_float = new float [nx*ny*nz];
-    } else if (type_data == type_double) {
-      data_double = new double [nx*ny*nz];
-    } else {
-      ERROR3 ("EnzoInitialMusic::enforce_block()",
-	      "Unsupported data type %d in file %s field %s",
-	      type_data,file_name.c_str(),field_datasets_[index].c_str());
-    }
+    n4[IX] = nx;
+    n4[IY] = ny;
+    n4[IZ] = nz;
 
-    file.data_read (data);
+    std::vector<char> values;
+    int type_data = type_unknown;
+    read_block_ (block,hierarchy,index,&values,&type_data);
 
     enzo_float * array = (enzo_float *) field.values(field_names_[index]);
 
     if (type_data == type_single) {
 
       copy_field_data_to_array_
-	(array,data_float,mx,my,mz,nx,ny,nz,gx,gy,gz,n4,IX,IY);
-      
+	(array,(float *)values.data(),mx,my,mz,nx,ny,nz,gx,gy,gz,n4,IX,IY);
+
     } else if (type_data == type_double) {
 
       copy_field_data_to_array_
-	(array,data_double,mx,my,mz,nx,ny,nz,gx,gy,gz,n4,IX,IY);
-    }
-
-    if (type_data == type_single) {
-      delete [] data_float;
-    } else if (type_data == type_double) {
-      delete [] data_double;
+	(array,(double *)values.data(),mx,my,mz,nx,ny,nz,gx,gy,gz,n4,IX,IY);
     }
-    
-    file.data_close();
-    file.file_close();
-
   }
 
   for (size_t index=0; index<particle_files_.size(); index++) {
 
-    std::string file_name = particle_files_[index];
-
-    // Open the particle file
-
-    FileHdf5 file("./",file_name);
-
-    file.file_open();
-
-    // Open the dataset
-    int m4[4] = {0};
-    int type_data = type_unknown;
-    file. data_open (particle_datasets_[index], &type_data,
-		     m4,m4+1,m4+2,m4+3);
-
-    // Block size
-
-    int mx,my,mz;
-    int nx,ny,nz;
-    int gx,gy,gz;
- 
-    field.dimensions (0,&mx,&my,&mz);
-    field.size         (&nx,&ny,&nz);
-    field.ghost_depth(0,&gx,&gy,&gz);
-
     // coordinate mapping
-    const int IX = particle_coords_[index].find ("x");
-    const int IY = particle_coords_[index].find ("y");
-    const int IZ = particle_coords_[index].find ("z");
+    int IX,IY,IZ;
+    axes_ (particle_coords_[index],&IX,&IY,&IZ);
 
     // compute cell widths
     double h4[4] = {1};
@@ -224,52 +119,18 @@ void EnzoInitialMusic::enforce_block
     h4[IY] = (upper_block[1] - lower_block[1]) / ny;
     h4[IZ] = (upper_block[2] - lower_block[2]) / nz;
 
-    // determine offsets
-    int o4[4] = {0};
-    o4[IX] = (lower_block[0] - lower_domain[0]) / h4[IX];
-    o4[IY] = (lower_block[1] - lower_domain[1]) / h4[IY];
-    o4[IZ] = (lower_block[2] - lower_domain[2]) / h4[IZ];
-
-    if (o4[IX] >= m4[IX]) o4[IX] = o4[IX] % m4[IX];
-    if (o4[IY] >= m4[IY]) o4[IY] = o4[IY] % m4[IY];
-    if (o4[IZ] >= m4[IZ]) o4[IZ] = o4[IZ] % m4[IZ];
-
-    int n4[4] = {1};
-    n4[IX] = (upper_block[0] - lower_block[0]) / h4[IX];
-    n4[IY] = (upper_block[1] - lower_block[1]) / h4[IY];
-    n4[IZ] = (upper_block[2] - lower_block[2]) / h4[IZ];
-
-    // open the dataspace
-    file. data_slice
-      (m4[0],m4[1],m4[2],m4[3],
-       n4[0],n4[1],n4[2],n4[3],
-       o4[0],o4[1],o4[2],o4[3]);
-
-    // create memory space
-
-    file.mem_create (nx,ny,nz,nx,ny,nz,0,0,0);
+    std::vector<char> values;
+    int type_data = type_unknown;
+    read_block_ (block,hierarchy,field_files_.size()+index,
+		 &values,&type_data);
 
-    // input domain size
     union {
       void   * data;
       float  * data_float;
       double * data_double;
     };
 
-    if (type_data == type_single) {
-      data_float = new float [nx*ny*nz];
-    } else if (type_data == type_double) {
-      data_double = new double [nx*ny*nz];
-    } else {
-      ERROR3 ("EnzoInitialMusic::enforce_block()",
-	      "Unsupported data type %d in file %s particle dataset %s",
-	      type_data,file_name.c_str(),particle_datasets_[index].c_str());
-    }
-    
-    // read data and close file
-    file.data_read (data);
-    file.data_close();
-    file.file_close();
+    data = values.data();
 
     // Create particles and initialize them
 
@@ -319,12 +180,6 @@ void EnzoInitialMusic::enforce_block
 	      particle.type_name(it).c_str(),
 	      particle.attribute_name(it,ia).c_str());
     }
-    
-    if (type_data == type_single) {
-      delete [] data_float;
-    } else if (type_data == type_double) {
-      delete [] data_double;
-    }
 
     data = NULL;
 
@@ -412,6 +267,379 @@ void EnzoInitialMusic::enforce_block
   }  
 }
 
+//----------------------------------------------------------------------
+
+void EnzoInitialMusic::read_collective
+(int index_initial, const Hierarchy * hierarchy, double stats[4]) throw()
+{
+  const int ip = CkMyPe();
+
+  if (ip % stride_read_ != 0) return;
+
+  const int num_readers  = (CkNumPes() + stride_read_ - 1) / stride_read_;
+  const int index_reader = ip / stride_read_;
+
+  // Root-level Block array and Block size
+
+  int nb3[3];
+  hierarchy->root_blocks(nb3,nb3+1,nb3+2);
+  int nr3[3];
+  hierarchy->root_size(nr3,nr3+1,nr3+2);
+  const int n3[3] = { nr3[0]/nb3[0], nr3[1]/nb3[1], nr3[2]/nb3[2] };
+
+  CkLocMgr * loc_mgr = hierarchy->block_array().ckLocMgr();
+
+  Timer timer;
+
+  const int num_datasets = field_files_.size() + particle_files_.size();
+
+  for (int id=0; id<num_datasets; id++) {
+
+    std::string file_name,dataset,coords;
+    dataset_ (id,&file_name,&dataset,&coords);
+
+    int I3[3];
+    axes_ (coords,I3,I3+1,I3+2);
+
+    // Open the file and dataset
+
+    timer.start();
+
+    FileHdf5 file("./",file_name);
+
+    file.file_open();
+
+    int m4[4] = {0};
+    int type_data = type_unknown;
+    file. data_open (dataset, &type_data, m4,m4+1,m4+2,m4+3);
+
+    timer.stop();
+
+    stats[0] += 1;
+
+    if (type_data != type_single && type_data != type_double) {
+      ERROR3 ("EnzoInitialMusic::read_collective()",
+	      "Unsupported data type %d in file %s dataset %s",
+	      type_data,file_name.c_str(),dataset.c_str());
+    }
+
+    const int bytes = cello::type_bytes[type_data];
+
+    // Block size and slab size in dataset axes.  Slabs are one Block
+    // thick along the slowest-varying spatial axis ia of the dataset,
+    // and span as many Blocks along the next spatial axis ib as fit
+    // in slab_max_bytes_.  Axes are right-aligned so that axis 3
+    // varies fastest in memory.
+
+    int rank = 4;
+    while (rank > 1 && m4[rank-1] <= 1) --rank;
+    const int shift = 4 - rank;
+
+    int ia = 4;
+    int ib = 4;
+    int n4[4] = {1,1,1,1};
+    int s4[4] = {1,1,1,1};
+    int J3[3] = {-1,-1,-1};
+    for (int axis=0; axis<3; axis++) {
+      const int i4 = I3[axis];
+      if (i4 >= 0 && i4 + shift < 4) {
+	J3[axis] = i4 + shift;
+	n4[J3[axis]] = n3[axis];
+	s4[J3[axis]] = std::min(m4[i4],nr3[axis]);
+	if (J3[axis] < ia) {
+	  ib = ia;
+	  ia = J3[axis];
+	} else if (J3[axis] < ib) {
+	  ib = J3[axis];
+	}
+      }
+    }
+    s4[ia] = n4[ia];
+
+    if (ib < 4) {
+      const size_t bytes_row =
+	size_t(bytes)*s4[0]*s4[1]*s4[2]*s4[3] / s4[ib] * n4[ib];
+      const size_t rows = std::max
+	(size_t(1), size_t(slab_max_bytes_) / bytes_row);
+      s4[ib] = int(std::min (size_t(s4[ib]), rows*n4[ib]));
+    }
+
+    const size_t size_slab = size_t(s4[0])*s4[1]*s4[2]*s4[3];
+
+    ASSERT2 ("EnzoInitialMusic::read_collective()",
+	     "Slab size %lu in dataset %s is too large",
+	     (unsigned long)size_slab, dataset.c_str(),
+	     (size_slab <= size_t(std::numeric_limits<int>::max())));
+
+    // Group Blocks by the (possibly wrapped) offset of their slab
+    // along axes ia and ib
+
+    std::map< std::pair<int,int>,std::vector<Index> > slab_blocks;
+
+    for (int ibz=0; ibz<nb3[2]; ibz++) {
+      for (int iby=0; iby<nb3[1]; iby++) {
+	for (int ibx=0; ibx<nb3[0]; ibx++) {
+	  const int ib3[3] = {ibx,iby,ibz};
+	  int oa = 0, ob = 0;
+	  for (int axis=0; axis<3; axis++) {
+	    const int o = (J3[axis] >= 0) ?
+	      (ib3[axis]*n3[axis]) % m4[J3[axis]-shift] : 0;
+	    if (J3[axis] == ia) oa = o;
+	    if (J3[axis] == ib) ob = o - o % s4[ib];
+	  }
+	  slab_blocks[std::make_pair(oa,ob)].push_back(Index(ibx,iby,ibz));
+	}
+      }
+    }
+
+    // Read this reader's slabs and send each Block its subvolume
+
+    const size_t n = size_t(n4[0])*n4[1]*n4[2]*n4[3];
+    std::vector<char> slab (bytes*size_slab);
+
+    int header[5] = {id, type_data, 0, 0, 0};
+    std::vector<char> buffer (sizeof(header) + bytes*n);
+    char * values = &buffer[sizeof(header)];
+
+    int index_slab = 0;
+    std::map< std::pair<int,int>,std::vector<Index> >::iterator it_slab;
+    for (it_slab =  slab_blocks.begin();
+	 it_slab != slab_blocks.end(); ++it_slab, ++index_slab) {
+
+      if (index_slab % num_readers != index_reader) continue;
+
+      // Slab extent t4 and offset o4 in dataset axes, where the last
+      // slab along ib may be truncated by the dataset size
+
+      int t4[4] = {s4[0],s4[1],s4[2],s4[3]};
+      int o4[4] = {0,0,0,0};
+      o4[ia] = it_slab->first.first;
+      if (ib < 4) {
+	o4[ib] = it_slab->first.second;
+	t4[ib] = std::min(s4[ib], m4[ib-shift] - o4[ib]);
+      }
+
+      const size_t size_read = size_t(t4[0])*t4[1]*t4[2]*t4[3];
+
+      timer.start();
+
+      file. data_slice
+	(m4[0],m4[1],m4[2],m4[3],
+	 t4[shift],           (shift<3) ? t4[shift+1] : 1,
+	 (shift<2) ? t4[shift+2] : 1, (shift<1) ? t4[3] : 1,
+	 o4[shift],           (shift<3) ? o4[shift+1] : 0,
+	 (shift<2) ? o4[shift+2] : 0, (shift<1) ? o4[3] : 0);
+
+      file.mem_create (int(size_read),1,1,int(size_read),1,1,0,0,0);
+      file.data_read (slab.data());
+      file.mem_close();
+
+      timer.stop();
+
+      stats[1] += 1;
+      stats[2] += bytes*size_read;
+
+      std::vector<Index> & block_list = it_slab->second;
+
+      for (size_t ib_list=0; ib_list<block_list.size(); ib_list++) {
+
+	Index index = block_list[ib_list];
+	int ib3[3];
+	index.array(ib3,ib3+1,ib3+2);
+
+	// Block offset in the slab
+
+	int b4[4] = {0,0,0,0};
+	for (int axis=0; axis<3; axis++) {
+	  if (J3[axis] >= 0 && J3[axis] != ia) {
+	    b4[J3[axis]] = (ib3[axis]*n3[axis]) % m4[J3[axis]-shift]
+	      - o4[J3[axis]];
+	  }
+	}
+
+	// Copy the Block's subvolume, one contiguous row at a time
+
+	size_t i = 0;
+	for (int i0=0; i0<n4[0]; i0++) {
+	  for (int i1=0; i1<n4[1]; i1++) {
+	    for (int i2=0; i2<n4[2]; i2++) {
+	      const size_t j =
+		((size_t(b4[0]+i0)*t4[1] + b4[1]+i1)*t4[2] + b4[2]+i2)*t4[3]
+		+ b4[3];
+	      memcpy (values + bytes*i, &slab[bytes*j], bytes*n4[3]);
+	      i += n4[3];
+	    }
+	  }
+	}
+
+	index.array(header+2,header+3,header+4);
+	memcpy (&buffer[0],header,sizeof(header));
+
+	const int ip_block = loc_mgr->homePe(CkArrayIndexIndex(index));
+
+	proxy_enzo_simulation[ip_block].p_initial_data
+	  (index_initial,int(buffer.size()),&buffer[0]);
+      }
+    }
+
+    file.data_close();
+    file.file_close();
+  }
+
+  stats[3] += timer.value();
+}
+
+//----------------------------------------------------------------------
+
+void EnzoInitialMusic::receive_collective (int n, char * buffer) throw()
+{
+  int header[5];
+  memcpy (header,buffer,sizeof(header));
+
+  const int id        = header[0];
+  const int type_data = header[1];
+  Index index(header[2],header[3],header[4]);
+
+  std::pair<int, std::vector<char> > & block_data =
+    block_data_[std::make_pair(index,id)];
+
+  block_data.first = type_data;
+  block_data.second.assign(buffer + sizeof(header), buffer + n);
+}
+
+//----------------------------------------------------------------------
+
+void EnzoInitialMusic::dataset_
+(int id, std::string * file_name,
+ std::string * dataset, std::string * coords) const throw()
+{
+  const int num_fields = field_files_.size();
+  if (id < num_fields) {
+    (*file_name) = field_files_[id];
+    (*dataset)   = field_datasets_[id];
+    (*coords)    = field_coords_[id];
+  } else {
+    (*file_name) = particle_files_[id-num_fields];
+    (*dataset)   = particle_datasets_[id-num_fields];
+    (*coords)    = particle_coords_[id-num_fields];
+  }
+}
+
+//----------------------------------------------------------------------
+
+void EnzoInitialMusic::axes_
+(std::string coords, int * IX, int * IY, int * IZ) const throw()
+{
+  (*IX) = coords.find ("x");
+  (*IY) = coords.find ("y");
+  (*IZ) = coords.find ("z");
+
+  ASSERT3 ("EnzoInitialMusic::axes_()",
+	   "bad coordinates %d %d %d",
+	   (*IX),(*IY),(*IZ),
+	   (((*IX)<4)&&((*IY)<4)&&((*IZ)<4)) &&
+	   (((*IX) != (*IY)) || ((*IY)==-1 && (*IZ) == -1)) &&
+	   (((*IX) != (*IY) && (*IY) != (*IZ)) || ((*IZ) == -1)));
+}
+
+//----------------------------------------------------------------------
+
+void EnzoInitialMusic::read_block_
+(Block * block, const Hierarchy * hierarchy, int id,
+ std::vector<char> * values, int * type_data) throw()
+{
+  // Use data received from a collective reader if any
+
+  std::map< std::pair<Index,int>, std::pair<int, std::vector<char> > >
+    ::iterator it = block_data_.find(std::make_pair(block->index(),id));
+
+  if (it != block_data_.end()) {
+    (*type_data) = it->second.first;
+    values->swap(it->second.second);
+    block_data_.erase(it);
+    return;
+  }
+
+  std::string file_name,dataset,coords;
+  dataset_ (id,&file_name,&dataset,&coords);
+
+  int IX,IY,IZ;
+  axes_ (coords,&IX,&IY,&IZ);
+
+  // Get the grid size at level_
+
+  double lower_domain[3];
+  hierarchy->lower(lower_domain, lower_domain+1, lower_domain+2);
+
+  double lower_block[3];
+  double upper_block[3];
+  block->lower(lower_block, lower_block+1, lower_block+2);
+  block->upper(upper_block, upper_block+1, upper_block+2);
+
+  int nx,ny,nz;
+  block->data()->field().size(&nx,&ny,&nz);
+
+  // Open the file
+
+  FileHdf5 file("./",file_name);
+
+  file.file_open();
+
+  int m4[4] = {0};
+  file. data_open (dataset, type_data, m4,m4+1,m4+2,m4+3);
+
+  // compute cell widths
+  double h4[4] = {1};
+  h4[IX] = (upper_block[0] - lower_block[0]) / nx;
+  h4[IY] = (upper_block[1] - lower_block[1]) / ny;
+  h4[IZ] = (upper_block[2] - lower_block[2]) / nz;
+
+  // determine offsets
+  int o4[4] = {0};
+  o4[IX] = (lower_block[0] - lower_domain[0]) / h4[IX];
+  o4[IY] = (lower_block[1] - lower_domain[1]) / h4[IY];
+  o4[IZ] = (lower_block[2] - lower_domain[2]) / h4[IZ];
+
+  // adjust offsets if domain is larger than file input
+  // (e.g. to allow N=1024^3 using 512^3 input files
+  // for scaling tests)
+
+  if (o4[IX] >= m4[IX]) o4[IX] = o4[IX] % m4[IX];
+  if (o4[IY] >= m4[IY]) o4[IY] = o4[IY] % m4[IY];
+  if (o4[IZ] >= m4[IZ]) o4[IZ] = o4[IZ] % m4[IZ];
+
+  int n4[4] = {1};
+  n4[IX] = (upper_block[0] - lower_block[0]) / h4[IX];
+  n4[IY] = (upper_block[1] - lower_block[1]) / h4[IY];
+  n4[IZ] = (upper_block[2] - lower_block[2]) / h4[IZ];
+
+  // open the dataspace
+  file. data_slice
+    (m4[0],m4[1],m4[2],m4[3],
+     n4[0],n4[1],n4[2],n4[3],
+     o4[0],o4[1],o4[2],o4[3]);
+
+  // create memory space
+  file.mem_create (n4[IX],n4[IY],n4[IZ],
+		   n4[IX],n4[IY],n4[IZ],
+		   0,0,0);
+
+  if ((*type_data) != type_single && (*type_data) != type_double) {
+    ERROR3 ("EnzoInitialMusic::read_block_()",
+	    "Unsupported data type %d in file %s dataset %s",
+	    (*type_data),file_name.c_str(),dataset.c_str());
+  }
+
+  values->resize(cello::type_bytes[*type_data]*nx*ny*nz);
+
+  // read data and close file
+  file.data_read (values->data());
+  file.data_close();
+  file.file_close();
+}
+
+//----------------------------------------------------------------------
+
 template <class T>
 void EnzoInitialMusic::copy_field_data_to_array_
 (enzo_float * array, T * data,
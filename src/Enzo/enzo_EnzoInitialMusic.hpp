@@ -13,6 +13,15 @@ class EnzoInitialMusic : public Initial {
   /// @class    EnzoInitialMusic
   /// @ingroup  Enzo
   /// @brief    [\ref Enzo] Read initial conditions from the MUSIC HDF5 files
+  ///
+  /// By default each Block opens each file and reads its own
+  /// hyperslab.  If stride_read > 0, root-level Block data are
+  /// instead read before Blocks are created by processes whose
+  /// index is divisible by stride_read, each of which reads
+  /// slabs one root-level Block thick along the slowest-varying
+  /// axis, split along the next axis to at most slab_max_bytes, and
+  /// sends each Block's subvolume to the process it will be created
+  /// on.
 
 public: // interface
 
@@ -32,7 +41,10 @@ public: // interface
   /// CHARM++ migration constructor
   EnzoInitialMusic(CkMigrateMessage *m)
     : Initial (m),
-      level_(0)
+      level_(0),
+      stride_read_(0),
+      slab_max_bytes_(0),
+      block_data_()
   {  }
 
   /// Destructor
@@ -46,8 +58,35 @@ public: // interface
   virtual void enforce_block
   ( Block * block, const Hierarchy * hierarchy ) throw();
 
+  /// Read root-level Block data collectively if stride_read > 0
+  virtual bool is_collective() const throw()
+  { return (stride_read_ > 0) && (level_ == 0); }
+
+  /// Read slabs of each dataset and send Block subvolumes to the
+  /// processes the Blocks will be created on
+  virtual void read_collective (int index_initial,
+				const Hierarchy * hierarchy,
+				double stats[4]) throw();
+
+  /// Save Block data sent by read_collective() until the Block
+  /// is initialized
+  virtual void receive_collective (int n, char * buffer) throw();
+
 protected: // functions
 
+  /// Return the file name, dataset name, and coordinates for the
+  /// given dataset id, where field datasets precede particle datasets
+  void dataset_ (int id, std::string * file_name,
+		 std::string * dataset, std::string * coords) const throw();
+
+  /// Return the dataset axes of the x, y, and z coordinates
+  void axes_ (std::string coords, int * IX, int * IY, int * IZ) const throw();
+
+  /// Return the values of dataset id for the Block and their type,
+  /// either received from a collective reader or read from the file
+  void read_block_ (Block * block, const Hierarchy * hierarchy, int id,
+		    std::vector<char> * values, int * type_data) throw();
+
   template <class T>
   void copy_field_data_to_array_
   (enzo_float * array, T * data,
@@ -65,6 +104,18 @@ protected: // attributes
 
   // Only initialize Blocks at this level
   int level_;
+
+  /// Processes with index divisible by stride_read_ read root-level
+  /// Block data collectively; 0 if each Block reads its own data
+  int stride_read_;
+
+  /// Maximum size in bytes of a slab read by a collective reader
+  int slab_max_bytes_;
+
+  /// Block data received from collective readers but not yet used,
+  /// indexed by Block and dataset id, with the data type (not pupped)
+  std::map< std::pair<Index,int>, std::pair<int, std::vector<char> > >
+  block_data_;
   
   std::vector < std::string > field_files_;
   std::vector < std::string > field_datasets_;
@@ -12,6 +12,170 @@
 
 //======================================================================
 
+namespace {
+
+  /// Number of rows along y in each tile, so that the 2*radius+1
+  /// xy-planes of X used to compute a tile of Y stay in cache along z
+  const int laplace_tile_y = 16;
+
+  /// Stencil coefficients of the order 2, 4 and 6 Laplace operators
+  /// along one axis: coefficient(k) is the weight of X[i-k] and
+  /// X[i+k], scaled by 1 / (denominator * h^2)
+  template <int ORDER> struct LaplaceStencil;
+
+  template <> struct LaplaceStencil<2> {
+    enum { radius = 1 };
+    static double denominator () { return 1.0; }
+    static double coefficient (int k)
+    { return (k == 0) ? -2.0 : 1.0; }
+  };
+
+  template <> struct LaplaceStencil<4> {
+    enum { radius = 2 };
+    static double denominator () { return 12.0; }
+    static double coefficient (int k)
+    { return (k == 0) ? -30.0 : ( (k == 1) ? 16.0 : -1.0); }
+  };
+
+  template <> struct LaplaceStencil<6> {
+    enum { radius = 3 };
+    static double denominator () { return 1080.0; }
+    static double coefficient (int k)
+    { return (k == 0) ? -2720.0 :
+	( (k == 1) ? 1455.0 : ( (k == 2) ? -96.0 : 1.0) ); }
+  };
+
+  //----------------------------------------------------------------------
+
+  /// Compute Y = A*X in zones g0 <= i < m - g0 for the Laplace
+  /// operator specialized by rank and order.  Loops along x are
+  /// unit-stride with no branches so that they vectorize, and rows
+  /// are tiled along y.  If Z is not NULL, also return
+  /// DOT(Y,Z) over zones g <= i < m - g, computed on each row of Y
+  /// while it is still in cache
+
+  template <class T, int RANK, int ORDER>
+  long double laplace_kernel
+  (T * Y, const T * X, const T * Z,
+   int mx, int my, int mz,
+   double hx, double hy, double hz,
+   int g0, int gx, int gy, int gz)
+  {
+    typedef LaplaceStencil<ORDER> S;
+    const int r = S::radius;
+
+    g0 = std::max(int(r),g0);
+
+    const double dx =              1.0/(S::denominator()*hx*hx);
+    const double dy = (RANK >= 2) ? 1.0/(S::denominator()*hy*hy) : 0.0;
+    const double dz = (RANK >= 3) ? 1.0/(S::denominator()*hz*hz) : 0.0;
+
+    T c0 = S::coefficient(0)*(dx + dy + dz);
+    T cx[r+1], cy[r+1], cz[r+1];
+    for (int k=1; k<=r; k++) {
+      cx[k] = S::coefficient(k)*dx;
+      cy[k] = S::coefficient(k)*dy;
+      cz[k] = S::coefficient(k)*dz;
+    }
+
+    const int idy = mx;
+    const int idz = mx*my;
+
+    const int ix0 = g0;
+    const int ix1 = mx - g0;
+    const int iy0 = (RANK >= 2) ? g0 : 0;
+    const int iy1 = (RANK >= 2) ? my - g0 : 1;
+    const int iz0 = (RANK >= 3) ? g0 : 0;
+    const int iz1 = (RANK >= 3) ? mz - g0 : 1;
+
+    long double dot = 0.0;
+
+    for (int jy=iy0; jy<iy1; jy+=laplace_tile_y) {
+      const int ky = std::min(jy+laplace_tile_y,iy1);
+      for (int iz=iz0; iz<iz1; iz++) {
+	for (int iy=jy; iy<ky; iy++) {
+
+	  const int i = mx*(iy + my*iz);
+	  const T * x = X + i;
+	  T * y = Y + i;
+
+	  for (int ix=ix0; ix<ix1; ix++) {
+	    T sum = c0*x[ix];
+	    for (int k=1; k<=r; k++) {
+	      sum += cx[k]*(x[ix-k] + x[ix+k]);
+	      if (RANK >= 2) sum += cy[k]*(x[ix-k*idy] + x[ix+k*idy]);
+	      if (RANK >= 3) sum += cz[k]*(x[ix-k*idz] + x[ix+k*idz]);
+	    }
+	    y[ix] = sum;
+	  }
+
+	  if (Z != NULL &&
+	      gy <= iy && iy < my - gy &&
+	      gz <= iz && iz < mz - gz) {
+	    const T * z = Z + i;
+	    T row_dot = 0.0;
+	    for (int ix=gx; ix<mx-gx; ix++) {
+	      row_dot += y[ix]*z[ix];
+	    }
+	    dot += row_dot;
+	  }
+	}
+      }
+    }
+    return dot;
+  }
+
+  //----------------------------------------------------------------------
+
+  template <class T, int RANK>
+  long double laplace_kernel_order
+  (int order,
+   T * Y, const T * X, const T * Z,
+   int mx, int my, int mz,
+   double hx, double hy, double hz,
+   int g0, int gx, int gy, int gz)
+  {
+    if (order == 2) {
+      return laplace_kernel<T,RANK,2>
+	(Y,X,Z,mx,my,mz,hx,hy,hz,g0,gx,gy,gz);
+    } else if (order == 4) {
+      return laplace_kernel<T,RANK,4>
+	(Y,X,Z,mx,my,mz,hx,hy,hz,g0,gx,gy,gz);
+    } else if (order == 6) {
+      return laplace_kernel<T,RANK,6>
+	(Y,X,Z,mx,my,mz,hx,hy,hz,g0,gx,gy,gz);
+    } else {
+      ERROR1 ("EnzoMatrixLaplace::matvec()",
+	      "Order %d operator is not supported",
+	      order);
+      return 0.0;
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+
+template <class T>
+long double EnzoMatrixLaplace::matvec_
+(T * Y, const T * X, int g0,
+ const T * Z, int gx, int gy, int gz) const throw()
+{
+  const int rank = cello::rank();
+
+  if (rank == 1) {
+    return laplace_kernel_order<T,1>
+      (order_,Y,X,Z,mx_,my_,mz_,hx_,hy_,hz_,g0,gx,gy,gz);
+  } else if (rank == 2) {
+    return laplace_kernel_order<T,2>
+      (order_,Y,X,Z,mx_,my_,mz_,hx_,hy_,hz_,g0,gx,gy,gz);
+  } else {
+    return laplace_kernel_order<T,3>
+      (order_,Y,X,Z,mx_,my_,mz_,hx_,hy_,hz_,g0,gx,gy,gz);
+  }
+}
+
+//----------------------------------------------------------------------
+
 void EnzoMatrixLaplace::matvec (int i_y, int i_x, Block * block,
 				int g0) throw()
 {
@@ -28,11 +192,49 @@ void EnzoMatrixLaplace::matvec (int i_y, int i_x, Block * block,
 
 //----------------------------------------------------------------------
 
+long double EnzoMatrixLaplace::matvec_dot
+(int i_y, int i_x, int i_z, Block * block, int g0) throw()
+{
+  Field field = block->data()->field();
+
+  field.dimensions(0,&mx_,&my_,&mz_);
+  block->cell_width (&hx_,&hy_,&hz_);
+
+  int gx,gy,gz;
+  field.ghost_depth(i_y,&gx,&gy,&gz);
+
+  enzo_float * X = (enzo_float * ) field.values(i_x);
+  enzo_float * Y = (enzo_float * ) field.values(i_y);
+  enzo_float * Z = (enzo_float * ) field.values(i_z);
+
+  const int g0_min = std::max(g0,ghost_depth());
+
+  ASSERT4 ("EnzoMatrixLaplace::matvec_dot()",
+	   "Ghost depth (%d %d %d) must be at least %d",
+	   gx,gy,gz,g0_min,
+	   (gx >= g0_min) &&
+	   (cello::rank() < 2 || gy >= g0_min) &&
+	   (cello::rank() < 3 || gz >= g0_min));
+
+  return matvec_(Y,X,g0,Z,gx,gy,gz);
+}
+
+//----------------------------------------------------------------------
+
 void EnzoMatrixLaplace::matvec
 (precision_type precision,
  void * y, void * x, int g0) throw()
 {
-  matvec_((enzo_float *)(y),(enzo_float *)(x),g0);
+  if (precision == precision_single) {
+    matvec_((float *)(y),(float *)(x),g0);
+  } else if (precision == precision_double) {
+    matvec_((double *)(y),(double *)(x),g0);
+  } else if (precision == precision_quadruple) {
+    matvec_((long double *)(y),(long double *)(x),g0);
+  } else {
+    ERROR1 ("EnzoMatrixLaplace::matvec()",
+	    "precision %d not recognized", precision);
+  }
 }
 
 //----------------------------------------------------------------------
@@ -51,195 +253,6 @@ void EnzoMatrixLaplace::diagonal (int i_x, Block * block, int g0) throw()
 
 //----------------------------------------------------------------------
 
-void EnzoMatrixLaplace::matvec_
-(enzo_float * Y, enzo_float * X, int g0) const throw()
-{
-  const int idx = 1;
-  const int idy = mx_;
-  const int idz = mx_*my_;
-
-  const int rank = cello::rank();
-
-  if (order_ == 2) {
-
-    g0 = std::max(1,g0);
-
-    double dx = (rank >= 1) ? 1.0 / (hx_*hx_) : 0.0;
-    double dy = (rank >= 2) ? 1.0 / (hy_*hy_) : 0.0;
-    double dz = (rank >= 3) ? 1.0 / (hz_*hz_) : 0.0;
-
-    if (rank == 1) {
-      for (int ix=g0; ix<mx_-g0; ix++) {
-	const int i = ix;
-	Y[i] = ( X[i-idx] - 2.0*X[i] + X[i+idx] ) * dx;
-      }
-
-    } else if (rank == 2) {
-      for   (int iy=g0; iy<my_-g0; iy++) {
-	for (int ix=g0; ix<mx_-g0; ix++) {
-	  const int i = ix + mx_*iy;
-	  Y[i] = ( X[i+idx] - 2.0*X[i] + X[i-idx]) * dx
-	    +    ( X[i+idy] - 2.0*X[i] + X[i-idy]) * dy;
-	}
-      }
-
-    } else if (rank == 3) {
-      for     (int iz=g0; iz<mz_-g0; iz++) {
-	for   (int iy=g0; iy<my_-g0; iy++) {
-	  for (int ix=g0; ix<mx_-g0; ix++) {
-	    const int i = ix + mx_*(iy + my_*iz);
-	    Y[i] = ( X[i+idx] - 2.0*X[i] + X[i-idx]) * dx
-	      +    ( X[i+idy] - 2.0*X[i] + X[i-idy]) * dy
-	      +    ( X[i+idz] - 2.0*X[i] + X[i-idz]) * dz;
-	  }
-	}
-      }
-    }
-
-  } else if (order_ == 4) {
-
-    const int idx2 = 2*idx;
-    const int idy2 = 2*idy;
-    const int idz2 = 2*idz;
-
-    g0 = std::max(2,g0);
-
-    const enzo_float c0 = -30.0;
-    const enzo_float c1 = 16.0;
-    const enzo_float c2 = -1.0;
-    const enzo_float dx = (rank >= 1) ? 1.0/(12.0*hx_*hx_) : 0.0;
-    const enzo_float dy = (rank >= 2) ? 1.0/(12.0*hy_*hy_) : 0.0;
-    const enzo_float dz = (rank >= 3) ? 1.0/(12.0*hz_*hz_) : 0.0;
-
-    const enzo_float c0x = c0*dx;
-    const enzo_float c1x = c1*dx;
-    const enzo_float c2x = c2*dx;
-    const enzo_float c0y = c0*dy;
-    const enzo_float c1y = c1*dy;
-    const enzo_float c2y = c2*dy;
-    const enzo_float c0z = c0*dz;
-    const enzo_float c1z = c1*dz;
-    const enzo_float c2z = c2*dz;
-
-    if (rank == 1) {
-
-      for (int ix=g0; ix<mx_-g0; ix++) {
-	const int i = ix;
-	Y[i] = (c0*(X[i]) +
-		c1*(X[i-idx] +X[i+idx]) +
-		c2*(X[i-idx2]+X[i+idx2])) * dx;
-      }
-
-    } else if (rank == 2) {
-
-      for   (int iy=g0; iy<my_-g0; iy++) {
-	for (int ix=g0; ix<mx_-g0; ix++) {
-	  const int i = ix + mx_*iy;
-	  Y[i] = (c0*(X[i]) +
-		  c1*(X[i-idx] +X[i+idx]) +
-		  c2*(X[i-idx2]+X[i+idx2])) * dx
-	    +    (c0*(X[i]) +
-		  c1*(X[i-idy] +X[i+idy]) +
-		  c2*(X[i-idy2]+X[i+idy2])) * dy;
-	}
-      }
-
-    } else if (rank == 3) {
-
-      for     (int iz=g0; iz<mz_-g0; iz++) {
-	for   (int iy=g0; iy<my_-g0; iy++) {
-	  for (int ix=g0; ix<mx_-g0; ix++) {
-	    const int i = ix + mx_*(iy + my_*iz);
-	    enzo_float * xp = X + i;
-	    Y[i] = (c0x*(xp[0]) +
-		    c1x*(xp[-idx] +xp[idx]) +
-		    c2x*(xp[-idx2]+xp[idx2]))
-	      +    (c0y*(xp[0]) +
-		    c1y*(xp[-idy] +xp[idy]) +
-		    c2y*(xp[-idy2]+xp[idy2]))
-	      +    (c0z*(xp[0]) +
-		    c1z*(xp[-idz] +xp[idz]) +
-		    c2z*(xp[-idz2]+xp[idz2]));
-	  }
-	}
-      }
-    }
-  } else if (order_ == 6) {
-
-    const int idx2 = 2*idx;
-    const int idy2 = 2*idy;
-    const int idz2 = 2*idz;
-    const int idx3 = 3*idx;
-    const int idy3 = 3*idy;
-    const int idz3 = 3*idz;
-
-    g0 = std::max(3,g0);
-
-    const enzo_float c0 = -2720.0;
-    const enzo_float c1 = 1455.0;
-    const enzo_float c2 = -96.0;
-    const enzo_float c3 = 1.0;
-    const enzo_float dx = (rank >= 1) ? 1.0/(1080.0*hx_*hx_) : 0.0;
-    const enzo_float dy = (rank >= 2) ? 1.0/(1080.0*hy_*hy_) : 0.0;
-    const enzo_float dz = (rank >= 3) ? 1.0/(1080.0*hz_*hz_) : 0.0;
-
-    if (rank == 1) {
-
-      for (int ix=g0; ix<mx_-g0; ix++) {
-	const int i = ix;
-	Y[i] = (c0*(X[i]) +
-		c1*(X[i-idx] +X[i+idx]) +
-		c2*(X[i-idx2]+X[i+idx2]) +
-		c3*(X[i-idx3]+X[i+idx3])) * dx;
-      }
-
-    } else if (rank == 2) {
-
-      for   (int iy=g0; iy<my_-g0; iy++) {
-	for (int ix=g0; ix<mx_-g0; ix++) {
-	  const int i = ix + mx_*iy;
-	  Y[i] = (c0*(X[i]) +
-		  c1*(X[i-idx] +X[i+idx]) +
-		  c2*(X[i-idx2]+X[i+idx2]) +
-		  c3*(X[i-idx3]+X[i+idx3])) * dx
-	    +    (c0*(X[i]) +
-		  c1*(X[i-idy] +X[i+idy]) +
-		  c2*(X[i-idy2]+X[i+idy2]) +
-		  c3*(X[i-idy3]+X[i+idy3])) * dy;
-	}
-      }
-
-    } else if (rank == 3) {
-
-      for     (int iz=g0; iz<mz_-g0; iz++) {
-	for   (int iy=g0; iy<my_-g0; iy++) {
-	  for (int ix=g0; ix<mx_-g0; ix++) {
-	    const int i = ix + mx_*(iy + my_*iz);
-	    Y[i] = (c0*(X[i]) +
-		    c1*(X[i-idx] +X[i+idx]) +
-		    c2*(X[i-idx2]+X[i+idx2]) +
-		    c3*(X[i-idx3]+X[i+idx3])) * dx
-	      +    (c0*(X[i]) +
-		    c1*(X[i-idy] +X[i+idy]) +
-		    c2*(X[i-idy2]+X[i+idy2]) +
-		    c2*(X[i-idy3]+X[i+idy3])) * dy
-	      +    (c0*(X[i]) +
-		    c1*(X[i-idz] +X[i+idz]) +
-		    c2*(X[i-idz2]+X[i+idz2]) +
-		    c3*(X[i-idz3]+X[i+idz3])) * dz;
-	  }
-	}
-      }
-    }
-  } else {
-    ERROR1 ("EnzoMatrixLaplace::diagonal()",
-	    "Order %d operator is not supported",
-	    order_);
-  } 
-}
-
-//----------------------------------------------------------------------
-
 void EnzoMatrixLaplace::diagonal_ (enzo_float * X, int g0) const throw()
 {
   const int rank = cello::rank();
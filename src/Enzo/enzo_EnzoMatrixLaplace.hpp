@@ -82,6 +82,11 @@ public: // virtual functions
   /// Apply the matrix to a vector Y <-- A*X
   virtual void matvec (int id_y, int id_x, Block * block, int g0=1) throw();
 
+  /// Apply the matrix Y <-- A*X and return DOT(Y,Z), computed with
+  /// Y while it is in cache
+  virtual long double matvec_dot (int id_y, int id_x, int id_z,
+				  Block * block, int g0=1) throw();
+
   /// Low-level matvec, useful for non-Block arrays (e.g. Block-local
   /// multigrid).  Must call set_cell_width and set_dimensions first
   /// manually!
@@ -101,7 +106,12 @@ public: // virtual functions
 
 protected: // functions
 
-  void matvec_ (enzo_float * Y, enzo_float * X, int g0) const throw();
+  /// Apply the rank- and order-specialized kernel; if Z is not NULL
+  /// return DOT(Y,Z) over zones excluding ghost depths gx,gy,gz
+  template <class T>
+  long double matvec_ (T * Y, const T * X, int g0,
+		       const T * Z = NULL,
+		       int gx = 0, int gy = 0, int gz = 0) const throw();
 
   void diagonal_ (enzo_float * X, int g0) const throw();
 
@@ -110,7 +120,7 @@ protected: // attributes
   int mx_, my_, mz_;
   int nx_, ny_, nz_;
   double hx_, hy_, hz_;
-  /// Order of the operator, 2 or 4
+  /// Order of the operator, 2, 4, or 6
   int order_;
 
 };
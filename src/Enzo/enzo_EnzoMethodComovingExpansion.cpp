@@ -30,6 +30,17 @@ EnzoMethodComovingExpansion::EnzoMethodComovingExpansion
   if (rank >= 2) refresh(ir)->add_field(field_descr->field_id("velocity_y"));
   if (rank >= 3) refresh(ir)->add_field(field_descr->field_id("velocity_z"));
 
+  // Declare modified fields so later refreshes can be merged into
+  // this one
+
+  add_field_written("density");
+  add_field_written("total_energy");
+  add_field_written("internal_energy");
+  add_field_written("velocity_x");
+  add_field_written("velocity_y");
+  add_field_written("velocity_z");
+  add_field_written("pressure");
+
   if ( ! comoving_coordinates_ ) {
     WARNING
       ("EnzoMethodComovingExpansion::EnzoMethodComovingExpansion()",
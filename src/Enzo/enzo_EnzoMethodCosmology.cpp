@@ -16,6 +16,8 @@
 EnzoMethodCosmology::EnzoMethodCosmology() throw()
 : Method ()
 {
+  // Only updates cosmological parameters; no fields are modified
+  set_field_list_written (std::vector<int>());
 }
 
 //----------------------------------------------------------------------
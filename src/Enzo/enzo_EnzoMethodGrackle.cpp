@@ -129,6 +129,18 @@ EnzoMethodGrackle::EnzoMethodGrackle
                        enzo_sync_id_method_grackle);
   refresh(ir)->add_all_fields();
 
+  // Declare modified fields so later refreshes can be merged into
+  // this one
+
+  add_field_written("density");
+  add_field_written("internal_energy");
+  add_field_written("total_energy");
+  add_field_written("pressure");
+  add_field_written("temperature");
+  add_field_written("cooling_time");
+  add_field_written("metal_density");
+  add_group_written("color");
+
   /// Define Grackle's internal data structures
   time_grackle_data_initialized_ = ENZO_FLOAT_UNDEFINED;
   this->initialize_grackle_chemistry_data(time);
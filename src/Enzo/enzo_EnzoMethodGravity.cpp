@@ -189,6 +189,22 @@ EnzoMethodGravity::EnzoMethodGravity
     refresh(ir)->add_field_src_dst(idebug1,idebug2);
 #endif    
   }
+
+  // Declare modified fields so later refreshes can be merged into
+  // this one
+
+  add_field_written("potential");
+  add_field_written("B");
+  add_field_written("density_total");
+  add_field_written("acceleration_x");
+  add_field_written("acceleration_y");
+  add_field_written("acceleration_z");
+  add_field_written("B_copy");
+  add_field_written("density_total_copy");
+  add_field_written("potential_copy");
+  if (accumulate) {
+    add_field_written("density_particle_accumulate");
+  }
 }
 
 //----------------------------------------------------------------------
@@ -76,6 +76,10 @@ public: // interface
   /// Compute maximum timestep for this method
   virtual double timestep (Block * block) const throw() ;
 
+  /// Linear solvers reduce over all Blocks
+  virtual bool is_global_reduction () const throw()
+  { return true; }
+
   /// Compute accelerations from potential and exit solver
   void compute_accelerations (EnzoBlock * enzo_block) throw();
   
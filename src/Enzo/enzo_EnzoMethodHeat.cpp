@@ -24,6 +24,10 @@ EnzoMethodHeat::EnzoMethodHeat (double alpha, double courant)
   FieldDescr * field_descr = cello::field_descr();
   
   refresh(ir)->add_field(field_descr->field_id("temperature"));
+
+  std::vector<int> field_list;
+  field_list.push_back(field_descr->field_id("temperature"));
+  set_field_list_written (field_list);
 }
 
 //----------------------------------------------------------------------
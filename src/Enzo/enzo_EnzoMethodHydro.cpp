@@ -67,6 +67,17 @@ EnzoMethodHydro::EnzoMethodHydro
   refresh(ir)->add_field(field_descr->field_id("total_energy"));
   refresh(ir)->add_field(field_descr->field_id("pressure"));
 
+  // Declare modified fields so later refreshes can be merged into
+  // this one
+
+  add_field_written("density");
+  add_field_written("velocity_x");
+  add_field_written("velocity_y");
+  add_field_written("velocity_z");
+  add_field_written("total_energy");
+  add_field_written("internal_energy");
+  add_field_written("pressure");
+  add_group_written("color");
 }
 
 //----------------------------------------------------------------------
@@ -110,6 +121,14 @@ void EnzoMethodHydro::compute ( Block * block) throw()
     return;
   }
 
+  if (method_ == "ppm") {
+    ppm_method_(block);
+  } else {
+    ERROR1 ("EnzoMethodHydro::compute()",
+	    "Unknown Method:hydro:method \"%s\"",
+	    method_.c_str());
+  }
+
   /* initialize */
 
   //     // MAX_COLOR is defined in fortran.def
@@ -656,1422 +675,188 @@ void EnzoMethodHydro::compute ( Block * block) throw()
 
 void EnzoMethodHydro::ppm_method_ ( Block * block )
 {
+  EnzoBlock * enzo_block = enzo::block(block);
 
   Field field = block->data()->field();
-  
-  // Assume gravity if acceleration fields exist
-  
-  int mx,my,mz;
-  field.dimensions (0,&mx,&my,&mz);
-
-  // compute pressure
-
-  EnzoComputePressure compute_pressure (gamma_,	comoving_coordinates_);
-  compute_pressure.compute(block);
 
-  const int cycle = block->cycle();
-  const int rank  = cello::rank();
-
-  for (int i0=0; i0<3; i0++) {
-    int i = (i0 + cycle) % rank;
+  const int rank = cello::rank();
 
-    // update in x-direction
-    if ((mx > 1) && (i % rank == 0)) {
-      for (int iz=0; iz<mz; iz++) {
-	ppm_euler_x_(block,iz);    }
-    }
-    // update in y-direction
-    if ((my > 1) && (i % rank == 1)) {
-      for (int ix=0; ix<mx; ix++) {
-	ppm_euler_y_(block,ix);
-      }
-    }
-    // update in z-direction
-    if ((mz > 1) && (i % rank == 2 )) {
-      for (int iy=0; iy<my; iy++) {
-	ppm_euler_z_(block,iy);
-      }
-    }
+  int m3[3] = {1,1,1};
+  int g3[3] = {0,0,0};
+  int n3[3] = {1,1,1};
+  field.dimensions  (0,&m3[0],&m3[1],&m3[2]);
+  field.ghost_depth (0,&g3[0],&g3[1],&g3[2]);
+  field.size        (&n3[0],&n3[1],&n3[2]);
+
+  for (int axis=rank; axis<3; axis++) {
+    m3[axis] = 1;
+    g3[axis] = 0;
+    n3[axis] = 1;
   }
-}
-
-//----------------------------------------------------------------------
 
-void EnzoMethodHydro::ppm_euler_x_(Block * block, int iz)
-{
-  // int dim = 0, idim = 1, jdim = 2;
-  // int dim_p1 = dim+1;   // To match definition in calcdiss
-  // int ierr = 0;
-
-  // /* Find fields: density, total energy, velocity1-3. */
-
-  // int DensNum, GENum, Vel1Num, Vel2Num, Vel3Num, TENum;
-  
-  // this->IdentifyPhysicalQuantities(DensNum, GENum, Vel1Num, Vel2Num, 
-  // 				   Vel3Num, TENum);
-
-  // int nxz, nyz, nzz, ixyz;
+  const int mx = m3[0];
+  const int my = m3[1];
+  const int mz = m3[2];
 
-  // nxz = GridEndIndex[0] - GridStartIndex[0] + 1;
-  // nyz = GridEndIndex[1] - GridStartIndex[1] + 1;
-  // nzz = GridEndIndex[2] - GridStartIndex[2] + 1;
+  Scratch * scratch = Scratch::instance();
+  const size_t scratch_mark = scratch->mark();
 
-  // float MinimumPressure = tiny_number;
-  
-  // // Copy from field to slice
+  enzo_float * d  = (enzo_float *) field.values("density");
+  enzo_float * e  = (enzo_float *) field.values("total_energy");
+  enzo_float * ge = dual_energy_ ?
+    (enzo_float *) field.values("internal_energy") : NULL;
 
-  // float *dslice, *eslice, *uslice, *vslice, *wslice, *grslice, *geslice, 
-  //   *colslice, *pslice;
+  // velocity components beyond rank are advected as zero
 
+  enzo_float * v3[3];
+  v3[0] = (enzo_float *) field.values("velocity_x");
+  v3[1] = (rank >= 2) ? (enzo_float *) field.values("velocity_y")
+    : scratch->allocate<enzo_float>(mx*my*mz,0.0);
+  v3[2] = (rank >= 3) ? (enzo_float *) field.values("velocity_z")
+    : scratch->allocate<enzo_float>(mx*my*mz,0.0);
 
-  Field field = block->data()->field();
-  
-  int mx,my,mz;
-  field.dimensions (0,&mx,&my,&mz);
-
-  int nx,ny,nz;
-  field.size (&nx,&ny,&nz);
-
-  int gx,gy,gz;
-  field.ghost_depth (0,&gx,&gy,&gz);
-
-  // determine temporary array size
-
-  //   ... compute slice size
-  const int ns = mx*my;
-
-  int na = 0;
-
-  // ...density, total energy, velocities, pressure
-  na += 6*ns;
-
-  // ...add slice for gravity if needed
-  if (gravity_) na += 1*ns;
-
-  // ... add slice for gas energy if needed
-  if (dual_energy_) na += 1*ns;
-
-  // ... add slices for color fields
-  Grouping * field_groups = block->data()->field().groups();
-  int nc = field_groups->size("color");
-  na += nc*ns;
-
-  // allocate array
-  enzo_float * slice_array = new enzo_float [na];
-
-  // initialize array of slices
-  
-  enzo_float * pa = slice_array;
-
-  // ...density, pressure, and velocities
-  enzo_float * dslice = pa; pa += ns;
-  enzo_float * eslice = pa; pa += ns;
-  enzo_float * pslice = pa; pa += ns;
-  enzo_float * uslice = pa; pa += ns;
-  enzo_float * vslice = pa; pa += ns;
-  enzo_float * wslice = pa; pa += ns;
-
-  // ...add slice for gravity if needed
-  enzo_float * grslice = NULL;
-  if (gravity_) {
-    grslice = pa; pa +=ns;
-  }
-  
-  // ... add slice for gas energy if needed
-  enzo_float * geslice = NULL;
-  if (dual_energy_) {
-    geslice = pa; pa +=ns;
-  }
-
-  // add slices for color fields
-  enzo_float * colslice = NULL;
-  if (nc > 0) {
-    colslice = pa; pa += nc*ns;
-  }
-
-  enzo_float * de = (enzo_float *) field.values("density");
-  enzo_float * te = (enzo_float *) field.values("total_energy");
-  enzo_float * vx = (enzo_float *) field.values("velocity_x");
-  enzo_float * vy = (enzo_float *) field.values("velocity_y");
-  enzo_float * vz = (enzo_float *) field.values("velocity_z");
-  enzo_float * pr = (enzo_float *) field.values("pressure");
-
-  const int rank = cello::rank();
-  
-  for (int iy=0; iy<my; iy++) {
-    for (int ix=0; ix<mx; ix++) {
-      int i  = ix + mx*(iy + my*iz);
-      int is = ix + mx*iy;
-      dslice[is] = de[i];
-      eslice[is] = te[i];
-      pslice[is] = pr[i];
-      uslice[is] = vx[i];
-      vslice[is] = (rank >= 2) ? vy[i] : 0.0;
-      wslice[is] = (rank >= 3) ? vz[i] : 0.0;
-    } // ENDFOR i
-  }
+  // Assume gravity if acceleration fields exist
 
-  if (gravity_) {
-    enzo_float * ax = (enzo_float *) field.values("acceleration_x");
-    for (int iy=0; iy<my; iy++) {
-      for (int ix=0; ix<mx; ix++) {
-	int i  = ix + mx*(iy + my*iz);
-	int is = ix + mx*iy;
-	grslice[is] = ax[i];
-      }
-    }
-  }
+  const int gravity = field.is_field("acceleration_x") ? 1 : 0;
 
-  if (dual_energy_) {
-    enzo_float * ei = (enzo_float *) field.values("internal_energy");
-    for (int iy=0; iy<my; iy++) {
-      for (int ix=0; ix<mx; ix++) {
-	int i  = ix + mx*(iy + my*iz);
-	int is = ix + mx*iy;
-	geslice[is] = ei[i];
-      }
-    }
+  enzo_float * a3[3] = {NULL,NULL,NULL};
+  if (gravity) {
+    a3[0] = (enzo_float *) field.values("acceleration_x");
+    if (rank >= 2) a3[1] = (enzo_float *) field.values("acceleration_y");
+    if (rank >= 3) a3[2] = (enzo_float *) field.values("acceleration_z");
   }
 
-  for (int ic=0; ic<nc; ic++) {
-    enzo_float * c = (enzo_float *)
-      field.values(field_groups->item("color",ic));
-    for (int iy=0; iy<my; iy++) {
-      for (int ix=0; ix<mx; ix++) {
-	int i = ix + mx*(iy + my*iz);
-	int k = ix + mx*(iy + my*ic);
-	colslice[k] = c[i];
-      }
+  // color fields
+
+  const int nc = field.groups()->size("color");
+  enzo_float ** c = (nc > 0) ? scratch->allocate<enzo_float *>(nc) : NULL;
+  int ic = 0;
+  for (int index_field = 0;
+       index_field < field.field_count();
+       index_field++) {
+    std::string name = field.field_name(index_field);
+    if (field.groups()->is_in(name,"color")) {
+      c[ic++] = (enzo_float *) field.values(index_field);
     }
   }
-    
-  ASSERT2("EnzoMethodHydro::ppm_xeuler_x",
-	  "temporary slice array actual size %d differs from expected size %d",
-	  (pa-slice_array), na,
-	  ((pa -slice_array) == na));
-
-  // Allocate memory for fluxes
-
-  enzo_float *dls, *drs, *flatten, *pbar, *pls, *prs, *ubar, *uls, *urs, *vls, 
-    *vrs, *gels, *gers, *wls, *wrs, *diffcoef, *df, *ef, *uf, *vf, *wf, *gef,
-    *ges, *colf, *colls, *colrs;
-
-  int nf = (23 + 3*nc)*ns;
-  
-  enzo_float * fluxes_array = new enzo_float [nf];
-
-  enzo_float * pf = fluxes_array;
-  
-  dls      = pf; pf += ns;
-  drs      = pf; pf += ns;	
-  flatten  = pf; pf += ns;	
-  pbar     = pf; pf += ns;	
-  pls      = pf; pf += ns;	
-  prs      = pf; pf += ns;	
-  ubar     = pf; pf += ns;	
-  uls      = pf; pf += ns;	
-  urs      = pf; pf += ns;	
-  vls      = pf; pf += ns;	
-  vrs      = pf; pf += ns;	
-  gels     = pf; pf += ns;	
-  gers     = pf; pf += ns;	
-  wls      = pf; pf += ns;	
-  wrs      = pf; pf += ns;	
-  diffcoef = pf; pf += ns;	
-  df       = pf; pf += ns;		
-  ef       = pf; pf += ns;		
-  uf       = pf; pf += ns;		
-  vf       = pf; pf += ns;		
-  wf       = pf; pf += ns;		
-  gef      = pf; pf += ns;	
-  ges      = pf; pf += ns;	
-  colf     = pf; pf += nc*ns;
-  colls    = pf; pf += nc*ns;
-  colrs    = pf; pf += nc*ns;
-
-  ASSERT2("EnzoMethodHydro::ppm_xeuler_x",
-	  "temporary fluxes array actual size %d differs from expected size %d",
-	  (pf-fluxes_array), nf,
-	  ((pf -fluxes_array) == nf));
-
-  // Convert start and end indexes into 1-based for FORTRAN
-
-  // int is, ie, js, je, is_m3, ie_p3, ie_p1, k_p1;
-
-  // is = GridStartIndex[0] + 1;
-  // ie = GridEndIndex[0] + 1;
-  // js = 1;
-  // je = my;
-  // is_m3 = is - 3;
-  // ie_p1 = ie + 1;
-  // ie_p3 = ie + 3;
-  // k_p1 = k + 1;
-
-  // Compute the pressure on a slice
-
-  int is = 1 + gx;
-  int ie = 1 + gx+nx;
-  int js = 1;
-  int je = my;
-  int ie_p1 = ie + 1;
-  int k_p1  = iz + 1;
-  
-
-  if (dual_energy_) {
-
-    FORTRAN_NAME(woc_pgas2d_dual)
-      (dslice, eslice, geslice, pslice, uslice, vslice, 
-       wslice, &dual_energy_eta1_,
-       &dual_energy_eta2_,
-       &mx,&my, &is, &ie, &js, &je, 
-       &gamma_, &ppm_pressure_floor_);
 
-  } else {
+  // If using comoving coordinates, multiply cell widths by a(n+1/2)
 
-    FORTRAN_NAME(woc_pgas2d)
-      (dslice, eslice, pslice, uslice, vslice, 
-       wslice, &mx, &my,
-       &is, &ie, &js, &je, &gamma_, &ppm_pressure_floor_);
-  }
+  const double time = block->time();
+  const double dt   = block->dt();
 
-  
-  // If requested, compute diffusion and slope flattening coefficients
+  enzo_float cosmo_a = 1.0, cosmo_dadt = 0.0;
 
-  // Adjust cell widths for cosmological expansion if needed
-  
   EnzoPhysicsCosmology * cosmology = enzo::cosmology();
 
-  enzo_float cosmo_a    = 1.0;
-  enzo_float cosmo_dadt = 0.0;
-  
-  if (cosmology) {
-    cosmology->compute_expansion_factor
-      (&cosmo_a, &cosmo_dadt, (enzo_float)block->time());
-  }
-
-  double h = 0.0;
-  block->cell_width(&h);
-
-  enzo_float hxa = cosmo_a*h;
-  enzo_float hya = cosmo_a*h;
-  enzo_float hza = cosmo_a*h;
-  
-  enzo_float dt = block->dt();
-  
-  enzo_float * flatten_array = new enzo_float[ns];
-
-  int riemann_solver_fallback = 1;
-  
-  if (ppm_diffusion_ || ppm_flattening_) {
-
-    int dim_p1 = 1;
-
-    FORTRAN_NAME(woc_calcdiss)(dslice, eslice, uslice,
-			   vy, vz,
-			   pslice,
-			   &hxa, &hya, &hza,
-			   &mx,  &my, &mz,
-  			   &is, &ie, &js, &je, &k_p1,
-  			   &nz, &dim_p1, &mx, &my, &mz,
-  			   &dt, &gamma_, &ppm_diffusion_,
-  			   &ppm_flattening_, diffcoef, flatten_array);
+  ASSERT ("EnzoMethodHydro::ppm_method_()",
+	  "comoving_coordinates enabled but missing EnzoPhysicsCosmology",
+	  ! (comoving_coordinates_ && (cosmology == NULL)) );
 
+  if (comoving_coordinates_) {
+    cosmology->compute_expansion_factor(&cosmo_a, &cosmo_dadt, time+0.5*dt);
   }
 
-  // Compute Eulerian left and right states at zone edges via interpolation
-
-  if (reconstruct_method_ == "ppm") {
-
-    FORTRAN_NAME(woc_inteuler)
-      (dslice, pslice, &gravity_, grslice, geslice, uslice,
-       vslice, wslice, &hxa, flatten,
-       &mx, &my,
-       &is, &ie, &js, &je, &dual_energy_,
-       &dual_energy_eta1_, &dual_energy_eta2_,
-       &ppm_steepening_, &ppm_flattening_,
-       &reconstruct_conservative_, &reconstruct_positive_,
-       &dt, &gamma_, &ppm_pressure_free_, 
-       dls, drs, pls, prs, gels, gers, uls, urs, vls, vrs,
-       wls, wrs, &nc, colslice, colls, colrs);
+  enzo_float h3[3];
+  for (int axis=0; axis<3; axis++) {
+    h3[axis] = (axis < rank) ? (cosmo_a*enzo_block->CellWidth[axis]) : 1.0;
   }
 
-  // Compute (Lagrangian part of the) Riemann problem at each zone boundary
-
-  if (riemann_solver_ == "two_shock") {
-
-    FORTRAN_NAME(woc_twoshock)
-      (dls, drs, pls, prs, uls, urs,
-       &mx, &my,
-       &is, &ie_p1, &js, &je,
-       &dt, &gamma_, &ppm_pressure_floor_, &ppm_pressure_free_,
-       pbar, ubar, &gravity_, grslice,
-       &dual_energy_, &dual_energy_eta1_);
-    
-    FORTRAN_NAME(woc_flux_twoshock)
-      (dslice, eslice, geslice, uslice, vslice, wslice,
-       &hxa, diffcoef, 
-       &mx, &my,
-       &is, &ie, &js, &je, &dt, &gamma_,
-       &ppm_diffusion_, &dual_energy_,
-       &dual_energy_eta1_,
-       &riemann_solver_fallback,
-       dls, drs, pls, prs, gels, gers, uls, urs,
-       vls, vrs, wls, wrs, pbar, ubar,
-       df, ef, uf, vf, wf, gef, ges,
-       &nc, colslice, colls, colrs, colf);
-    
+  int riemann_solver = 0;
+  if (riemann_solver_ == "ppm" || riemann_solver_ == "two_shock") {
+    riemann_solver = EnzoHydroSweep::riemann_two_shock;
   } else if (riemann_solver_ == "hll") {
-
-    FORTRAN_NAME(woc_flux_hll)
-      (dslice, eslice, geslice, uslice, vslice, wslice,
-       &hxa, diffcoef, 
-       &mx, &my,
-       &is, &ie, &js, &je, &dt, &gamma_,
-       &ppm_diffusion_, &dual_energy_,
-       &dual_energy_eta1_,
-       &riemann_solver_fallback,
-       dls, drs, pls, prs, uls, urs,
-       vls, vrs, wls, wrs, gels, gers,
-       df, uf, vf, wf, ef, gef, ges,
-       &nc, colslice, colls, colrs, colf);
-
+    riemann_solver = EnzoHydroSweep::riemann_hll;
   } else if (riemann_solver_ == "hllc") {
-
-    FORTRAN_NAME(woc_flux_hllc)
-      (dslice, eslice, geslice, uslice, vslice, wslice,
-       &hxa, diffcoef, 
-       &mx, &my,
-       &is, &ie, &js, &je, &dt, &gamma_,
-       &ppm_diffusion_, &dual_energy_,
-       &dual_energy_eta1_,
-       &riemann_solver_fallback,
-       dls, drs, pls, prs, uls, urs,
-       vls, vrs, wls, wrs, gels, gers,
-       df, uf, vf, wf, ef, gef, ges,
-       &nc, colslice, colls, colrs, colf);
-
+    riemann_solver = EnzoHydroSweep::riemann_hllc;
   } else {
-
-    for (int i = 0; i < ns; i++) {
-      df[i] = 0;
-      ef[i] = 0;
-      uf[i] = 0;
-      vf[i] = 0;
-      wf[i] = 0;
-      gef[i] = 0;
-      ges[i] = 0;
-    }
-
+    ERROR1 ("EnzoMethodHydro::ppm_method_()",
+	    "Unknown Method:hydro:riemann_solver \"%s\"",
+	    riemann_solver_.c_str());
   }
 
-  // Compute Eulerian fluxes and update zone-centered quantities
-
-  FORTRAN_NAME(woc_euler)
-    (dslice, eslice, grslice, geslice, uslice, vslice, wslice,
-     &hxa, diffcoef, 
-     &mx, &my, 
-     &is, &ie, &js, &je, &dt, &gamma_, 
-     &ppm_diffusion_, &gravity_, &dual_energy_, 
-     &dual_energy_eta1_, &dual_energy_eta2_,
-     df, ef, uf, vf, wf, gef, ges,
-     &nc, colslice, colf, &ppm_density_floor_);
-
-  // /* If necessary, recompute the pressure to correctly set ge and e */
-
-  // if (dual_energy_)
-  //   FORTRAN_NAME(woc_pgas2d_dual)(dslice, eslice, geslice, pslice, uslice, vslice, 
-  // 			      wslice, &dual_energy_eta1_, 
-  // 			      &dual_energy_eta2_, &mx, 
-  // 			      &my, &is_m3, &ie_p3, &js, &je, 
-  // 			      &gamma_, &ppm_pressure_floor_);
-
-  // /* Check this slice against the list of subgrids (all subgrid
-  //    quantities are zero-based) */
-
-  // int jstart, jend, offset, nfi, lface, rface, lindex, rindex, 
-  //   fistart, fiend, fjstart, fjend, clindex, crindex;
-  
-  // for (n = 0; n < NumberOfSubgrids; n++) {
+  EnzoHydroSweep hydro_sweep
+    (gamma_, gravity, dual_energy_,
+     dual_energy_eta1_, dual_energy_eta2_,
+     reconstruct_conservative_, reconstruct_positive_,
+     ppm_density_floor_, ppm_pressure_floor_, ppm_pressure_free_,
+     ppm_diffusion_, ppm_flattening_, ppm_steepening_,
+     riemann_solver);
 
-  //   fistart = SubgridFluxes[n]->RightFluxStartGlobalIndex[dim][idim] - 
-  //     GridGlobalStart[idim];
-  //   fiend = SubgridFluxes[n]->RightFluxEndGlobalIndex[dim][idim] -
-  //     GridGlobalStart[idim];
-  //   fjstart = SubgridFluxes[n]->RightFluxStartGlobalIndex[dim][jdim] - 
-  //     GridGlobalStart[jdim];
-  //   fjend = SubgridFluxes[n]->RightFluxEndGlobalIndex[dim][jdim] -
-  //     GridGlobalStart[jdim];
+  // alternate the order of the directional sweeps each cycle
 
-  //   if (k >= fjstart && k <= fjend) {
-
-  //     nfi = fiend - fistart + 1;
-  //     for (j = fistart; j <= fiend; j++) {
-
-  // 	offset = (j-fistart) + (k-fjstart)*nfi;
-
-  // 	lface = SubgridFluxes[n]->LeftFluxStartGlobalIndex[dim][dim] -
-  // 	  GridGlobalStart[dim];
-  // 	lindex = j * GridDimension[dim] + lface;
-
-  // 	rface = SubgridFluxes[n]->RightFluxStartGlobalIndex[dim][dim] -
-  // 	  GridGlobalStart[dim] + 1;
-  // 	rindex = j * GridDimension[dim] + rface;	
-
-  // 	SubgridFluxes[n]->LeftFluxes [DensNum][dim][offset] = df[lindex];
-  // 	SubgridFluxes[n]->RightFluxes[DensNum][dim][offset] = df[rindex];
-  // 	SubgridFluxes[n]->LeftFluxes [TENum][dim][offset]   = ef[lindex];
-  // 	SubgridFluxes[n]->RightFluxes[TENum][dim][offset]   = ef[rindex];
-  // 	SubgridFluxes[n]->LeftFluxes [Vel1Num][dim][offset] = uf[lindex];
-  // 	SubgridFluxes[n]->RightFluxes[Vel1Num][dim][offset] = uf[rindex];
-
-  // 	if (nyz > 1) {
-  // 	  SubgridFluxes[n]->LeftFluxes [Vel2Num][dim][offset] = vf[lindex];
-  // 	  SubgridFluxes[n]->RightFluxes[Vel2Num][dim][offset] = vf[rindex];
-  // 	} // ENDIF y-data
-
-  // 	if (nzz > 1) {
-  // 	  SubgridFluxes[n]->LeftFluxes [Vel3Num][dim][offset] = wf[lindex];
-  // 	  SubgridFluxes[n]->RightFluxes[Vel3Num][dim][offset] = wf[rindex];
-  // 	} // ENDIF z-data
-
-  // 	if (dual_energy_) {
-  // 	  SubgridFluxes[n]->LeftFluxes [GENum][dim][offset] = gef[lindex];
-  // 	  SubgridFluxes[n]->RightFluxes[GENum][dim][offset] = gef[rindex];
-  // 	} // ENDIF dual_energy_
-
-  // 	for (ncolor = 0; ncolor < nc; ncolor++) {
-  // 	  clindex = (j + ncolor * my) * GridDimension[dim] +
-  // 	    lface;
-  // 	  crindex = (j + ncolor * my) * GridDimension[dim] +
-  // 	    rface;
-
-  // 	  SubgridFluxes[n]->LeftFluxes [colnum[ncolor]][dim][offset] = 
-  // 	    colf[clindex];
-  // 	  SubgridFluxes[n]->RightFluxes[colnum[ncolor]][dim][offset] = 
-  // 	    colf[crindex];
-  // 	} // ENDFOR ncolor
-
-  //     } // ENDFOR J
-
-  //   } // ENDIF k inside
-
-  // } // ENDFOR n
-
-  // /* Copy from slice to field */
-
-  // for (j = 0; j < my; j++) {
-
-  //   index2 = j * mx;
-
-  //   for (i = 0; i < mx; i++) {
-  //     index3 = (k*my + j)*mx + i;
-  //     de[index3] = dslice[index2+i];
-  //     et[index3] = eslice[index2+i];
-  //     vx[index3] = uslice[index2+i];
-  //   } // ENDFOR i
-
-  //   if (GridRank > 1)
-  //     for (i = 0; i < mx; i++) {
-  // 	index3 = (k*my + j)*mx + i;
-  // 	vy[index3] = vslice[index2+i];
-  //     }
-
-  //   if (GridRank > 2)
-  //     for (i = 0; i < mx; i++) {
-  // 	index3 = (k*my + j)*mx + i;
-  // 	vz[index3] = wslice[index2+i];
-  //     }
-
-  //   if (dual_energy_)
-  //     for (i = 0; i < mx; i++) {
-  // 	index3 = (k*my + j)*mx + i;
-  // 	ei[index3] = geslice[index2+i];
-  //     }
-
-  //   for (n = 0; n < nc; n++) {
-  //     index2 = (n*my + j) * mx;
-  //     for (i = 0; i < mx; i++) {
-  // 	index3 = (k*my + j) * mx + i;
-  // 	BaryonField[colnum[n]][index3] = colslice[index2+i];
-  //     }
-  //   } // ENDFOR colors
-  // } // ENDFOR j
-
-  // deallocate array
-  delete [] flatten_array;
-  delete [] fluxes_array;
-  delete [] slice_array;
-}
-
-//----------------------------------------------------------------------
-
-void EnzoMethodHydro::ppm_euler_y_ (Block * block, int ix)
-{
-
-  // int dim = 1, idim = 0, jdim = 2;
-  // int dim_p1 = dim+1;   // To match definition in calcdiss
-
-  // /* Find fields: density, total energy, velocity1-3. */
-  
-  // int DensNum, GENum, Vel1Num, Vel2Num, Vel3Num, TENum;
-
-  // this->IdentifyPhysicalQuantities(DensNum, GENum, Vel1Num, Vel2Num, 
-  // 				   Vel3Num, TENum);
-
-  // int nxz, nyz, nzz, ixyz;
-
-  // nxz = GridEndIndex[0] - GridStartIndex[0] + 1;
-  // nyz = GridEndIndex[1] - GridStartIndex[1] + 1;
-  // nzz = GridEndIndex[2] - GridStartIndex[2] + 1;
-
-  // float MinimumPressure = tiny_number;
-  
-  // // Copy from field to slice
-
-  // float *dslice, *eslice, *uslice, *vslice, *wslice, *grslice, *geslice, 
-  //   *colslice, *pslice;
-
-  // int size = my * mz;
-  // dslice = new float[size];
-  // eslice = new float[size];
-  // uslice = new float[size];
-  // vslice = new float[size];
-  // wslice = new float[size];
-  // pslice = new float[size];
-  // if (gravity_) {
-  //   grslice = new float[size];  
-  // }
-  // if (dual_energy_) {
-  //   geslice = new float[size];  
-  // }
-  // if (nc > 0) {
-  //   colslice = new float[nc * size];  
-  // }
-
-  // int j, k, n, ncolor, index2, index3;
-  // for (k = 0; k < mz; k++) {
-
-  //   index2 = k * my;
-
-  //   for (j = 0; j < my; j++) {
-  //     index3 = (k*my + j) * mx + i;
-  //     dslice[index2+j] = de[index3];
-  //     eslice[index2+j] = et[index3];
-  //     pslice[index2+j] = pressure[index3];
-  //     wslice[index2+j] = vx[index3];
-  //   } // ENDFOR i
-
-  //   // Set velocities to zero if rank < 3 since hydro routines are
-  //   // hard-coded for 3-d
-
-  //   if (GridRank > 1) 
-  //     for (j = 0; j < my; j++) {
-  // 	index3 = (k*my + j) * mx + i;
-  // 	uslice[index2+j] = vy[index3];
-  //     }
-  //   else
-  //     for (j = 0; j < my; j++)
-  // 	uslice[index2+j] = 0;
-  
-  //   if (GridRank > 2)
-  //     for (j = 0; j < my; j++) {
-  // 	index3 = (k*my + j) * mx + i;
-  // 	vslice[index2+j] = vz[index3];
-  //     }
-  //   else
-  //     for (j = 0; j < my; j++)
-  // 	vslice[index2+j] = 0;
-    
-  //   if (gravity_)
-  //     for (j = 0; j < my; j++) {
-  // 	index3 = (k*my + j) * mx + i;
-  // 	grslice[index2+j] = AccelerationField[dim][index3];
-  //     }
-
-  //   if (dual_energy_)
-  //     for (j = 0; j < my; j++) {
-  // 	index3 = (k*my + j) * mx + i;
-  // 	geslice[index2+j] = ei[index3];
-  //     }
-
-  //   for (n = 0; n < nc; n++) {
-  //     index2 = (n*mz + k) * my;
-  //     for (j = 0; j < my; j++) {
-  // 	index3 = (k*my + j) * mx + i;
-  // 	colslice[index2+j] = BaryonField[colnum[n]][index3];
-  //     }
-  //   } // ENDFOR colors
-
-  // } // ENDFOR j
-
-  // /* Allocate memory for fluxes */
-
-  // float *dls, *drs, *flatten, *pbar, *pls, *prs, *ubar, *uls, *urs, *vls, 
-  //   *vrs, *gels, *gers, *wls, *wrs, *diffcoef, *df, *ef, *uf, *vf, *wf, *gef,
-  //   *ges, *colf, *colls, *colrs;
-
-  // dls = new float[size];	
-  // drs = new float[size];	
-  // flatten = new float[size];	
-  // pbar = new float[size];	
-  // pls = new float[size];	
-  // prs = new float[size];	
-  // ubar = new float[size];	
-  // uls = new float[size];	
-  // urs = new float[size];	
-  // vls = new float[size];	
-  // vrs = new float[size];	
-  // gels = new float[size];	
-  // gers = new float[size];	
-  // wls = new float[size];	
-  // wrs = new float[size];	
-  // diffcoef = new float[size];	
-  // df = new float[size];		
-  // ef = new float[size];		
-  // uf = new float[size];		
-  // vf = new float[size];		
-  // wf = new float[size];		
-  // gef = new float[size];	
-  // ges = new float[size];
-  // colf = new float[nc*size];  
-  // colls = new float[nc*size];  
-  // colrs = new float[nc*size];  
-
-  // /* Convert start and end indexes into 1-based for FORTRAN */
-
-  // int is, ie, js, je, is_m3, ie_p3, ie_p1, k_p1;
-
-  // is = GridStartIndex[1] + 1;
-  // ie = GridEndIndex[1] + 1;
-  // js = 1;
-  // je = mz;
-  // is_m3 = is - 3;
-  // ie_p1 = ie + 1;
-  // ie_p3 = ie + 3;
-  // k_p1 = i + 1;
-
-  // /* Compute the pressure on a slice */
-
-  // /*
-  // if (dual_energy_)
-  //   FORTRAN_NAME(woc_pgas2d_dual)(dslice, eslice, geslice, pslice, uslice, vslice, 
-  // 			      wslice, &dual_energy_eta1_, 
-  // 			      &dual_energy_eta2_, &my, 
-  // 			      &mz, &is_m3, &ie_p3, &js, &je, 
-  // 			      &gamma_, &ppm_pressure_floor_);
-  // else
-  //   FORTRAN_NAME(woc_pgas2d)(dslice, eslice, pslice, uslice, vslice,
-  // 			 wslice, &my, &mz, 
-  // 			 &is_m3, &ie_p3, &js, &je, &gamma_, &ppm_pressure_floor_);
-  // */
-  // /* If requested, compute diffusion and slope flattening coefficients */
-
-  // if (ppm_diffusion_ != 0 || PPMFlatteningParameter != 0)
-  //   FORTRAN_NAME(woc_calcdiss)(dslice, eslice, uslice, vz,
-  // 			   vx, pslice, CellWidthTemp[1],
-  // 			   CellWidthTemp[2], hxa, 
-  // 			   &my, &mz,
-  // 			   &mx, &is, &ie, &js, &je, &k_p1,
-  // 			   &nxz, &dim_p1, &mx,
-  // 			   &my, &mz,
-  // 			   &dt, &gamma_, &ppm_diffusion_,
-  // 			   &PPMFlatteningParameter, diffcoef, flatten);
-
-  // /* Compute Eulerian left and right states at zone edges via interpolation */
-
-  // if (ReconstructionMethod == PPM)
-  //   FORTRAN_NAME(woc_inteuler)(dslice, pslice, &gravity_, grslice, geslice, uslice,
-  // 			   vslice, wslice, CellWidthTemp[1], flatten,
-  // 			   &my, &mz,
-  // 			   &is, &ie, &js, &je, &dual_energy_, 
-  // 			   &dual_energy_eta1_, &dual_energy_eta2_,
-  // 			   &PPMSteepeningParameter, &PPMFlatteningParameter,
-  // 			   &ConservativeReconstruction, &PositiveReconstruction,
-  // 			   &dt, &gamma_, &ppm_pressure_free_, 
-  // 			   dls, drs, pls, prs, gels, gers, uls, urs, vls, vrs,
-  // 			   wls, wrs, &nc, colslice, colls, colrs);
-
-  // /* Compute (Lagrangian part of the) Riemann problem at each zone boundary */
-
-  // switch (RiemannSolver) {
-  // case TwoShock:
-  //   FORTRAN_NAME(woc_twoshock)(dls, drs, pls, prs, uls, urs,
-  // 			   &my, &mz,
-  // 			   &is, &ie_p1, &js, &je,
-  // 			   &dt, &gamma_, &ppm_pressure_floor_, &ppm_pressure_free_,
-  // 			   pbar, ubar, &gravity_, grslice,
-  // 			   &dual_energy_, &dual_energy_eta1_);
-    
-  //   FORTRAN_NAME(woc_flux_twoshock)(dslice, eslice, geslice, uslice, vslice, wslice,
-  // 				CellWidthTemp[1], diffcoef, 
-  // 				&my, &mz,
-  // 				&is, &ie, &js, &je, &dt, &gamma_,
-  // 				&ppm_diffusion_, &dual_energy_,
-  // 				&dual_energy_eta1_,
-  // 				&riemann_solver_fallback,
-  // 				dls, drs, pls, prs, gels, gers, uls, urs,
-  // 				vls, vrs, wls, wrs, pbar, ubar,
-  // 				df, ef, uf, vf, wf, gef, ges,
-  // 				&nc, colslice, colls, colrs, colf);
-  //   break;
-
-  // case HLL:
-  //   FORTRAN_NAME(woc_flux_hll)(dslice, eslice, geslice, uslice, vslice, wslice,
-  // 			   CellWidthTemp[1], diffcoef, 
-  // 			   &my, &mz,
-  // 			   &is, &ie, &js, &je, &dt, &gamma_,
-  // 			   &ppm_diffusion_, &dual_energy_,
-  // 			   &dual_energy_eta1_,
-  // 			   &riemann_solver_fallback,
-  // 			   dls, drs, pls, prs, uls, urs,
-  // 			   vls, vrs, wls, wrs, gels, gers,
-  // 			   df, uf, vf, wf, ef, gef, ges,
-  // 			   &nc, colslice, colls, colrs, colf);
-  //   break;
-
-  // case HLLC:
-  //   FORTRAN_NAME(woc_flux_hllc)(dslice, eslice, geslice, uslice, vslice, wslice,
-  // 			    CellWidthTemp[1], diffcoef, 
-  // 			    &my, &mz,
-  // 			    &is, &ie, &js, &je, &dt, &gamma_,
-  // 			    &ppm_diffusion_, &dual_energy_,
-  // 			    &dual_energy_eta1_,
-  // 			    &riemann_solver_fallback,
-  // 			    dls, drs, pls, prs, uls, urs,
-  // 			    vls, vrs, wls, wrs, gels, gers,
-  // 			    df, uf, vf, wf, ef, gef, ges,
-  // 			    &nc, colslice, colls, colrs, colf);
-  //   break;
-
-  // default:
-  //   for (int index = 0; index < size; index++) {
-  //     df[index] = 0;
-  //     ef[index] = 0;
-  //     uf[index] = 0;
-  //     vf[index] = 0;
-  //     wf[index] = 0;
-  //     gef[index] = 0;
-  //     ges[index] = 0;
-  //   }
-  //   break;
-
-  // } // ENDCASE
-
-
-  // /* Compute Eulerian fluxes and update zone-centered quantities */
-
-  // FORTRAN_NAME(woc_euler)(dslice, eslice, grslice, geslice, uslice, vslice, wslice,
-  // 		      CellWidthTemp[1], diffcoef, 
-  // 		      &my, &mz, 
-  // 		      &is, &ie, &js, &je, &dt, &gamma_, 
-  // 		      &ppm_diffusion_, &gravity_, &dual_energy_, 
-  // 		      &dual_energy_eta1_, &dual_energy_eta2_,
-  // 		      df, ef, uf, vf, wf, gef, ges,
-  // 		      &nc, colslice, colf, &density_floor_);
-
-  // /* If necessary, recompute the pressure to correctly set ge and e */
-
-  // if (dual_energy_)
-  //   FORTRAN_NAME(woc_pgas2d_dual)(dslice, eslice, geslice, pslice, uslice, vslice, 
-  // 			      wslice, &dual_energy_eta1_, 
-  // 			      &dual_energy_eta2_, &my, 
-  // 			      &mz, &is_m3, &ie_p3, &js, &je, 
-  // 			      &gamma_, &ppm_pressure_floor_);
-
-  // /* Check this slice against the list of subgrids (all subgrid
-  //    quantities are zero-based) */
-
-  // int jstart, jend, offset, nfi, lface, rface, lindex, rindex, 
-  //   fistart, fiend, fjstart, fjend, clindex, crindex;
-  
-  // for (n = 0; n < NumberOfSubgrids; n++) {
-
-  //   fistart = SubgridFluxes[n]->RightFluxStartGlobalIndex[dim][idim] - 
-  //     GridGlobalStart[idim];
-  //   fiend = SubgridFluxes[n]->RightFluxEndGlobalIndex[dim][idim] -
-  //     GridGlobalStart[idim];
-  //   fjstart = SubgridFluxes[n]->RightFluxStartGlobalIndex[dim][jdim] - 
-  //     GridGlobalStart[jdim];
-  //   fjend = SubgridFluxes[n]->RightFluxEndGlobalIndex[dim][jdim] -
-  //     GridGlobalStart[jdim];
-
-  //   if (i >= fistart && i <= fiend) {
-
-  //     nfi = fiend - fistart + 1;
-  //     for (k = fjstart; k <= fjend; k++) {
-
-  // 	offset = (i-fistart) + (k-fjstart)*nfi;
-
-  // 	lface = SubgridFluxes[n]->LeftFluxStartGlobalIndex[dim][dim] -
-  // 	  GridGlobalStart[dim];
-  // 	lindex = k * GridDimension[dim] + lface;
-
-  // 	rface = SubgridFluxes[n]->RightFluxStartGlobalIndex[dim][dim] -
-  // 	  GridGlobalStart[dim] + 1;
-  // 	rindex = k * GridDimension[dim] + rface;	
-
-  // 	SubgridFluxes[n]->LeftFluxes [DensNum][dim][offset] = df[lindex];
-  // 	SubgridFluxes[n]->RightFluxes[DensNum][dim][offset] = df[rindex];
-  // 	SubgridFluxes[n]->LeftFluxes [TENum][dim][offset]   = ef[lindex];
-  // 	SubgridFluxes[n]->RightFluxes[TENum][dim][offset]   = ef[rindex];
-
-  // 	if (nxz > 1) {
-  // 	  SubgridFluxes[n]->LeftFluxes [Vel1Num][dim][offset] = wf[lindex];
-  // 	  SubgridFluxes[n]->RightFluxes[Vel1Num][dim][offset] = wf[rindex];
-  // 	} // ENDIF x-data
-
-  // 	SubgridFluxes[n]->LeftFluxes [Vel2Num][dim][offset] = uf[lindex];
-  // 	SubgridFluxes[n]->RightFluxes[Vel2Num][dim][offset] = uf[rindex];
-
-  // 	if (nzz > 1) {
-  // 	  SubgridFluxes[n]->LeftFluxes [Vel3Num][dim][offset] = vf[lindex];
-  // 	  SubgridFluxes[n]->RightFluxes[Vel3Num][dim][offset] = vf[rindex];
-  // 	} // ENDIF z-data
-
-  // 	if (dual_energy_) {
-  // 	  SubgridFluxes[n]->LeftFluxes [GENum][dim][offset] = gef[lindex];
-  // 	  SubgridFluxes[n]->RightFluxes[GENum][dim][offset] = gef[rindex];
-  // 	} // ENDIF dual_energy_
-
-  // 	for (ncolor = 0; ncolor < nc; ncolor++) {
-  // 	  clindex = (k + ncolor * mz) * GridDimension[dim] +
-  // 	    lface;
-  // 	  crindex = (k + ncolor * mz) * GridDimension[dim] +
-  // 	    rface;
-
-  // 	  SubgridFluxes[n]->LeftFluxes [colnum[ncolor]][dim][offset] = 
-  // 	    colf[clindex];
-  // 	  SubgridFluxes[n]->RightFluxes[colnum[ncolor]][dim][offset] = 
-  // 	    colf[crindex];
-  // 	} // ENDFOR ncolor
-
-  //     } // ENDFOR J
-
-  //   } // ENDIF k inside
-
-  // } // ENDFOR n
-
-  // /* Copy from slice to field */
-
-  // for (k = 0; k < mz; k++) {
-  //   index2 = k * my;
-  //   for (j = 0; j < my; j++) {
-  //     index3 = (k*my + j)*mx + i;
-  //     de[index3] = dslice[index2+j];
-  //     et[index3] = eslice[index2+j];
-  //     vx[index3] = wslice[index2+j];
-  //   } // ENDFOR i
-
-  //   if (GridRank > 1)
-  //     for (j = 0; j < my; j++) {
-  // 	index3 = (k*my + j)*mx + i;
-  // 	vy[index3] = uslice[index2+j];
-  //     }
-
-  //   if (GridRank > 2)
-  //     for (j = 0; j < my; j++) {
-  // 	index3 = (k*my + j)*mx + i;
-  // 	vz[index3] = vslice[index2+j];
-  //     }
-
-  //   if (dual_energy_)
-  //     for (j = 0; j < my; j++) {
-  // 	index3 = (k*my + j)*mx + i;
-  // 	ei[index3] = geslice[index2+j];
-  //     }
+  const int cycle = block->cycle();
 
-  //   for (n = 0; n < nc; n++) {
-  //     index2 = (n*mz + k) * my;
-  //     for (j = 0; j < my; j++) {
-  // 	index3 = (k*my + j) * mx + i;
-  // 	BaryonField[colnum[n]][index3] = colslice[index2+j];
-  //     }
-  //   } // ENDFOR colors    
-
-  // } // ENDFOR j
-
-  // /* Delete all temporary slices */
-
-  // delete [] dslice;
-  // delete [] eslice;
-  // delete [] uslice;
-  // delete [] vslice;
-  // delete [] wslice;
-  // delete [] pslice;
-  // if (gravity_)
-  //   delete [] grslice;
-  // if (dual_energy_)
-  //   delete [] geslice;
-  // if (nc > 0)
-  //   delete [] colslice;
-
-  // delete [] dls;
-  // delete [] drs;
-  // delete [] flatten;
-  // delete [] pbar;
-  // delete [] pls;
-  // delete [] prs;
-  // delete [] ubar;
-  // delete [] uls;
-  // delete [] urs;
-  // delete [] vls;
-  // delete [] vrs;
-  // delete [] gels;
-  // delete [] gers;
-  // delete [] wls;
-  // delete [] wrs;
-  // delete [] diffcoef;
-  // delete [] df;
-  // delete [] ef;
-  // delete [] uf;
-  // delete [] vf;
-  // delete [] wf;
-  // delete [] gef;
-  // delete [] ges;
-  // delete [] colf;
-  // delete [] colls;
-  // delete [] colrs;
-
-  // return SUCCESS;
+  for (int n = cycle % rank; n < cycle % rank + rank; n++) {
+    const int axis = n % rank;
+    if (n3[axis] > 1) {
+      hydro_sweep.sweep
+	(axis, dt, h3, m3, g3, n3, d, e, ge, v3, a3[axis], nc, c);
+    }
+  }
 
+  scratch->release(scratch_mark);
 }
 
 //----------------------------------------------------------------------
 
-void EnzoMethodHydro::ppm_euler_z_ (Block * block, int iy)
+double EnzoMethodHydro::timestep ( Block * block ) const throw()
 {
+  EnzoBlock * enzo_block = enzo::block(block);
 
-  // int dim = 2, idim = 0, jdim = 1;
-  // int dim_p1 = dim+1;   // To match definition in calcdiss
-
-  // /* Find fields: density, total energy, velocity1-3. */
-  
-  // int DensNum, GENum, Vel1Num, Vel2Num, Vel3Num, TENum;
-
-  // this->IdentifyPhysicalQuantities(DensNum, GENum, Vel1Num, Vel2Num, 
-  // 				   Vel3Num, TENum);
-
-  // int nxz, nyz, nzz, ixyz;
-
-  // nxz = GridEndIndex[0] - GridStartIndex[0] + 1;
-  // nyz = GridEndIndex[1] - GridStartIndex[1] + 1;
-  // nzz = GridEndIndex[2] - GridStartIndex[2] + 1;
-
-  // float MinimumPressure = tiny_number;
-  
-  // // Copy from field to slice
-
-  // float *dslice, *eslice, *uslice, *vslice, *wslice, *grslice, *geslice, 
-  //   *colslice, *pslice;
-
-  // int size = mz * mx;
-  // dslice = new float[size];  
-  // eslice = new float[size];  
-  // uslice = new float[size];  
-  // vslice = new float[size];  
-  // wslice = new float[size];  
-  // pslice = new float[size];  
-  // if (gravity_) {
-  //   grslice = new float[size];  
-  // }
-  // if (dual_energy_) {
-  //   geslice = new float[size];  
-  // }
-  // if (NumberOfcolors > 0) {
-  //   colslice = new float[NumberOfcolors * size];  
-  // }
-
-  // int i, k, n, ncolor, index2, index3;
-
-  // for (i = 0; i < mx; i++) {
-  //   index2 = i * mz;
-  //   for (k = 0; k < mz; k++) {
-  //     index3 = (k*my + j) * mx + i;
-  //     dslice[index2+k] = de[index3];
-  //     eslice[index2+k] = et[index3];
-  //     pslice[index2+k] = pressure[index3];
-  //     vslice[index2+k] = vx[index3];
-  //   } // ENDFOR i
-
-  //   // Set velocities to zero if rank < 3 since hydro routines are
-  //   // hard-coded for 3-d
-
-  //   if (GridRank > 1)
-  //     for (k = 0; k < mz; k++) {
-  // 	index3 = (k*my + j) * mx + i;
-  // 	wslice[index2+k] = vy[index3];
-  //     }
-  //   else
-  //     for (k = 0; k < mz; k++)
-  // 	wslice[index2+k] = 0;
-  
-  //   if (GridRank > 2)
-  //     for (k = 0; k < mz; k++) {
-  // 	index3 = (k*my + j) * mx + i;
-  // 	uslice[index2+k] = vz[index3];
-  //     }
-  //   else
-  //     for (k = 0; k < mz; k++)
-  // 	uslice[index2+k] = 0;
-
-  //   if (gravity_)
-  //     for (k = 0; k < mz; k++) {
-  // 	index3 = (k*my + j) * mx + i;
-  // 	grslice[index2+k] = AccelerationField[dim][index3];
-  //     }
-
-  //   if (dual_energy_)
-  //     for (k = 0; k < mz; k++) {
-  // 	index3 = (k*my + j) * mx + i;
-  // 	geslice[index2+k] = ei[index3];
-  //     }
-
-  //   for (n = 0; n < NumberOfcolors; n++) {
-  //     index2 = (n*mx + i) * mz;
-  //     for (k = 0; k < mz; k++) {
-  // 	index3 = (k*my + j) * mx + i;
-  // 	colslice[index2+k] = BaryonField[colnum[n]][index3];
-  //     }
-  //   } // ENDFOR colors
-  // } // ENDFOR j
-
-  // /* Allocate memory for temporaries used in solver */
-
-  // float *dls, *drs, *flatten, *pbar, *pls, *prs, *ubar, *uls, *urs, *vls, 
-  //   *vrs, *gels, *gers, *wls, *wrs, *diffcoef, *df, *ef, *uf, *vf, *wf, *gef,
-  //   *ges, *colf, *colls, *colrs;
-
-  // dls = new float[size];	
-  // drs = new float[size];	
-  // flatten = new float[size];	
-  // pbar = new float[size];	
-  // pls = new float[size];	
-  // prs = new float[size];	
-  // ubar = new float[size];	
-  // uls = new float[size];	
-  // urs = new float[size];	
-  // vls = new float[size];	
-  // vrs = new float[size];	
-  // gels = new float[size];	
-  // gers = new float[size];	
-  // wls = new float[size];	
-  // wrs = new float[size];	
-  // diffcoef = new float[size];	
-  // df = new float[size];		
-  // ef = new float[size];		
-  // uf = new float[size];		
-  // vf = new float[size];		
-  // wf = new float[size];		
-  // gef = new float[size];	
-  // ges = new float[size];
-  // colf = new float[NumberOfcolors*size];  
-  // colls = new float[NumberOfcolors*size];  
-  // colrs = new float[NumberOfcolors*size];  
-
-  // /* Convert start and end indexes into 1-based for FORTRAN */
-
-  // int is, ie, js, je, is_m3, ie_p3, ie_p1, k_p1;
-
-  // is = GridStartIndex[2] + 1;
-  // ie = GridEndIndex[2] + 1;
-  // js = 1;
-  // je = mx;
-  // is_m3 = is - 3;
-  // ie_p1 = ie + 1;
-  // ie_p3 = ie + 3;
-  // k_p1 = j + 1;
-
-  // /* Compute the pressure on a slice */
-  // /*
-  // if (dual_energy_)
-  //   FORTRAN_NAME(woc_pgas2d_dual)(dslice, eslice, geslice, pslice, uslice, vslice, 
-  // 			      wslice, &dual_energy_eta1_, 
-  // 			      &dual_energy_eta2_, &mz, 
-  // 			      &mx, &is_m3, &ie_p3, &js, &je, 
-  // 			      &gamma_, &ppm_pressure_floor_);
-  // else
-  //   FORTRAN_NAME(woc_pgas2d)(dslice, eslice, pslice, uslice, vslice, 
-  // 			 wslice, &mz, &mx, 
-  // 			 &is_m3, &ie_p3, &js, &je, &gamma_, &ppm_pressure_floor_);
-  // */
-  // /* If requested, compute diffusion and slope flattening coefficients */
-
-  // if (ppm_diffusion_ != 0 || PPMFlatteningParameter != 0)
-  //   FORTRAN_NAME(woc_calcdiss)(dslice, eslice, uslice, vx,
-  // 			   vy, pslice, CellWidthTemp[2],
-  // 			   hxa, CellWidthTemp[1], 
-  // 			   &mz, &mx, 
-  // 			   &my, &is, &ie, &js, &je, &k_p1,
-  // 			   &nyz, &dim_p1, &mx,
-  // 			   &my, &mz,
-  // 			   &dt, &gamma_, &ppm_diffusion_,
-  // 			   &PPMFlatteningParameter, diffcoef, flatten);
-
-  // /* Compute Eulerian left and right states at zone edges via interpolation */
-
-  // if (ReconstructionMethod == PPM)
-  //   FORTRAN_NAME(woc_inteuler)(dslice, pslice, &gravity_, grslice, geslice, uslice,
-  // 			   vslice, wslice, CellWidthTemp[2], flatten,
-  // 			   &mz, &mx,
-  // 			   &is, &ie, &js, &je, &dual_energy_, 
-  // 			   &dual_energy_eta1_, &dual_energy_eta2_,
-  // 			   &PPMSteepeningParameter, &PPMFlatteningParameter,
-  // 			   &ConservativeReconstruction, &PositiveReconstruction,
-  // 			   &dt, &gamma_, &ppm_pressure_free_, 
-  // 			   dls, drs, pls, prs, gels, gers, uls, urs, vls, vrs,
-  // 			   wls, wrs, &NumberOfcolors, colslice, colls, colrs);
-
-  // /* Compute (Lagrangian part of the) Riemann problem at each zone boundary */
-
-  // switch (RiemannSolver) {
-  // case TwoShock:
-  //   FORTRAN_NAME(woc_twoshock)(dls, drs, pls, prs, uls, urs,
-  // 			   &mz, &mx,
-  // 			   &is, &ie_p1, &js, &je,
-  // 			   &dt, &gamma_, &ppm_pressure_floor_, &ppm_pressure_free_,
-  // 			   pbar, ubar, &gravity_, grslice,
-  // 			   &dual_energy_, &dual_energy_eta1_);
-    
-  //   FORTRAN_NAME(woc_flux_twoshock)(dslice, eslice, geslice, uslice, vslice, wslice,
-  // 				CellWidthTemp[2], diffcoef, 
-  // 				&mz, &mx,
-  // 				&is, &ie, &js, &je, &dt, &gamma_,
-  // 				&ppm_diffusion_, &dual_energy_,
-  // 				&dual_energy_eta1_,
-  // 				&riemann_solver_fallback,
-  // 				dls, drs, pls, prs, gels, gers, uls, urs,
-  // 				vls, vrs, wls, wrs, pbar, ubar,
-  // 				df, ef, uf, vf, wf, gef, ges,
-  // 				&NumberOfcolors, colslice, colls, colrs, colf);
-  //   break;
-
-  // case HLL:
-  //   FORTRAN_NAME(woc_flux_hll)(dslice, eslice, geslice, uslice, vslice, wslice,
-  // 			   CellWidthTemp[2], diffcoef, 
-  // 			   &mz, &mx,
-  // 			   &is, &ie, &js, &je, &dt, &gamma_,
-  // 			   &ppm_diffusion_, &dual_energy_,
-  // 			   &dual_energy_eta1_,
-  // 			   &riemann_solver_fallback,
-  // 			   dls, drs, pls, prs, uls, urs,
-  // 			   vls, vrs, wls, wrs, gels, gers,
-  // 			   df, uf, vf, wf, ef, gef, ges,
-  // 			   &NumberOfcolors, colslice, colls, colrs, colf);
-  //   break;
-
-  // case HLLC:
-  //   FORTRAN_NAME(woc_flux_hllc)(dslice, eslice, geslice, uslice, vslice, wslice,
-  // 			    CellWidthTemp[2], diffcoef, 
-  // 			    &mz, &mx,
-  // 			    &is, &ie, &js, &je, &dt, &gamma_,
-  // 			    &ppm_diffusion_, &dual_energy_,
-  // 			    &dual_energy_eta1_,
-  // 			    &riemann_solver_fallback,
-  // 			    dls, drs, pls, prs, uls, urs,
-  // 			    vls, vrs, wls, wrs, gels, gers,
-  // 			    df, uf, vf, wf, ef, gef, ges,
-  // 			    &NumberOfcolors, colslice, colls, colrs, colf);
-  //   break;
-
-  // default:
-  //   for (int index = 0; index < size; index++) {
-  //     df[index] = 0;
-  //     ef[index] = 0;
-  //     uf[index] = 0;
-  //     vf[index] = 0;
-  //     wf[index] = 0;
-  //     gef[index] = 0;
-  //     ges[index] = 0;
-  //   }
-  //   break;
-
-  // } // ENDCASE
-
-  // /* Compute Eulerian fluxes and update zone-centered quantities */
-
-  // FORTRAN_NAME(woc_euler)(dslice, eslice, grslice, geslice, uslice, vslice, wslice,
-  // 		      CellWidthTemp[2], diffcoef, 
-  // 		      &mz, &mx, 
-  // 		      &is, &ie, &js, &je, &dt, &gamma_, 
-  // 		      &ppm_diffusion_, &gravity_, &dual_energy_, 
-  // 		      &dual_energy_eta1_, &dual_energy_eta2_,
-  // 		      df, ef, uf, vf, wf, gef, ges,
-  // 		      &NumberOfcolors, colslice, colf, &density_floor_);
-
-  // /* If necessary, recompute the pressure to correctly set ge and e */
-
-  // if (dual_energy_)
-  //   FORTRAN_NAME(woc_pgas2d_dual)(dslice, eslice, geslice, pslice, uslice, vslice, 
-  // 			      wslice, &dual_energy_eta1_, 
-  // 			      &dual_energy_eta2_, &mz, 
-  // 			      &mx, &is_m3, &ie_p3, &js, &je, 
-  // 			      &gamma_, &ppm_pressure_floor_);
-
-  // /* Check this slice against the list of subgrids (all subgrid
-  //    quantities are zero-based) */
-
-  // int jstart, jend, offset, nfi, lface, rface, lindex, rindex, 
-  //   fistart, fiend, fjstart, fjend, clindex, crindex;
-  
-  // for (n = 0; n < NumberOfSubgrids; n++) {
-
-  //   fistart = SubgridFluxes[n]->RightFluxStartGlobalIndex[dim][idim] - 
-  //     GridGlobalStart[idim];
-  //   fiend = SubgridFluxes[n]->RightFluxEndGlobalIndex[dim][idim] -
-  //     GridGlobalStart[idim];
-  //   fjstart = SubgridFluxes[n]->RightFluxStartGlobalIndex[dim][jdim] - 
-  //     GridGlobalStart[jdim];
-  //   fjend = SubgridFluxes[n]->RightFluxEndGlobalIndex[dim][jdim] -
-  //     GridGlobalStart[jdim];
-
-  //   if (j >= fjstart && j <= fjend) {
-
-  //     nfi = fiend - fistart + 1;
-  //     for (i = fistart; i <= fiend; i++) {
-
-  // 	offset = (i-fistart) + (j-fjstart)*nfi;
-
-  // 	lface = SubgridFluxes[n]->LeftFluxStartGlobalIndex[dim][dim] -
-  // 	  GridGlobalStart[dim];
-  // 	lindex = i * GridDimension[dim] + lface;
-
-  // 	rface = SubgridFluxes[n]->RightFluxStartGlobalIndex[dim][dim] -
-  // 	  GridGlobalStart[dim] + 1;
-  // 	rindex = i * GridDimension[dim] + rface;	
-
-  // 	SubgridFluxes[n]->LeftFluxes [DensNum][dim][offset] = df[lindex];
-  // 	SubgridFluxes[n]->RightFluxes[DensNum][dim][offset] = df[rindex];
-  // 	SubgridFluxes[n]->LeftFluxes [TENum][dim][offset]   = ef[lindex];
-  // 	SubgridFluxes[n]->RightFluxes[TENum][dim][offset]   = ef[rindex];
-
-  // 	if (nxz > 1) {
-  // 	  SubgridFluxes[n]->LeftFluxes [Vel1Num][dim][offset] = vf[lindex];
-  // 	  SubgridFluxes[n]->RightFluxes[Vel1Num][dim][offset] = vf[rindex];
-  // 	} // ENDIF x-data
-
-  // 	if (nyz > 1) {
-  // 	  SubgridFluxes[n]->LeftFluxes [Vel2Num][dim][offset] = wf[lindex];
-  // 	  SubgridFluxes[n]->RightFluxes[Vel2Num][dim][offset] = wf[rindex];
-  // 	} // ENDIF y-data
-
-  // 	SubgridFluxes[n]->LeftFluxes [Vel3Num][dim][offset] = uf[lindex];
-  // 	SubgridFluxes[n]->RightFluxes[Vel3Num][dim][offset] = uf[rindex];
-
-  // 	if (dual_energy_) {
-  // 	  SubgridFluxes[n]->LeftFluxes [GENum][dim][offset] = gef[lindex];
-  // 	  SubgridFluxes[n]->RightFluxes[GENum][dim][offset] = gef[rindex];
-  // 	} // ENDIF dual_energy_
-
-  // 	for (ncolor = 0; ncolor < NumberOfcolors; ncolor++) {
-  // 	  clindex = (i + ncolor * mx) * GridDimension[dim] +
-  // 	    lface;
-  // 	  crindex = (i + ncolor * mx) * GridDimension[dim] +
-  // 	    rface;
-
-  // 	  SubgridFluxes[n]->LeftFluxes [colnum[ncolor]][dim][offset] = 
-  // 	    colf[clindex];
-  // 	  SubgridFluxes[n]->RightFluxes[colnum[ncolor]][dim][offset] = 
-  // 	    colf[crindex];
-  // 	} // ENDFOR ncolor
-
-  //     } // ENDFOR J
-
-  //   } // ENDIF k inside
-
-  // } // ENDFOR n
-
-  // /* Copy from slice to field */
-
-  // for (i = 0; i < mx; i++) {
-  //   index2 = i * mz;
-  //   for (k = 0; k < mz; k++) {
-  //     index3 = (k*my + j)*mx + i;
-  //     de[index3] = dslice[index2+k];
-  //     et[index3] = eslice[index2+k];
-  //     vx[index3] = vslice[index2+k];
-  //   } // ENDFOR i
-
-  //   if (GridRank > 1)
-  //     for (k = 0; k < mz; k++) {
-  // 	index3 = (k*my + j)*mx + i;
-  // 	vy[index3] = wslice[index2+k];
-  //     }
-
-  //   if (GridRank > 2)
-  //     for (k = 0; k < mz; k++) {
-  // 	index3 = (k*my + j)*mx + i;
-  // 	vz[index3] = uslice[index2+k];
-  //     }
-
-  //   if (dual_energy_)
-  //     for (k = 0; k < mz; k++) {
-  // 	index3 = (k*my + j)*mx + i;
-  // 	ei[index3] = geslice[index2+k];
-  //     }
+  enzo_float cosmo_a = 1.0, cosmo_dadt = 0.0;
 
-  //   for (n = 0; n < NumberOfcolors; n++) {
-  //     index2 = (n*mx + i) * mz;
-  //     for (k = 0; k < mz; k++) {
-  // 	index3 = (k*my + j) * mx + i;
-  // 	BaryonField[colnum[n]][index3] = colslice[index2+k];
-  //     }
-  //   } // ENDFOR colors
-
-  // } // ENDFOR j
-
-  // /* Delete all temporary slices */
-
-  // delete [] dslice;
-  // delete [] eslice;
-  // delete [] uslice;
-  // delete [] vslice;
-  // delete [] wslice;
-  // delete [] pslice;
-  // if (gravity_)
-  //   delete [] grslice;
-  // if (dual_energy_)
-  //   delete [] geslice;
-  // if (NumberOfcolors > 0)
-  //   delete [] colslice;
-
-  // delete [] dls;
-  // delete [] drs;
-  // delete [] flatten;
-  // delete [] pbar;
-  // delete [] pls;
-  // delete [] prs;
-  // delete [] ubar;
-  // delete [] uls;
-  // delete [] urs;
-  // delete [] vls;
-  // delete [] vrs;
-  // delete [] gels;
-  // delete [] gers;
-  // delete [] wls;
-  // delete [] wrs;
-  // delete [] diffcoef;
-  // delete [] df;
-  // delete [] ef;
-  // delete [] uf;
-  // delete [] vf;
-  // delete [] wf;
-  // delete [] gef;
-  // delete [] ges;
-  // delete [] colf;
-  // delete [] colls;
-  // delete [] colrs;
-
-  // return SUCCESS;
-
-  
-}
+  EnzoPhysicsCosmology * cosmology = enzo::cosmology();
 
-//----------------------------------------------------------------------
+  ASSERT ("EnzoMethodHydro::timestep()",
+	  "comoving_coordinates enabled but missing EnzoPhysicsCosmology",
+	  ! (comoving_coordinates_ && (cosmology == NULL)) );
 
-double EnzoMethodHydro::timestep ( Block * block ) const throw()
-{
+  if (comoving_coordinates_) {
+    cosmology->compute_expansion_factor
+      (&cosmo_a, &cosmo_dadt,(enzo_float)enzo_block->time());
+  }
 
-  double dt = std::numeric_limits<double>::max();
-  
-  return dt;
+  enzo_float dt_hydro = ENZO_HUGE_VAL;
+
+  EnzoComputePressure compute_pressure (gamma_, comoving_coordinates_);
+  compute_pressure.compute(enzo_block);
+
+  Field field = enzo_block->data()->field();
+
+  int rank = cello::rank();
+
+  enzo_float * density    = (enzo_float *)field.values("density");
+  enzo_float * velocity_x = (rank >= 1) ?
+    (enzo_float *)field.values("velocity_x") : NULL;
+  enzo_float * velocity_y = (rank >= 2) ?
+    (enzo_float *)field.values("velocity_y") : NULL;
+  enzo_float * velocity_z = (rank >= 3) ?
+    (enzo_float *)field.values("velocity_z") : NULL;
+  enzo_float * pressure = (enzo_float *) field.values("pressure");
+
+  enzo_float gamma = gamma_;
+  int pressure_free = ppm_pressure_free_;
+
+  FORTRAN_NAME(calc_dt)(&rank,
+			enzo_block->GridDimension,
+			enzo_block->GridDimension+1,
+			enzo_block->GridDimension+2,
+			enzo_block->GridStartIndex,
+			enzo_block->GridEndIndex,
+			enzo_block->GridStartIndex+1,
+			enzo_block->GridEndIndex+1,
+			enzo_block->GridStartIndex+2,
+			enzo_block->GridEndIndex+2,
+			&enzo_block->CellWidth[0],
+			&enzo_block->CellWidth[1],
+			&enzo_block->CellWidth[2],
+			&gamma, &pressure_free, &cosmo_a,
+			density, pressure,
+			velocity_x,
+			velocity_y,
+			velocity_z,
+			&dt_hydro);
+
+  return dt_hydro * courant_;
 }
@@ -8,110 +8,6 @@
 #ifndef ENZO_ENZO_METHOD_HYDRO_HPP
 #define ENZO_ENZO_METHOD_HYDRO_HPP
 
-extern "C" void FORTRAN_NAME(woc_pgas2d_dual)
-  (
-   enzo_float *dslice, enzo_float *eslice, enzo_float *geslice,
-   enzo_float *pslice,
-   enzo_float *uslice, enzo_float *vslice, enzo_float *wslice,
-   enzo_float *eta1, enzo_float *eta2,
-   int *idim, int *jdim,
-   int *i1, int *i2, int *j1, int *j2,
-   enzo_float *gamma, enzo_float *pmin);
-
-extern "C" void FORTRAN_NAME(woc_pgas2d)
-  (
-   enzo_float *dslice, enzo_float *eslice, enzo_float *pslice,
-   enzo_float *uslice, enzo_float *vslice, enzo_float *wslice,
-   int *idim, int *jdim,
-   int *i1, int *i2, int *j1, int *j2,
-   enzo_float *gamma, enzo_float *pmin);
-
-extern "C" void FORTRAN_NAME(woc_calcdiss)
-  (
-   enzo_float *dslice, enzo_float *eslice, enzo_float *uslice, enzo_float *v, 
-   enzo_float *w, enzo_float *pslice,
-   enzo_float *dx, enzo_float *dy, enzo_float *dz, 
-   int *idim, int *jdim, int *kdim, int *i1, int *i2, int *j1, 
-   int *j2, int *k, int *nzz, int *idir, int *dimx, int *dimy, 
-   int *dimz, enzo_float *dt, enzo_float *gamma, int *idiff, int *iflatten, 
-   enzo_float *diffcoef, enzo_float *flatten);
-
-extern "C" void FORTRAN_NAME(woc_inteuler)
-  (
-   enzo_float *dslice, enzo_float *pslice, int *gravity, enzo_float *grslice, 
-   enzo_float *geslice, enzo_float *uslice, enzo_float *vslice, enzo_float *wslice, 
-   enzo_float *dxi, enzo_float *flatten, int *idim, int *jdim, int *i1, 
-   int *i2, int *j1, int *j2, int *idual, enzo_float *eta1, 
-   enzo_float *eta2, int *isteep, int *iflatten,
-   int *iconsrec, int *iposrec,
-   enzo_float *dt, enzo_float *gamma, int *ipresfree, enzo_float *dls, enzo_float *drs, 
-   enzo_float *pls, enzo_float *prs, enzo_float *gels, enzo_float *gers, enzo_float *uls, 
-   enzo_float *urs, enzo_float *vls, enzo_float *vrs, enzo_float *wls, enzo_float *wrs, 
-   int *ncolor, enzo_float *colslice, enzo_float *colls, enzo_float *colrs);
-
-extern "C" void FORTRAN_NAME(woc_twoshock)
-  (
-   enzo_float *dls, enzo_float *drs, enzo_float *pls, enzo_float *prs, 
-   enzo_float *uls, enzo_float *urs, int *idim, int *jdim, int *i1,
-   int *i2, int *j1, int *j2, enzo_float *dt, enzo_float *gamma, 
-   enzo_float *pmin, int *ipresfree, enzo_float *pbar, enzo_float *ubar,
-   int *gravity, enzo_float *grslice, int *idual, enzo_float *eta1);
-
-extern "C" void FORTRAN_NAME(woc_flux_twoshock)
-  (
-   enzo_float *dslice, enzo_float *eslice, enzo_float *geslice, enzo_float *uslice, 
-   enzo_float *vslice, enzo_float *wslice, enzo_float *dx,
-   enzo_float *diffcoef, int *idim, int *jdim, int *i1, int *i2, 
-   int *j1, int *j2, enzo_float *dt, enzo_float *gamma, int *idiff,
-   int *idual, enzo_float *eta1, int *ifallback,
-   enzo_float *dls, enzo_float *drs, enzo_float *pls, enzo_float *prs, 
-   enzo_float *gels, enzo_float *gers, 
-   enzo_float *uls, enzo_float *urs, enzo_float *vls, enzo_float *vrs, 
-   enzo_float *wls, enzo_float *wrs, enzo_float *pbar, enzo_float *ubar,
-   enzo_float *df, enzo_float *ef, enzo_float *uf, enzo_float *vf, enzo_float *wf, enzo_float *gef, 
-   enzo_float *ges,
-   int *ncolor, enzo_float *colslice, enzo_float *colls, enzo_float *colrs, enzo_float *colf);
-
-extern "C" void FORTRAN_NAME(woc_flux_hll)
-  (
-   enzo_float *dslice, enzo_float *eslice, enzo_float *geslice, enzo_float *uslice, 
-   enzo_float *vslice, enzo_float *wslice, enzo_float *dx,
-   enzo_float *diffcoef, int *idim, int *jdim, int *i1, int *i2, 
-   int *j1, int *j2, enzo_float *dt, enzo_float *gamma,
-   int *idiff, int *idual, enzo_float *eta1, int *ifallback,
-   enzo_float *dls, enzo_float *drs, enzo_float *pls, enzo_float *prs, 
-   enzo_float *uls, enzo_float *urs, enzo_float *vls, enzo_float *vrs, 
-   enzo_float *wls, enzo_float *wrs, enzo_float *gels, enzo_float *gers, 
-   enzo_float *df, enzo_float *ef, enzo_float *uf, enzo_float *vf, enzo_float *wf, enzo_float *gef, 
-   enzo_float *ges,
-   int *ncolor, enzo_float *colslice, enzo_float *colls, enzo_float *colrs, enzo_float *colf);
-
-extern "C" void FORTRAN_NAME(woc_flux_hllc)
-  (
-   enzo_float *dslice, enzo_float *eslice, enzo_float *geslice, enzo_float *uslice, 
-   enzo_float *vslice, enzo_float *wslice, enzo_float *dx,
-   enzo_float *diffcoef, int *idim, int *jdim, int *i1, int *i2, 
-   int *j1, int *j2, enzo_float *dt, enzo_float *gamma,
-   int *idiff, int *idual, enzo_float *eta1, int *ifallback,
-   enzo_float *dls, enzo_float *drs, enzo_float *pls, enzo_float *prs, 
-   enzo_float *uls, enzo_float *urs, enzo_float *vls, enzo_float *vrs, 
-   enzo_float *wls, enzo_float *wrs, enzo_float *gels, enzo_float *gers, 
-   enzo_float *df, enzo_float *ef, enzo_float *uf, enzo_float *vf, enzo_float *wf, enzo_float *gef, 
-   enzo_float *ges,
-   int *ncolor, enzo_float *colslice, enzo_float *colls, enzo_float *colrs, enzo_float *colf);
-
-extern "C" void FORTRAN_NAME(woc_euler)
-  (
-   enzo_float *dslice, enzo_float *pslice, enzo_float *grslice, 
-   enzo_float *geslice, enzo_float *uslice, enzo_float *vslice, enzo_float *wslice, 
-   enzo_float *dx, enzo_float *diffcoef, int *idim, int *jdim, int *i1, 
-   int *i2, int *j1, int *j2, enzo_float *dt, enzo_float *gamma, int *idiff, 
-   int *gravity, int *idual, enzo_float *eta1, enzo_float *eta2, enzo_float *df, 
-   enzo_float *ef, enzo_float *uf, enzo_float *vf, enzo_float *wf, enzo_float *gef,
-   enzo_float *ges,
-   int *ncolor, enzo_float *colslice, enzo_float *colf, enzo_float *dfloor);
-
-
 class EnzoMethodHydro : public Method {
 
   /// @class    EnzoMethodHydro
@@ -178,12 +74,14 @@ public: // virtual methods
   /// Compute maximum timestep for this method
   virtual double timestep ( Block * block) const throw();
 
+  /// Fluxes update conserved quantities
+  virtual bool is_conservative () const throw()
+  { return true; }
+
 protected: // methods
 
+  /// Update the hydro fields using directional PPM sweeps
   void ppm_method_ (Block * block);
-  void ppm_euler_x_ (Block * block, int iz);
-  void ppm_euler_y_ (Block * block, int ix);
-  void ppm_euler_z_ (Block * block, int iy);
   
 protected: // attributes
 
@@ -42,7 +42,16 @@ EnzoMethodPmDeposit::EnzoMethodPmDeposit ( double alpha)
   refresh(ir)->add_field("velocity_x");
   refresh(ir)->add_field("velocity_y");
   refresh(ir)->add_field("velocity_z");
-			     
+
+  // Declare modified fields so later refreshes can be merged into
+  // this one
+
+  FieldDescr * field_descr = cello::field_descr();
+  std::vector<int> field_list;
+  field_list.push_back(field_descr->field_id("density_total"));
+  field_list.push_back(field_descr->field_id("density_particle"));
+  field_list.push_back(field_descr->field_id("density_particle_accumulate"));
+  set_field_list_written (field_list);
 }
 
 //----------------------------------------------------------------------
@@ -46,6 +46,11 @@ EnzoMethodPmUpdate::EnzoMethodPmUpdate
 
   refresh(ir)->add_particle(particle_descr->type_index("dark"));
 
+  // Only particles are updated, so later refreshes can be merged
+  // into this one
+
+  set_field_list_written (std::vector<int>());
+
   // PM parameters initialized in EnzoBlock::initialize()
 }
 
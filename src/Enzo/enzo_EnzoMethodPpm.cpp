@@ -42,6 +42,18 @@ EnzoMethodPpm::EnzoMethodPpm ()
   refresh(ir)->add_field(field_descr->field_id("acceleration_y"));
   refresh(ir)->add_field(field_descr->field_id("acceleration_z"));
 
+  // Declare modified fields so later refreshes can be merged into
+  // this one
+
+  add_field_written("density");
+  add_field_written("velocity_x");
+  add_field_written("velocity_y");
+  add_field_written("velocity_z");
+  add_field_written("total_energy");
+  add_field_written("internal_energy");
+  add_field_written("pressure");
+  add_group_written("color");
+
   // PPM parameters initialized in EnzoBlock::initialize()
 }
 
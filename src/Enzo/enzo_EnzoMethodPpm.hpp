@@ -42,6 +42,10 @@ public: // virtual methods
   /// Compute maximum timestep for this method
   virtual double timestep ( Block * block) const throw();
 
+  /// Fluxes update conserved quantities
+  virtual bool is_conservative () const throw()
+  { return true; }
+
 protected: // interface
 
   bool comoving_coordinates_;
@@ -23,6 +23,23 @@ EnzoMethodPpml::EnzoMethodPpml()
 			     enzo_sync_id_method_ppml);
 
   refresh(ir)->add_all_fields();
+
+  // Declare modified fields so later refreshes can be merged into
+  // this one
+
+  const std::string field_names[] =
+    { "velox", "veloy", "veloz", "bfieldx", "bfieldy", "bfieldz" };
+
+  add_field_written("density");
+  add_field_written("dens_rx");
+  add_field_written("dens_ry");
+  add_field_written("dens_rz");
+  for (int i=0; i<6; i++) {
+    add_field_written(field_names[i]);
+    add_field_written(field_names[i] + "_rx");
+    add_field_written(field_names[i] + "_ry");
+    add_field_written(field_names[i] + "_rz");
+  }
 }
 
 //----------------------------------------------------------------------
@@ -40,6 +40,10 @@ public: // interface
   /// Compute maximum timestep for this method
   virtual double timestep ( Block * block) const throw();
 
+  /// Fluxes update conserved quantities
+  virtual bool is_conservative () const throw()
+  { return true; }
+
 protected: // interface
 
   bool comoving_coordinates_;
@@ -44,6 +44,15 @@ EnzoMethodTurbulence::EnzoMethodTurbulence
 
   refresh(ir)->add_all_fields();
 
+  // Declare modified fields so later refreshes can be merged into
+  // this one
+
+  add_field_written("velocity_x");
+  add_field_written("velocity_y");
+  add_field_written("velocity_z");
+  add_field_written("total_energy");
+  add_field_written("temperature");
+
    // TURBULENCE parameters initialized in EnzoBlock::initialize()
 }
 
@@ -52,6 +52,10 @@ public: // interface
   virtual void compute_resume ( Block * block,
 				CkReductionMsg * msg) throw(); 
 
+  /// Turbulence statistics are reduced over all Blocks
+  virtual bool is_global_reduction () const throw()
+  { return true; }
+
 private: // methods
 
   void compute_resume_ (Block * block, CkReductionMsg * msg) throw();
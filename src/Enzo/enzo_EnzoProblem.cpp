@@ -301,7 +301,8 @@ Solver * EnzoProblem::create_solver_
        enzo_config->solver_max_level[index_solver],
        enzo_config->solver_iter_max[index_solver],
        enzo_config->solver_res_tol[index_solver],
-       enzo_config->solver_precondition[index_solver]);
+       enzo_config->solver_precondition[index_solver],
+       enzo_config->solver_pipelined[index_solver]);
 
   } else if (solver_type == "dd") {
 
@@ -339,7 +340,8 @@ Solver * EnzoProblem::create_solver_
        enzo_config->solver_iter_max[index_solver],
        enzo_config->solver_res_tol[index_solver],
        enzo_config->solver_precondition[index_solver],
-       enzo_config->solver_coarse_level[index_solver]);
+       enzo_config->solver_coarse_level[index_solver],
+       enzo_config->solver_s_step[index_solver]);
 
   } else if (solver_type == "diagonal") {
 
@@ -29,6 +29,23 @@
 /// LINE 16:     P = R + beta * (P - omega * V)
 /// LINE 17:  end for
 
+/// If s_step > 1, the s-step ("communication-avoiding") variant is
+/// used instead, which replaces the per-iteration reductions above
+/// with a single reduction every s iterations.  Each outer iteration
+/// computes the (scaled) monomial Krylov bases P_k = A^k P, k <= 2s,
+/// and R_k = A^k R, k <= 2s-1, reduces their Gram matrix G and inner
+/// products g with R0, then performs s iterations of the loop above
+/// on coefficient vectors in the basis Y = [P_k, R_k], updating X, R
+/// and P only once at the end.  See E. Carson, "Communication-Avoiding
+/// Krylov Subspace Methods in Theory and Practice" (PhD thesis, UC
+/// Berkeley, 2015), Algorithm 6.
+///
+/// CA LINE 01:  [ P_k, R_k ] = [ A^k P, A^k R ]
+/// CA LINE 02:  G = Y' * Y, g = Y' * R0
+/// CA LINE 03:  for j=0,...,s-1 using G, g on coefficient vectors
+/// CA LINE 04:     LINES 05 - 16 above with M = I
+/// CA LINE 05:  X = X + Y*x', R = Y*r', P = Y*p'
+
 #include "cello.hpp"
 #include "charm_simulation.hpp"
 #include "enzo.hpp"
@@ -171,7 +188,8 @@ EnzoSolverBiCgStab::EnzoSolverBiCgStab
  int min_level, int max_level,
  int iter_max, double res_tol,
  int index_precon,
- int coarse_level
+ int coarse_level,
+ int s_step
  ) 
   : Solver(name,
 	   field_x,
@@ -189,7 +207,11 @@ EnzoSolverBiCgStab::EnzoSolverBiCgStab
     iy_(0), iv_(0), iq_(0), iu_(0),
     m_(0), mx_(0), my_(0), mz_(0),
     gx_(0), gy_(0), gz_(0),
-    coarse_level_(coarse_level)
+    coarse_level_(coarse_level),
+    s_step_(s_step),
+    ica_(),
+    is_ca_theta_(0),
+    is_ca_power_(0)
 {
 
   //  if (solve_type == solve_tree) {
@@ -221,6 +243,24 @@ EnzoSolverBiCgStab::EnzoSolverBiCgStab
   is_us_ =     scalar_descr_quad->new_value("solver_bicgstab_us");
   is_qs_ =     scalar_descr_quad->new_value("solver_bicgstab_qs");
 
+  if (s_step_ > 1 && solve_type == solve_tree) {
+    WARNING1 ("EnzoSolverBiCgStab::EnzoSolverBiCgStab()",
+	      "s_step = %d not supported with solve_type tree: using s_step = 1",
+	      s_step_);
+    s_step_ = 1;
+  }
+  if (s_step_ > 1 && index_precon >= 0) {
+    WARNING1 ("EnzoSolverBiCgStab::EnzoSolverBiCgStab()",
+	      "s_step = %d not supported with a preconditioner: using s_step = 1",
+	      s_step_);
+    s_step_ = 1;
+  }
+  s_step_ = std::max(1,s_step_);
+
+  if (s_step_ > 1) {
+    is_ca_theta_ = scalar_descr_quad->new_value("solver_bicgstab_ca_theta");
+  }
+
   if (solve_type == solve_tree) {
    
     function_.push_back(&EnzoSolverBiCgStab::start_2); // inner_product 0
@@ -236,6 +276,9 @@ EnzoSolverBiCgStab::EnzoSolverBiCgStab
   
   ScalarDescr * scalar_descr_int = cello::scalar_descr_int();
   is_iter_ = scalar_descr_int->new_value("solver_bicgstab_iter");
+  if (s_step_ > 1) {
+    is_ca_power_ = scalar_descr_int->new_value("solver_bicgstab_ca_power");
+  }
 
   FieldDescr * field_descr = cello::field_descr();
 
@@ -246,6 +289,16 @@ EnzoSolverBiCgStab::EnzoSolverBiCgStab
   iv_ = field_descr->insert_temporary();
   iq_ = field_descr->insert_temporary();
   iu_ = field_descr->insert_temporary();
+
+  if (s_step_ > 1) {
+    // s-step basis, reusing P and R for P_0 and R_0
+    ica_.resize(ca_num_basis_());
+    for (int k=0; k<ca_num_basis_(); k++) {
+      ica_[k] = field_descr->insert_temporary();
+    }
+    ica_[ca_p_(0)] = ip_;
+    ica_[ca_r_(0)] = ir_;
+  }
   
   /// Initialize default Refresh (called before entry to compute())
 
@@ -698,6 +751,10 @@ void EnzoSolverBiCgStab::loop_0(EnzoBlock* block) throw() {
     this->end(block, return_diverged);
 
     
+  } else if (s_step_ > 1) {
+
+    ca_loop(block);
+
   } else {
 
     loop_2(block);
@@ -852,38 +909,24 @@ void EnzoSolverBiCgStab::loop_4(EnzoBlock* block) throw() {
   COPY_FIELD(block,iy_,"Y1_bcg");
   COPY_FIELD(block,ip_,"P1_bcg");
   
+  std::vector<long double> reduce;
+  reduce.resize(3+1);
+  reduce.clear();
+  reduce[0] = 3;
+  
   if (is_finest_(block)) {
 
     /// LINE 05: V = A * Y
-    
-    A_->matvec(iv_, iy_, block);
+    /// LINE 07 [part]  vr0_ = V*R0, computed in the same pass
+
+    reduce[1] = A_->matvec_dot(iv_, iy_, ir0_, block);
 
   }
 
   COPY_FIELD(block,iv_,"V1_bcg");
-  /// compute local contributions to vr0_ = DOT(V, R0)
-  
-  std::vector<long double> reduce;
-  reduce.resize(3+1);
-  reduce.clear();
-  reduce[0] = 3;
   
   if (is_finest_(block)) {
     
-    enzo_float* R0 = (enzo_float*) field.values(ir0_);
-    enzo_float* V  = (enzo_float*) field.values(iv_);
-
-    /// LINE 07 [part]  vr0_ = V*R0
-    
-    for (int iz=gz_; iz<mz_-gz_; iz++) {
-      for (int iy=gy_; iy<my_-gy_; iy++) {
-	for (int ix=gx_; ix<mx_-gx_; ix++) {
-	  int i = ix + mx_*(iy + my_*iz);
-	  reduce[1] += V[i]*R0[i];
-	}
-      }
-    }
-    
     /// for singular Poisson problems need all vectors in R(A), so
     /// project both Y and V into R(A)
 
@@ -1166,34 +1209,33 @@ void EnzoSolverBiCgStab::loop_10(EnzoBlock* block) throw() {
   COPY_FIELD(block,iq_,"Q2_bcg");
   COPY_FIELD(block,iy_,"Y2_bcg");
 
+  std::vector<long double> reduce;
+  reduce.resize(5+1);
+  reduce.clear();
+  reduce[0] = 5;
+  
   if (is_finest_(block)) {
 
     /// LINE 11:     U = A * Y
+    /// omega_n = DOT(U, Q), computed in the same pass
     
-    A_->matvec(iu_, iy_, block);     /// apply matrix to local block
+    reduce[1] = A_->matvec_dot(iu_, iy_, iq_, block);
 
   }
 
   COPY_FIELD(block,iu_,"U");
 
-  std::vector<long double> reduce;
-  reduce.resize(5+1);
-  reduce.clear();
-  reduce[0] = 5;
-  
   if (is_finest_(block)) {
     
     enzo_float* U  = (enzo_float*) field.values(iu_);
     enzo_float* Q  = (enzo_float*) field.values(iq_);
     
-    /// omega_n = DOT(U, Q)
     /// omega_d = DOT(U, U)
   
     for (int iz=gz_; iz<mz_-gz_; iz++) {
       for (int iy=gy_; iy<my_-gy_; iy++) {
 	for (int ix=gx_; ix<mx_-gx_; ix++) {
 	  int i = ix + mx_*(iy + my_*iz);
-	  reduce[1] += U[i]*Q[i];
 	  reduce[2] += U[i]*U[i];
 	}
       }
@@ -1514,6 +1556,348 @@ void EnzoBlock::r_solver_bicgstab_loop_15(CkReductionMsg* msg) {
   performance_stop_(perf_compute,__FILE__,__LINE__);
 }
 
+//======================================================================
+// s-step (communication-avoiding) variant
+//======================================================================
+
+void EnzoSolverBiCgStab::ca_loop (EnzoBlock * block) throw()
+{
+  TRACE_BCG(block,this,"ca_loop");
+
+  if (s_iter_(block) == 0) S(ca_theta) = 1.0;
+
+  s_ca_power_(block) = 0;
+
+  /// CA LINE 01: refresh P_0, R_0, then continue with
+  /// p_solver_bicgstab_ca_powers()
+
+  const int npr = ca_powers_per_refresh_();
+  const int min_face_rank = (npr > 1) ? 0 : cello::rank() - 1;
+  const int ghost_depth   = (npr > 1) ? gx_ : A_->ghost_depth();
+
+  Refresh refresh
+    (ghost_depth,min_face_rank,neighbor_type_(),
+     sync_type_(), enzo_sync_id_solver_bicgstab_ca_0);
+
+  refresh.set_active(is_finest_(block));
+  refresh.add_field(ica_[ca_p_(0)]);
+  refresh.add_field(ica_[ca_r_(0)]);
+
+  block->refresh_enter
+    (CkIndex_EnzoBlock::p_solver_bicgstab_ca_powers(),&refresh);
+}
+
+//----------------------------------------------------------------------
+
+void EnzoBlock::p_solver_bicgstab_ca_powers() {
+
+  performance_start_(perf_compute,__FILE__,__LINE__);
+
+  static_cast<EnzoSolverBiCgStab*> (solver())->ca_powers(this);
+
+  performance_stop_(perf_compute,__FILE__,__LINE__);
+}
+
+//----------------------------------------------------------------------
+
+void EnzoSolverBiCgStab::ca_powers (EnzoBlock * block) throw()
+{
+  TRACE_BCG(block,this,"ca_powers");
+
+  const int s = s_step_;
+  const int npr = ca_powers_per_refresh_();
+  const int r = A_->ghost_depth();
+
+  Field field = block->data()->field();
+
+  int & k = s_ca_power_(block);
+
+  // Compute up to npr powers from the current refresh: the j'th
+  // product is valid on [j*r, m - j*r), and the last before a refresh
+  // only updates the interior so that early-arriving ghost values
+  // from the next refresh are not overwritten
+
+  const long double theta = S(ca_theta);
+
+  for (int j=1; j<=npr && k<2*s; j++, k++) {
+
+    const bool last = (j == npr) || (k+1 == 2*s);
+    const int g0 = last ? gx_ : j*r;
+
+    if (is_finest_(block)) {
+
+      A_->matvec (ica_[ca_p_(k+1)], ica_[ca_p_(k)], block, g0);
+      if (k+1 <= 2*s-1) {
+	A_->matvec (ica_[ca_r_(k+1)], ica_[ca_r_(k)], block, g0);
+      }
+
+      if (theta != 1.0) {
+	const enzo_float scale = 1.0 / theta;
+	enzo_float * P = (enzo_float*) field.values(ica_[ca_p_(k+1)]);
+	for (int i=0; i<m_; i++) P[i] *= scale;
+	if (k+1 <= 2*s-1) {
+	  enzo_float * R = (enzo_float*) field.values(ica_[ca_r_(k+1)]);
+	  for (int i=0; i<m_; i++) R[i] *= scale;
+	}
+      }
+    }
+  }
+
+  if (k < 2*s) {
+
+    // Refresh latest P_k, R_k, alternating sync id's since neighbors
+    // may be one refresh ahead, and continue with
+    // p_solver_bicgstab_ca_powers()
+
+    const int sync_id = ((k/npr) % 2 == 0) ?
+      enzo_sync_id_solver_bicgstab_ca_0 : enzo_sync_id_solver_bicgstab_ca_1;
+
+    const int min_face_rank = (npr > 1) ? 0 : cello::rank() - 1;
+    const int ghost_depth   = (npr > 1) ? gx_ : r;
+
+    Refresh refresh
+      (ghost_depth,min_face_rank,neighbor_type_(), sync_type_(), sync_id);
+
+    refresh.set_active(is_finest_(block));
+    refresh.add_field(ica_[ca_p_(k)]);
+    if (k <= 2*s-1) refresh.add_field(ica_[ca_r_(k)]);
+
+    block->refresh_enter
+      (CkIndex_EnzoBlock::p_solver_bicgstab_ca_powers(),&refresh);
+
+    return;
+  }
+
+  /// CA LINE 02: G = Y' * Y, g = Y' * R0, and column sums for
+  /// projecting singular problems
+
+  const int n = ca_num_basis_();
+  const int ng = n*(n+1)/2;
+
+  std::vector<long double> reduce (1 + ng + 2*n, 0.0);
+  reduce[0] = ng + 2*n;
+
+  if (is_finest_(block)) {
+
+    long double * G   = &reduce[1];
+    long double * g   = &reduce[1+ng];
+    long double * sum = &reduce[1+ng+n];
+
+    std::vector<enzo_float *> Y(n);
+    for (int l=0; l<n; l++) Y[l] = (enzo_float*) field.values(ica_[l]);
+    enzo_float * R0 = (enzo_float*) field.values(ir0_);
+
+    std::vector<long double> y(n);
+    for (int iz=gz_; iz<mz_-gz_; iz++) {
+      for (int iy=gy_; iy<my_-gy_; iy++) {
+	for (int ix=gx_; ix<mx_-gx_; ix++) {
+	  int i = ix + mx_*(iy + my_*iz);
+	  for (int l=0; l<n; l++) y[l] = Y[l][i];
+	  for (int l=0, lm=0; l<n; l++) {
+	    for (int m=l; m<n; m++,lm++) G[lm] += y[l]*y[m];
+	    g[l]   += y[l]*R0[i];
+	    sum[l] += y[l];
+	  }
+	}
+      }
+    }
+  }
+
+  CkCallback callback (CkIndex_EnzoBlock::r_solver_bicgstab_ca_gram(NULL), 
+		       block->proxy_array());
+
+  block->contribute(reduce.size()*sizeof(long double), &reduce[0], 
+		    sum_long_double_n_type, callback);
+}
+
+//----------------------------------------------------------------------
+
+void EnzoBlock::r_solver_bicgstab_ca_gram(CkReductionMsg* msg) {
+
+  performance_start_(perf_compute,__FILE__,__LINE__);
+
+  static_cast<EnzoSolverBiCgStab*> (solver())->ca_update(this,msg);
+
+  performance_stop_(perf_compute,__FILE__,__LINE__);
+}
+
+//----------------------------------------------------------------------
+
+void EnzoSolverBiCgStab::ca_update
+(EnzoBlock * block, CkReductionMsg * msg) throw()
+{
+  TRACE_BCG(block,this,"ca_update");
+
+  const int s = s_step_;
+  const int n = ca_num_basis_();
+  const int ng = n*(n+1)/2;
+
+  long double * data = (long double*) msg->getData();
+  ASSERT2("EnzoSolverBiCgStab::ca_update",
+	  "Expecting (data[0] = %d) == %d",
+	  int(data[0]),ng+2*n,(data[0] == ng+2*n));
+
+  std::vector<long double> G(n*n), g(n), sum(n);
+  for (int l=0, lm=0; l<n; l++) {
+    for (int m=l; m<n; m++,lm++) {
+      G[l*n+m] = G[m*n+l] = data[1+lm];
+    }
+    g[l]   = data[1+ng+l];
+    sum[l] = data[1+ng+n+l];
+  }
+
+  delete msg;
+
+  const long double theta = S(ca_theta);
+
+  std::vector<long double> xc(n,0.0), rc(n,0.0), pc(n,0.0);
+  pc[ca_p_(0)] = 1.0;
+  rc[ca_r_(0)] = 1.0;
+
+  /// CA LINE 03: s iterations on coefficient vectors
+
+  const int iter = s_iter_(block);
+  long double beta_n = ca_dot_g_(rc,g);
+  long double rr = S(rr);
+  int steps = 0;
+
+  for (int j=0; j<s && (iter + steps) < iter_max_; j++) {
+
+    const std::vector<long double> tp = ca_shift_(pc,theta);
+
+    const long double vr0 = ca_dot_g_(tp,g);
+    if (vr0 == 0.0) break;
+
+    const long double alpha = beta_n / vr0;
+
+    std::vector<long double> qc(n);
+    for (int l=0; l<n; l++) qc[l] = rc[l] - alpha*tp[l];
+
+    const std::vector<long double> tq = ca_shift_(qc,theta);
+
+    const long double omega_d = ca_dot_G_(tq,tq,G);
+    const long double omega = (omega_d == 0.0) ? 0.0 : ca_dot_G_(tq,qc,G) / omega_d;
+
+    for (int l=0; l<n; l++) {
+      xc[l] += alpha*pc[l] + omega*qc[l];
+      rc[l] =  qc[l] - omega*tq[l];
+    }
+
+    ++steps;
+    rr = std::abs(ca_dot_G_(rc,rc,G));
+
+    if (omega == 0.0 || sqrt(rr) / S(rho0) < res_tol_) break;
+
+    const long double beta_n_new = ca_dot_g_(rc,g);
+    const long double beta = (beta_n_new / beta_n) * (alpha / omega);
+    for (int l=0; l<n; l++) {
+      pc[l] = rc[l] + beta*(pc[l] - omega*tp[l]);
+    }
+    beta_n = beta_n_new;
+  }
+
+  if (steps == 0) {
+    WARNING1 ("EnzoSolverBiCgStab::ca_update()",
+	      "s-step breakdown at iteration %d",iter);
+    this->end(block, return_diverged);
+    return;
+  }
+
+  /// CA LINE 05: X = X + Y*x', R = Y*r', P = Y*p'
+
+  if (is_finest_(block)) {
+
+    Field field = block->data()->field();
+
+    std::vector<enzo_float *> Y(n);
+    for (int l=0; l<n; l++) Y[l] = (enzo_float*) field.values(ica_[l]);
+    enzo_float * X = (enzo_float*) field.values(ix_);
+    enzo_float * R = (enzo_float*) field.values(ir_);
+    enzo_float * P = (enzo_float*) field.values(ip_);
+
+    // For singular problems remove any drift from R(A) in the updates
+
+    long double xs = 0.0, rs = 0.0, ps = 0.0;
+    if (is_singular_()) {
+      for (int l=0; l<n; l++) {
+	xs += xc[l]*sum[l];
+	rs += rc[l]*sum[l];
+	ps += pc[l]*sum[l];
+      }
+      xs /= S(c);
+      rs /= S(c);
+      ps /= S(c);
+    }
+
+    for (int i=0; i<m_; i++) {
+      long double x = 0.0, r = 0.0, p = 0.0;
+      for (int l=0; l<n; l++) {
+	const long double y = Y[l][i];
+	x += xc[l]*y;
+	r += rc[l]*y;
+	p += pc[l]*y;
+      }
+      X[i] += x - xs;
+      R[i] =  r - rs;
+      P[i] =  p - ps;
+    }
+  }
+
+  // Update basis scaling from growth of the highest powers, which
+  // approximates the spectral radius of A
+
+  const long double pp0 = G[ca_p_(2*s-1)*n + ca_p_(2*s-1)];
+  const long double pp1 = G[ca_p_(2*s)*n   + ca_p_(2*s)];
+  if (pp0 > 0.0 && pp1 > 0.0) S(ca_theta) = theta*sqrt(pp1/pp0);
+
+  S(beta_n) = beta_n;
+  S(rr)     = rr;
+  s_iter_(block) += steps;
+
+  loop_0(block);
+}
+
+//----------------------------------------------------------------------
+
+long double EnzoSolverBiCgStab::ca_dot_G_
+(const std::vector<long double> & a,
+ const std::vector<long double> & b,
+ const std::vector<long double> & G) const
+{
+  const int n = a.size();
+  long double d = 0.0;
+  for (int l=0; l<n; l++) {
+    for (int m=0; m<n; m++) {
+      d += a[l]*G[l*n+m]*b[m];
+    }
+  }
+  return d;
+}
+
+//----------------------------------------------------------------------
+
+long double EnzoSolverBiCgStab::ca_dot_g_
+(const std::vector<long double> & a,
+ const std::vector<long double> & g) const
+{
+  long double d = 0.0;
+  for (size_t l=0; l<a.size(); l++) d += g[l]*a[l];
+  return d;
+}
+
+//----------------------------------------------------------------------
+
+std::vector<long double> EnzoSolverBiCgStab::ca_shift_
+(const std::vector<long double> & a, long double theta) const
+// Coefficients of A*Y*a given A*P_k = theta*P_k+1, A*R_k = theta*R_k+1
+{
+  const int s = s_step_;
+  std::vector<long double> b(a.size(),0.0);
+  for (int k=0; k<2*s; k++)   b[ca_p_(k+1)] = theta*a[ca_p_(k)];
+  for (int k=0; k<2*s-1; k++) b[ca_r_(k+1)] = theta*a[ca_r_(k)];
+  return b;
+}
+
 //----------------------------------------------------------------------
 
 void EnzoSolverBiCgStab::end (EnzoBlock* block, int retval) throw () {
@@ -7,7 +7,9 @@
 /// @brief    [\ref Enzo] Declaration of EnzoSolverBiCgStab
 ///
 /// Bicongugate gradient stabilized solver (BiCgStab) for solving 
-/// linear systems on field data.
+/// linear systems on field data.  Optionally uses an s-step
+/// ("communication-avoiding") formulation that performs s iterations
+/// per global reduction.
 
 #ifndef ENZO_ENZO_SOLVER_BICGSTAB_HPP
 #define ENZO_ENZO_SOLVER_BICGSTAB_HPP
@@ -38,7 +40,8 @@ public: // interface
 		     int iter_max, 
 		     double res_tol,
 		     int index_precon,
-		     int coarse_level);
+		     int coarse_level,
+		     int s_step = 1);
 
   /// default constructor
   EnzoSolverBiCgStab()
@@ -51,7 +54,11 @@ public: // interface
       iy_(-1), iv_(-1), iq_(-1), iu_(-1),
       m_(0), mx_(0), my_(0), mz_(0),
       gx_(0), gy_(0), gz_(0),
-      coarse_level_(0)
+      coarse_level_(0),
+      s_step_(1),
+      ica_(),
+      is_ca_theta_(0),
+      is_ca_power_(0)
   {};
 
   /// Charm++ PUP::able declarations
@@ -68,7 +75,11 @@ public: // interface
       iy_(-1), iv_(-1), iq_(-1), iu_(-1),
       m_(0), mx_(0), my_(0), mz_(0),
       gx_(0), gy_(0), gz_(0),
-       coarse_level_(0)
+      coarse_level_(0),
+      s_step_(1),
+      ica_(),
+      is_ca_theta_(0),
+      is_ca_power_(0)
   {}
 
   /// Charm++ Pack / Unpack function
@@ -126,6 +137,10 @@ public: // interface
     p | is_dot_sync_;
     p | is_iter_;
     p | coarse_level_;
+    p | s_step_;
+    p | ica_;
+    p | is_ca_theta_;
+    p | is_ca_power_;
   }
 
   
@@ -176,6 +191,17 @@ public: // interface
   /// Updates search direction, begins update on iteration counter
   void loop_14(EnzoBlock* enzo_block, CkReductionMsg * ) throw();
 
+  /// s-step: begins refresh on the current basis vectors P_k, R_k
+  void ca_loop(EnzoBlock* enzo_block) throw();
+
+  /// s-step: computes basis matrix powers P_k = A^k P and R_k = A^k
+  /// R, begins either the next refresh or the Gram matrix reduction
+  void ca_powers(EnzoBlock* enzo_block) throw();
+
+  /// s-step: performs s BiCgStab iterations in coefficient space
+  /// using the reduced Gram matrix, then updates X, R and P
+  void ca_update(EnzoBlock* enzo_block, CkReductionMsg * ) throw();
+
   /// End the solve
   void end(EnzoBlock* enzo_block, int retval) throw();
 
@@ -202,6 +228,10 @@ public: // interface
     field.allocate_temporary(iv_);
     field.allocate_temporary(iq_);
     field.allocate_temporary(iu_);
+    for (size_t k=0; k<ica_.size(); k++) {
+      if (ica_[k] != ip_ && ica_[k] != ir_)
+	field.allocate_temporary(ica_[k]);
+    }
   }
 
   /// Dellocate temporary Fields
@@ -215,6 +245,10 @@ public: // interface
     field.deallocate_temporary(iv_);
     field.deallocate_temporary(iq_);
     field.deallocate_temporary(iu_);
+    for (size_t k=0; k<ica_.size(); k++) {
+      if (ica_[k] != ip_ && ica_[k] != ir_)
+	field.deallocate_temporary(ica_[k]);
+    }
   }
   
   // Inner product methods
@@ -263,6 +297,38 @@ protected:
 
   int & s_iter_(EnzoBlock * block)
   { return *block->data()->scalar_int().value(is_iter_); }
+
+  int & s_ca_power_(EnzoBlock * block)
+  { return *block->data()->scalar_int().value(is_ca_power_); }
+
+  /// Number of matrix powers computed per refresh in the s-step
+  /// variant: deeper ghost zones are only exploited on unigrid meshes,
+  /// since refresh across levels interpolates the ghost values
+  int ca_powers_per_refresh_() const
+  {
+    const int r = A_->ghost_depth();
+    return (cello::config()->mesh_max_level == 0) ?
+      std::max(1,gx_/r) : 1;
+  }
+
+  /// Number of s-step basis vectors [P_0 ... P_2s, R_0 ... R_2s-1]
+  int ca_num_basis_() const
+  { return 4*s_step_ + 1; }
+
+  /// Index into ica_[] of basis vector P_k or R_k
+  int ca_p_(int k) const { return k; }
+  int ca_r_(int k) const { return 2*s_step_ + 1 + k; }
+
+  /// s-step coefficient-space inner products a'*G*b and g'*a
+  long double ca_dot_G_ (const std::vector<long double> & a,
+			 const std::vector<long double> & b,
+			 const std::vector<long double> & G) const;
+  long double ca_dot_g_ (const std::vector<long double> & a,
+			 const std::vector<long double> & g) const;
+
+  /// s-step coefficients of A*Y*a in the basis Y
+  std::vector<long double> ca_shift_ (const std::vector<long double> & a,
+				       long double theta) const;
   
 protected: // attributes
 
@@ -327,6 +393,20 @@ protected: // attributes
   /// The level of the tree solve if solve_type == solve_tree
   int coarse_level_;
 
+  /// Number of iterations per reduction for the s-step variant (1 if
+  /// standard BiCgStab)
+  int s_step_;
+
+  /// s-step basis vector id's [P_0 ... P_2s, R_0 ... R_2s-1], with
+  /// P_0 == ip_ and R_0 == ir_
+  std::vector<int> ica_;
+
+  /// s-step basis scaling: P_k+1 = A*P_k / theta
+  int is_ca_theta_;
+
+  /// s-step number of basis matrix powers computed so far
+  int is_ca_power_;
+
 };
 
 #endif /* ENZO_ENZO_SOLVER_BICGSTAB_HPP */
@@ -69,7 +69,8 @@ EnzoSolverCg::EnzoSolverCg
  int solve_type,
  int min_level, int max_level,
  int iter_max, double res_tol,
- int index_precon
+ int index_precon,
+ bool pipelined
  )
   : Solver(name,
 	   field_x,
@@ -90,10 +91,33 @@ EnzoSolverCg::EnzoSolverCg
     res_tol_(res_tol),
     rr0_(0.0),
     rr_min_(0.0),rr_max_(0.0),
-    rr_(0.0), rz_(0.0), rz2_(0.0), dy_(0.0), bs_(0.0), rs_(0.0), xs_(0.0),
+    rr_(0.0), rz_(0.0), rz2_(0.0), rzp_(0.0),
+    dy_(0.0), bs_(0.0), rs_(0.0), xs_(0.0),
     bc_(0.0),
-    local_(solve_type==solve_block)
+    local_(solve_type==solve_block),
+    pipelined_(pipelined && solve_type!=solve_block),
+    is_rzp_(-1),
+    iw_(-1), iq_(-1),
+    is_gamma_(-1), is_gamma_old_(-1), is_delta_(-1), is_alpha_(-1),
+    is_rs_(-1), is_xs_(-1), is_bs_(-1), is_bc_(-1),
+    is_rr0_(-1), is_rr_min_(-1), is_rr_max_(-1),
+    is_iter_(-1), is_pipe_sync_(-1)
 {
+  if (index_precon_ >= 0 && local_) {
+    WARNING1 ("EnzoSolverCg::EnzoSolverCg()",
+	      "Preconditioner not supported with solve_type block "
+	      "in Solver %s: ignoring preconditioner",
+	      name.c_str());
+    index_precon_ = -1;
+  }
+  if (index_precon_ >= 0 && pipelined_) {
+    WARNING1 ("EnzoSolverCg::EnzoSolverCg()",
+	      "Preconditioner not supported with pipelined CG "
+	      "in Solver %s: using standard CG",
+	      name.c_str());
+    pipelined_ = false;
+  }
+
   FieldDescr * field_descr = cello::field_descr();
 
   id_ = field_descr->insert_temporary();
@@ -101,6 +125,45 @@ EnzoSolverCg::EnzoSolverCg
   iy_ = field_descr->insert_temporary();
   iz_ = field_descr->insert_temporary();
 
+  if (pipelined_) {
+
+    iw_ = field_descr->insert_temporary();
+    iq_ = field_descr->insert_temporary();
+
+    // Scalars are per-Block since Blocks on the same process may
+    // be at different iterations
+
+    ScalarDescr * scalar_descr_quad = cello::scalar_descr_long_double();
+
+    is_gamma_     = scalar_descr_quad->new_value(name + ":cg_gamma");
+    is_gamma_old_ = scalar_descr_quad->new_value(name + ":cg_gamma_old");
+    is_delta_     = scalar_descr_quad->new_value(name + ":cg_delta");
+    is_alpha_     = scalar_descr_quad->new_value(name + ":cg_alpha");
+    is_rs_        = scalar_descr_quad->new_value(name + ":cg_rs");
+    is_xs_        = scalar_descr_quad->new_value(name + ":cg_xs");
+    is_bs_        = scalar_descr_quad->new_value(name + ":cg_bs");
+    is_bc_        = scalar_descr_quad->new_value(name + ":cg_bc");
+    is_rr0_       = scalar_descr_quad->new_value(name + ":cg_rr0");
+    is_rr_min_    = scalar_descr_quad->new_value(name + ":cg_rr_min");
+    is_rr_max_    = scalar_descr_quad->new_value(name + ":cg_rr_max");
+
+    ScalarDescr * scalar_descr_int = cello::scalar_descr_int();
+    is_iter_ = scalar_descr_int->new_value(name + ":cg_iter");
+
+    ScalarDescr * scalar_descr_sync = cello::scalar_descr_sync();
+    is_pipe_sync_ = scalar_descr_sync->new_value(name + ":cg_pipe_sync");
+  }
+
+  if (index_precon_ >= 0) {
+
+    // Per-Block since the preconditioner returns to each Block
+    // independently
+
+    ScalarDescr * scalar_descr_quad = cello::scalar_descr_long_double();
+
+    is_rzp_ = scalar_descr_quad->new_value(name + ":cg_rzp");
+  }
+
   /// Initialize default Refresh
 
   field_descr->ghost_depth    (ib_,&gx_,&gy_,&gz_);
@@ -158,11 +221,30 @@ void EnzoSolverCg::pup (PUP::er &p)
   p | rr_max_;
   p | rz_;
   p | rz2_;
+  p | rzp_;
   p | dy_;
   p | bs_;
   p | bc_;
 
   p | local_;
+
+  p | pipelined_;
+  p | is_rzp_;
+  p | iw_;
+  p | iq_;
+  p | is_gamma_;
+  p | is_gamma_old_;
+  p | is_delta_;
+  p | is_alpha_;
+  p | is_rs_;
+  p | is_xs_;
+  p | is_bs_;
+  p | is_bc_;
+  p | is_rr0_;
+  p | is_rr_min_;
+  p | is_rr_max_;
+  p | is_iter_;
+  p | is_pipe_sync_;
 }
 
 //======================================================================
@@ -207,6 +289,11 @@ void EnzoSolverCg::compute_ (EnzoBlock * enzo_block) throw()
     local_cg_(enzo_block);
     return;
   }
+  // If pipelined, call single-reduction CG solver
+  if (pipelined_) {
+    pipe_compute_(enzo_block);
+    return;
+  }
   
   iter_ = 0;
 
@@ -448,6 +535,54 @@ void EnzoBlock::r_solver_cg_shift_1 (CkReductionMsg * msg)
 //----------------------------------------------------------------------
 
 void EnzoSolverCg::loop_2a (EnzoBlock * enzo_block) throw()
+//     if (iter == 0) solve(M*Z = R), D = Z
+{
+  if (iter_ == 0 && index_precon_ >= 0) {
+
+    apply_precon_ (enzo_block, CkIndex_EnzoBlock::p_solver_cg_precon_0());
+
+  } else {
+
+    refresh_2a_(enzo_block);
+
+  }
+}
+
+//----------------------------------------------------------------------
+
+void EnzoBlock::p_solver_cg_precon_0 ()
+{
+  performance_start_(perf_compute,__FILE__,__LINE__);
+
+  EnzoSolverCg * solver = 
+    static_cast<EnzoSolverCg*> (this->solver());
+
+  solver->precon_0(this);
+  performance_stop_(perf_compute,__FILE__,__LINE__);
+}
+
+//----------------------------------------------------------------------
+
+void EnzoSolverCg::precon_0 (EnzoBlock * enzo_block) throw()
+{
+  if (is_finest_(enzo_block)) {
+
+    Field field = enzo_block->data()->field();
+
+    enzo_float * D = (enzo_float*) field.values(id_);
+    enzo_float * Z = (enzo_float*) field.values(iz_);
+
+    for (int i=0; i<mx_*my_*mz_; i++) {
+      D[i] = Z[i];
+    }
+  }
+
+  refresh_2a_(enzo_block);
+}
+
+//----------------------------------------------------------------------
+
+void EnzoSolverCg::refresh_2a_ (EnzoBlock * enzo_block) throw()
 {
   Refresh refresh (4,0,neighbor_type_(), sync_type_(),
 		   enzo_sync_id_solver_cg_loop_2a);
@@ -509,18 +644,14 @@ void EnzoSolverCg::loop_2b (EnzoBlock * enzo_block) throw()
     Data * data = enzo_block->data();
     Field field = data->field();
 
-    if (is_finest_(enzo_block)) {
-
-      A_->matvec(iy_,id_,enzo_block);
-
-    }
-
     long double reduce[3] = {0.0, 0.0, 0.0};
 
     if (is_finest_(enzo_block)) {
 
-      enzo_float * D = (enzo_float*) field.values(id_);
-      enzo_float * Y = (enzo_float*) field.values(iy_);
+      // Y = MATVEC(A,D), with DOT(D,Y) computed in the same pass
+
+      reduce[2] = A_->matvec_dot(iy_,id_,id_,enzo_block);
+
       enzo_float * R = (enzo_float*) field.values(ir_);
       enzo_float * Z = (enzo_float*) field.values(iz_);
 
@@ -530,7 +661,6 @@ void EnzoSolverCg::loop_2b (EnzoBlock * enzo_block) throw()
 	    int i = ix + mx_*(iy + my_*iz);
 	    reduce[0] += R[i]*R[i];
 	    reduce[1] += R[i]*Z[i];
-	    reduce[2] += D[i]*Y[i];
 	  }
 	}
       }
@@ -574,9 +704,10 @@ void EnzoSolverCg::loop_4 (EnzoBlock * enzo_block) throw ()
 //  a = rz / dy;
 //  X = X + a*D;
 //  R = R - a*Y;
+//  rzp = dot(R,Z)
 //  solve(M*Z = R)
 //  rz2 = dot(R,Z)
-//  b = rz2 / rz;
+//  b = (rz2 - rzp) / rz;
 //  D = Z + b*D;
 //  rz = rz2;
 {
@@ -606,13 +737,6 @@ void EnzoSolverCg::loop_4 (EnzoBlock * enzo_block) throw ()
       R[i] -= a * Y[i];
     }
 
-    enzo_float * Z = (enzo_float*) field.values(iz_);
-    
-    // M_->matvec(iz_,ir_,enzo_block);
-    for (int i=0; i<mx_*my_*mz_; i++) {
-      Z[i] = R[i];
-    }
-
 #ifdef DEBUG_RESID
     CkPrintf ("Copying residual %s\n",enzo_block->name().c_str());
     enzo_float * residual = (enzo_float*) field.values("residual");
@@ -630,7 +754,70 @@ void EnzoSolverCg::loop_4 (EnzoBlock * enzo_block) throw ()
 #endif    
   }
 
-  long double reduce[3] = {0.0, 0.0, 0.0};
+  if (index_precon_ >= 0) {
+
+    // save local dot (R_i+1,Z_i) before Z is overwritten
+
+    long double & rzp = scalar_(enzo_block,is_rzp_);
+
+    rzp = 0.0;
+
+    if (is_finest_(enzo_block)) {
+
+      enzo_float * R = (enzo_float*) field.values(ir_);
+      enzo_float * Z = (enzo_float*) field.values(iz_);
+
+      for (int iz=gz_; iz<mz_-gz_; iz++) {
+	for (int iy=gy_; iy<my_-gy_; iy++) {
+	  for (int ix=gx_; ix<mx_-gx_; ix++) {
+	    int i = ix + mx_*(iy + my_*iz);
+	    rzp += R[i]*Z[i];
+	  }
+	}
+      }
+    }
+
+    apply_precon_ (enzo_block, CkIndex_EnzoBlock::p_solver_cg_loop_4());
+
+  } else {
+
+    if (is_finest_(enzo_block)) {
+
+      enzo_float * R = (enzo_float*) field.values(ir_);
+      enzo_float * Z = (enzo_float*) field.values(iz_);
+
+      // Z = M \ R  [ M = I ]
+      for (int i=0; i<mx_*my_*mz_; i++) {
+	Z[i] = R[i];
+      }
+    }
+
+    loop_4b(enzo_block);
+
+  }
+}
+
+//----------------------------------------------------------------------
+
+void EnzoBlock::p_solver_cg_loop_4 ()
+{
+  performance_start_(perf_compute,__FILE__,__LINE__);
+
+  EnzoSolverCg * solver = 
+    static_cast<EnzoSolverCg*> (this->solver());
+
+  solver->loop_4b(this);
+  performance_stop_(perf_compute,__FILE__,__LINE__);
+}
+
+//----------------------------------------------------------------------
+
+void EnzoSolverCg::loop_4b (EnzoBlock * enzo_block) throw()
+//  rz2 = dot(R,Z)
+{
+  Field field = enzo_block->data()->field();
+
+  long double reduce[4] = {0.0, 0.0, 0.0, 0.0};
 
   if (is_finest_(enzo_block)) {
 
@@ -653,16 +840,33 @@ void EnzoSolverCg::loop_4 (EnzoBlock * enzo_block) throw ()
     }
   }
 
+  if (index_precon_ >= 0) reduce[3] = scalar_(enzo_block,is_rzp_);
+
   CkCallback callback(CkIndex_EnzoBlock::r_solver_cg_loop_5(NULL), 
 		      enzo_block->proxy_array());
 
-  enzo_block->contribute (3*sizeof(long double), &reduce, 
-			  sum_long_double_3_type, 
+  enzo_block->contribute (4*sizeof(long double), &reduce, 
+			  sum_long_double_4_type, 
 			  callback);
 }
 
 //----------------------------------------------------------------------
 
+void EnzoSolverCg::apply_precon_
+(EnzoBlock * enzo_block, int callback) throw()
+{
+  Solver * precon = cello::solver(index_precon_);
+
+  precon->set_sync_id (enzo_sync_id_solver_cg_precon);
+  precon->set_callback(callback);
+
+  precon->set_field_x(iz_);
+  precon->set_field_b(ir_);
+  precon->apply(A_,enzo_block);
+}
+
+//----------------------------------------------------------------------
+
 void EnzoBlock::r_solver_cg_loop_5 (CkReductionMsg * msg)
 /// - EnzoBlock accumulate global contribution to DOT(R,R)
 /// ==> solver_cg_loop_6
@@ -677,6 +881,7 @@ void EnzoBlock::r_solver_cg_loop_5 (CkReductionMsg * msg)
   solver->set_rz2(data[0]);
   solver->set_rs (data[1]);
   solver->set_xs (data[2]);
+  solver->set_rzp(data[3]);
 
   delete msg;
 
@@ -689,7 +894,7 @@ void EnzoBlock::r_solver_cg_loop_5 (CkReductionMsg * msg)
 
 void EnzoSolverCg::loop_6 (EnzoBlock * enzo_block) throw ()
 //  rz2 = dot(R,Z)
-//  b = rz2 / rz;
+//  b = (rz2 - rzp) / rz;
 //  D = Z + b*D;
 //  rz = rz2;
 {
@@ -724,7 +929,11 @@ void EnzoSolverCg::loop_6 (EnzoBlock * enzo_block) throw ()
     enzo_float * D  = (enzo_float*) field.values(id_);
     enzo_float * Z  = (enzo_float*) field.values(iz_);
 
-    enzo_float b = rz2_ / rz_;
+    // Polak-Ribiere form, since the preconditioner (e.g. an Mg0
+    // V-cycle with a convergence test) may vary between iterations;
+    // rzp_ == 0 if unpreconditioned
+
+    enzo_float b = (rz2_ - rzp_) / rz_;
 
     cello::check(b,"CG::b",__FILE__,__LINE__);
 
@@ -758,6 +967,395 @@ void EnzoSolverCg::loop_6 (EnzoBlock * enzo_block) throw ()
 			  CkReduction::max_int, callback);
 }
 
+//======================================================================
+// Pipelined (single-reduction) CG
+//
+// Ghysels and Vanroose's pipelined variant of Chronopoulos and Gear's
+// CG: the dot products (R,R) and (W,R) are fused into one reduction
+// per iteration, which proceeds concurrently with the refresh of W
+// and Q = A*W.  With P stored in D, S = A*P in Y, and Z = A*S in Z:
+//
+//     R = B, W = A*R
+//     loop
+//        gamma = (R,R), delta = (W,R)  [reduction]    Q = A*W
+//        beta  = gamma / gamma_old
+//        alpha = gamma / (delta - beta*gamma/alpha_old)
+//        Z = Q + beta*Z
+//        S = W + beta*S
+//        P = R + beta*P
+//        X = X + alpha*P
+//        R = R - alpha*S
+//        W = W - alpha*Z
+//======================================================================
+
+void EnzoSolverCg::pipe_compute_ (EnzoBlock * enzo_block) throw()
+//     X = 0
+//     R = B
+//     ==> SUM(B), COUNT(B)
+{
+  Field field = enzo_block->data()->field();
+
+  s_iter_(enzo_block) = 0;
+  s_pipe_sync_(enzo_block).set_stop(2);
+  s_pipe_sync_(enzo_block).reset();
+
+  long double reduce[3] = {2.0, 0.0, 0.0};
+
+  if (is_finest_(enzo_block)) {
+
+    enzo_float * X = (enzo_float*) field.values(ix_);
+    enzo_float * B = (enzo_float*) field.values(ib_);
+    enzo_float * R = (enzo_float*) field.values(ir_);
+    enzo_float * D = (enzo_float*) field.values(id_);
+    enzo_float * Y = (enzo_float*) field.values(iy_);
+    enzo_float * Z = (enzo_float*) field.values(iz_);
+
+    for (int i=0; i<mx_*my_*mz_; i++) {
+      X[i] = 0.0;
+      R[i] = B[i];
+      D[i] = 0.0;
+      Y[i] = 0.0;
+      Z[i] = 0.0;
+    }
+
+    for (int iz=gz_; iz<mz_-gz_; iz++) {
+      for (int iy=gy_; iy<my_-gy_; iy++) {
+	for (int ix=gx_; ix<mx_-gx_; ix++) {
+	  int i = ix + mx_*(iy + my_*iz);
+	  reduce[1] += B[i];
+	}
+      }
+    }
+    reduce[2] = nx_*ny_*nz_;
+  }
+
+  CkCallback callback(CkIndex_EnzoBlock::r_solver_cg_pipe_shift(NULL), 
+		      enzo_block->proxy_array());
+	  
+  enzo_block->contribute (3*sizeof(long double), &reduce, 
+			  sum_long_double_n_type, 
+			  callback);
+}
+
+//----------------------------------------------------------------------
+
+void EnzoBlock::r_solver_cg_pipe_shift (CkReductionMsg * msg)
+{
+  performance_start_(perf_compute,__FILE__,__LINE__);
+
+  EnzoSolverCg * solver = 
+    static_cast<EnzoSolverCg*> (this->solver());
+
+  solver->pipe_shift(this,msg);
+
+  performance_stop_(perf_compute,__FILE__,__LINE__);
+}
+
+//----------------------------------------------------------------------
+
+void EnzoSolverCg::pipe_shift
+(EnzoBlock * enzo_block, CkReductionMsg * msg) throw ()
+{
+  long double * data = (long double *) msg->getData();
+
+  ASSERT1("EnzoSolverCg::pipe_shift()",
+	  "Expecting (data[0] = %d) == 2",
+	  data[0],(data[0] == 2));
+
+  scalar_(enzo_block,is_bs_) = data[1];
+  scalar_(enzo_block,is_bc_) = data[2];
+
+  delete msg;
+
+  if (is_finest_(enzo_block) && A_->is_singular()) {
+
+    // shift rhs B by projection of B onto e: B~ <== B - (e*eT)/(eT*e) b
+
+    Field field = enzo_block->data()->field();
+
+    enzo_float * B = (enzo_float*) field.values(ib_);
+    enzo_float * R = (enzo_float*) field.values(ir_);
+
+    long double shift =
+      -scalar_(enzo_block,is_bs_) / scalar_(enzo_block,is_bc_);
+
+    for (int i=0; i<mx_*my_*mz_; i++) {
+      R[i] += shift;
+      B[i] += shift;
+    }
+  }
+
+  // Refresh R then call r_solver_cg_pipe_start
+
+  Refresh refresh (4,0,neighbor_type_(), sync_type_(),
+		   enzo_sync_id_solver_cg_pipe_0);
+  refresh.set_active(is_finest_(enzo_block));
+  refresh.add_field (ir_);
+
+  enzo_block->refresh_enter
+    (CkIndex_EnzoBlock::p_solver_cg_pipe_start(),&refresh);
+}
+
+//----------------------------------------------------------------------
+
+void EnzoBlock::p_solver_cg_pipe_start ()
+{
+  performance_start_(perf_compute,__FILE__,__LINE__);
+
+  EnzoSolverCg * solver = 
+    static_cast<EnzoSolverCg*> (this->solver());
+
+  solver->pipe_start(this);
+
+  performance_stop_(perf_compute,__FILE__,__LINE__);
+}
+
+//----------------------------------------------------------------------
+
+void EnzoSolverCg::pipe_start (EnzoBlock * enzo_block) throw()
+//     W = A*R
+{
+  if (is_finest_(enzo_block)) {
+    A_->matvec(iw_,ir_,enzo_block);
+  }
+
+  pipe_loop_(enzo_block);
+}
+
+//----------------------------------------------------------------------
+
+void EnzoSolverCg::pipe_loop_ (EnzoBlock * enzo_block) throw()
+//     ==> gamma = DOT(R,R), delta = DOT(W,R), SUM(R), SUM(X)
+//     refresh W ==> Q = A*W
+{
+  Field field = enzo_block->data()->field();
+
+  long double reduce[5] = {4.0, 0.0, 0.0, 0.0, 0.0};
+
+  if (is_finest_(enzo_block)) {
+
+    enzo_float * X = (enzo_float*) field.values(ix_);
+    enzo_float * R = (enzo_float*) field.values(ir_);
+    enzo_float * W = (enzo_float*) field.values(iw_);
+
+    for (int iz=gz_; iz<mz_-gz_; iz++) {
+      for (int iy=gy_; iy<my_-gy_; iy++) {
+	for (int ix=gx_; ix<mx_-gx_; ix++) {
+	  int i = ix + mx_*(iy + my_*iz);
+	  reduce[1] += R[i]*R[i];
+	  reduce[2] += W[i]*R[i];
+	  reduce[3] += R[i];
+	  reduce[4] += X[i];
+	}
+      }
+    }
+  }
+
+  // Single reduction for the iteration: continues with
+  // r_solver_cg_pipe_dot() ...
+
+  CkCallback callback(CkIndex_EnzoBlock::r_solver_cg_pipe_dot(NULL), 
+		      enzo_block->proxy_array());
+
+  enzo_block->contribute (5*sizeof(long double), &reduce, 
+			  sum_long_double_n_type, 
+			  callback);
+
+  // ... while concurrently refreshing W for Q = A*W, continuing with
+  // p_solver_cg_pipe_matvec()
+
+  Refresh refresh (4,0,neighbor_type_(), sync_type_(),
+		   enzo_sync_id_solver_cg_pipe_1);
+  refresh.set_active(is_finest_(enzo_block));
+  refresh.add_field (iw_);
+
+  enzo_block->refresh_enter
+    (CkIndex_EnzoBlock::p_solver_cg_pipe_matvec(),&refresh);
+}
+
+//----------------------------------------------------------------------
+
+void EnzoBlock::r_solver_cg_pipe_dot (CkReductionMsg * msg)
+{
+  performance_start_(perf_compute,__FILE__,__LINE__);
+
+  EnzoSolverCg * solver = 
+    static_cast<EnzoSolverCg*> (this->solver());
+
+  solver->pipe_dot(this,msg);
+
+  performance_stop_(perf_compute,__FILE__,__LINE__);
+}
+
+//----------------------------------------------------------------------
+
+void EnzoSolverCg::pipe_dot
+(EnzoBlock * enzo_block, CkReductionMsg * msg) throw ()
+{
+  long double * data = (long double *) msg->getData();
+
+  ASSERT1("EnzoSolverCg::pipe_dot()",
+	  "Expecting (data[0] = %d) == 4",
+	  data[0],(data[0] == 4));
+
+  scalar_(enzo_block,is_gamma_) = data[1];
+  scalar_(enzo_block,is_delta_) = data[2];
+  scalar_(enzo_block,is_rs_)    = data[3];
+  scalar_(enzo_block,is_xs_)    = data[4];
+
+  delete msg;
+
+  if (s_pipe_sync_(enzo_block).next()) pipe_update_(enzo_block);
+}
+
+//----------------------------------------------------------------------
+
+void EnzoBlock::p_solver_cg_pipe_matvec ()
+{
+  performance_start_(perf_compute,__FILE__,__LINE__);
+
+  EnzoSolverCg * solver = 
+    static_cast<EnzoSolverCg*> (this->solver());
+
+  solver->pipe_matvec(this);
+
+  performance_stop_(perf_compute,__FILE__,__LINE__);
+}
+
+//----------------------------------------------------------------------
+
+void EnzoSolverCg::pipe_matvec (EnzoBlock * enzo_block) throw()
+//     Q = A*W
+{
+  if (is_finest_(enzo_block)) {
+    A_->matvec(iq_,iw_,enzo_block);
+  }
+
+  if (s_pipe_sync_(enzo_block).next()) pipe_update_(enzo_block);
+}
+
+//----------------------------------------------------------------------
+
+void EnzoSolverCg::pipe_update_ (EnzoBlock * enzo_block) throw()
+{
+  int & iter = s_iter_(enzo_block);
+
+  const long double gamma = scalar_(enzo_block,is_gamma_);
+  const long double delta = scalar_(enzo_block,is_delta_);
+
+  long double & rr0    = scalar_(enzo_block,is_rr0_);
+  long double & rr_min = scalar_(enzo_block,is_rr_min_);
+  long double & rr_max = scalar_(enzo_block,is_rr_max_);
+
+  if (iter == 0) {
+    rr0    = gamma;
+    rr_min = gamma;
+    rr_max = gamma;
+  } else {
+    rr_min = std::min(rr_min,gamma);
+    rr_max = std::max(rr_max,gamma);
+  }
+
+  if (enzo_block->index().is_root()) pipe_monitor_output_(enzo_block);
+
+  const bool is_converged = (gamma / rr0 < res_tol_);
+  const bool is_diverged = (iter >= iter_max_);
+
+  if (is_converged) {
+
+    end (enzo_block,return_converged);
+
+  } else if (is_diverged)  {
+
+    end (enzo_block,return_error);
+
+  } else {
+
+    cello::check(gamma,"CG::gamma",__FILE__,__LINE__);
+    cello::check(delta,"CG::delta",__FILE__,__LINE__);
+
+    long double & gamma_old = scalar_(enzo_block,is_gamma_old_);
+    long double & alpha_old = scalar_(enzo_block,is_alpha_);
+
+    const long double beta  = (iter == 0) ? 0.0 : gamma / gamma_old;
+    const long double alpha = (iter == 0) ? gamma / delta :
+      gamma / (delta - beta*gamma/alpha_old);
+
+    cello::check(alpha,"CG::alpha",__FILE__,__LINE__);
+    cello::check(beta, "CG::beta", __FILE__,__LINE__);
+
+    if (is_finest_(enzo_block)) {
+
+      Field field = enzo_block->data()->field();
+
+      enzo_float * X = (enzo_float*) field.values(ix_);
+      enzo_float * R = (enzo_float*) field.values(ir_);
+      enzo_float * W = (enzo_float*) field.values(iw_);
+      enzo_float * Q = (enzo_float*) field.values(iq_);
+      enzo_float * P = (enzo_float*) field.values(id_);
+      enzo_float * S = (enzo_float*) field.values(iy_);
+      enzo_float * Z = (enzo_float*) field.values(iz_);
+
+      const enzo_float a = alpha;
+      const enzo_float b = beta;
+
+      for (int i=0; i<mx_*my_*mz_; i++) {
+	Z[i] = Q[i] + b*Z[i];
+	S[i] = W[i] + b*S[i];
+	P[i] = R[i] + b*P[i];
+	X[i] += a*P[i];
+	R[i] -= a*S[i];
+	W[i] -= a*Z[i];
+      }
+
+      if (A_->is_singular())  {
+
+	// Project out the null space: since A*e = 0, the mean of R
+	// is unchanged by the update and W is unaffected
+
+	const long double bc = scalar_(enzo_block,is_bc_);
+	const enzo_float xs = scalar_(enzo_block,is_xs_) / bc;
+	const enzo_float rs = scalar_(enzo_block,is_rs_) / bc;
+
+	for (int i=0; i<mx_*my_*mz_; i++) {
+	  X[i] -= xs;
+	  R[i] -= rs;
+	}
+      }
+    }
+
+    gamma_old = gamma;
+    alpha_old = alpha;
+
+    ++iter;
+
+    pipe_loop_(enzo_block);
+  }
+}
+
+//----------------------------------------------------------------------
+
+void EnzoSolverCg::pipe_monitor_output_(EnzoBlock * enzo_block)
+{
+  const int iter = s_iter_(enzo_block);
+
+  const long double rr     = scalar_(enzo_block,is_gamma_);
+  const long double rr0    = scalar_(enzo_block,is_rr0_);
+  const long double rr_min = scalar_(enzo_block,is_rr_min_);
+  const long double rr_max = scalar_(enzo_block,is_rr_max_);
+
+  const bool l_first_iter = (iter == 0);
+  const bool l_max_iter   = (iter >= iter_max_);
+  const bool l_monitor    = (monitor_iter_ && (iter % monitor_iter_) == 0 );
+  const bool l_converged  = (rr / rr0 < res_tol_);
+
+  const bool l_output = l_first_iter || l_max_iter || l_monitor || l_converged;
+      
+  if (l_output) {
+    Solver::monitor_output_ (enzo_block,iter,rr0,rr_min,rr,rr_max);
+  }
+}
+
 //----------------------------------------------------------------------
 
 void EnzoSolverCg::local_cg_(EnzoBlock * enzo_block)
@@ -844,18 +1442,16 @@ void EnzoSolverCg::local_cg_(EnzoBlock * enzo_block)
 
     refresh_local_(id_,enzo_block);
 
-    A_->matvec(iy_,id_,enzo_block);
+    dy_ = A_->matvec_dot(iy_,id_,id_,enzo_block);
 
     rr_ = 0.0;
     rz_ = 0.0;
-    dy_ = 0.0;
     for (int iz=gz_; iz<mz_-gz_; iz++) {
       for (int iy=gy_; iy<my_-gy_; iy++) {
 	for (int ix=gx_; ix<mx_-gx_; ix++) {
 	  int i = ix + mx_*(iy + my_*iz);
 	  rr_ += R[i]*R[i];
 	  rz_ += R[i]*Z[i];
-	  dy_ += D[i]*Y[i];
 	}
       }
     }
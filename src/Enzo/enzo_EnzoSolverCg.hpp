@@ -26,7 +26,8 @@ public: // interface
 		int max_level,
 		int iter_max, 
 		double res_tol,
-		int index_precon);
+		int index_precon,
+		bool pipelined = false);
 
   /// Constructor
   EnzoSolverCg() throw()
@@ -42,9 +43,17 @@ public: // interface
     res_tol_(0.0),
     rr0_(0),
     rr_min_(0),rr_max_(0),
-    rr_(0.0), rz_(0.0), rz2_(0.0), dy_(0.0), bs_(0.0), rs_(0.0), xs_(0.0),
+    rr_(0.0), rz_(0.0), rz2_(0.0), rzp_(0.0),
+    dy_(0.0), bs_(0.0), rs_(0.0), xs_(0.0),
     bc_(0.0),
-    local_(false)
+    local_(false),
+    pipelined_(false),
+    is_rzp_(-1),
+    iw_(-1), iq_(-1),
+    is_gamma_(-1), is_gamma_old_(-1), is_delta_(-1), is_alpha_(-1),
+    is_rs_(-1), is_xs_(-1), is_bs_(-1), is_bc_(-1),
+    is_rr0_(-1), is_rr_min_(-1), is_rr_max_(-1),
+    is_iter_(-1), is_pipe_sync_(-1)
   {};
 
   /// Charm++ PUP::able declarations
@@ -64,9 +73,17 @@ public: // interface
       res_tol_(0.0),
       rr0_(0),
       rr_min_(0),rr_max_(0),
-      rr_(0.0), rz_(0.0), rz2_(0.0), dy_(0.0), bs_(0.0), rs_(0.0), xs_(0.0),
+      rr_(0.0), rz_(0.0), rz2_(0.0), rzp_(0.0),
+      dy_(0.0), bs_(0.0), rs_(0.0), xs_(0.0),
       bc_(0.0),
-      local_(false)
+      local_(false),
+      pipelined_(false),
+      is_rzp_(-1),
+      iw_(-1), iq_(-1),
+      is_gamma_(-1), is_gamma_old_(-1), is_delta_(-1), is_alpha_(-1),
+      is_rs_(-1), is_xs_(-1), is_bs_(-1), is_bc_(-1),
+      is_rr0_(-1), is_rr_min_(-1), is_rr_max_(-1),
+      is_iter_(-1), is_pipe_sync_(-1)
   {}
 
   /// Assignment operator
@@ -107,11 +124,34 @@ public: // virtual functions
   /// Continuation after global reduction
   void loop_4(EnzoBlock * enzo_block) throw();
 
+  /// Continuation after Z = M \ R in loop_4(): DOT(R,Z)
+  void loop_4b(EnzoBlock * enzo_block) throw();
+
+  /// Continuation after initial preconditioner solve M*Z = R
+  void precon_0(EnzoBlock * enzo_block) throw();
+
   /// Continuation after global reduction
   void loop_6(EnzoBlock * enzo_block) throw();
 
   void end (EnzoBlock * enzo_block, int retval) throw();
 
+  //--------------------------------------------------
+  // Pipelined (single-reduction) CG
+  //--------------------------------------------------
+
+  /// Continuation after SUM(B) and COUNT(B) reduction: shift B and R
+  /// if singular, then refresh R for W = MATVEC(A,R)
+  void pipe_shift(EnzoBlock * enzo_block, CkReductionMsg *) throw();
+
+  /// Continuation after refreshing R: W = MATVEC(A,R) and start loop
+  void pipe_start(EnzoBlock * enzo_block) throw();
+
+  /// Continuation after the iteration's single reduction
+  void pipe_dot(EnzoBlock * enzo_block, CkReductionMsg *) throw();
+
+  /// Continuation after refreshing W: Q = MATVEC(A,W)
+  void pipe_matvec(EnzoBlock * enzo_block) throw();
+
   /// Set rz_ by EnzoBlock after reduction
   void set_rz(double rz) throw()    {  rz_ = rz; }
 
@@ -121,6 +161,9 @@ public: // virtual functions
   /// Set rr_new_ by EnzoBlock after reduction
   void set_rz2(double rz2) throw()  {  rz2_ = rz2; }
 
+  /// Set rzp_ by EnzoBlock after reduction
+  void set_rzp(double rzp) throw()  {  rzp_ = rzp; }
+
   /// Set dy_ by EnzoBlock after reduction
   void set_dy(double dy) throw()         { dy_ = dy; }
 
@@ -150,6 +193,10 @@ protected: // methods
     field.allocate_temporary(ir_);
     field.allocate_temporary(iy_);
     field.allocate_temporary(iz_);
+    if (pipelined_) {
+      field.allocate_temporary(iw_);
+      field.allocate_temporary(iq_);
+    }
   }
 
   /// Dellocate temporary Fields
@@ -159,11 +206,21 @@ protected: // methods
     field.deallocate_temporary(ir_);
     field.deallocate_temporary(iy_);
     field.deallocate_temporary(iz_);
+    if (pipelined_) {
+      field.deallocate_temporary(iw_);
+      field.deallocate_temporary(iq_);
+    }
   }
 
   /// Serial CG solver if local_ == true
   void local_cg_ (EnzoBlock * enzo_block);
 
+  /// Refresh CG vectors then call loop_2b()
+  void refresh_2a_ (EnzoBlock * enzo_block) throw();
+
+  /// Apply the preconditioner Z = M \ R, then call the entry method
+  void apply_precon_ (EnzoBlock * enzo_block, int callback) throw();
+
   /// Apply boundary conditions for the Field on the local block
   void refresh_local_(int ix, EnzoBlock * enzo_block);
 
@@ -171,6 +228,31 @@ protected: // methods
   void shift_local_(int ix, EnzoBlock * enzo_block);
   
   void monitor_output_(EnzoBlock *);
+
+  /// Start the pipelined CG solver
+  void pipe_compute_ (EnzoBlock * enzo_block) throw();
+
+  /// Compute local dot products and begin the iteration's reduction
+  /// and W refresh
+  void pipe_loop_ (EnzoBlock * enzo_block) throw();
+
+  /// Join point for the reduction and Q = MATVEC(A,W): check
+  /// convergence and update vectors
+  void pipe_update_ (EnzoBlock * enzo_block) throw();
+
+  void pipe_monitor_output_(EnzoBlock *);
+
+  /// Per-Block long double scalar for the pipelined solver
+  long double & scalar_ (Block * block, int i_scalar)
+  { return *block->data()->scalar_long_double().value(i_scalar); }
+
+  /// Per-Block iteration count for the pipelined solver
+  int & s_iter_ (Block * block)
+  { return *block->data()->scalar_int().value(is_iter_); }
+
+  /// Per-Block join of reduction and matvec for the pipelined solver
+  Sync & s_pipe_sync_ (Block * block)
+  { return *block->data()->scalar_sync().value(is_pipe_sync_); }
   
 protected: // attributes
 
@@ -179,7 +261,7 @@ protected: // attributes
   /// Matrix
   std::shared_ptr<Matrix> A_;
 
-  /// Preconditioner (-1 if none)
+  /// Preconditioner Solver (-1 if none), e.g. an Mg0 V-cycle
   int index_precon_;
 
   /// Maximum number of Cg iterations
@@ -220,6 +302,10 @@ protected: // attributes
   /// dot (R_i+1,Z_i+1)
   double rz2_;
 
+  /// dot (R_i+1,Z_i) for the flexible (Polak-Ribiere) update of D
+  /// when preconditioned
+  double rzp_;
+
   /// dot (D,Y)
   double dy_;
 
@@ -235,6 +321,36 @@ protected: // attributes
 
   /// Whether to solve on a standalone Block, e.g. for MG coarse solver
   bool local_;
+
+  /// Whether to use the pipelined (Chronopoulos-Gear / Ghysels-Vanroose)
+  /// variant, which uses a single global reduction per iteration that
+  /// is overlapped with the refresh and matvec of W
+  bool pipelined_;
+
+  /// Per-Block local contribution to dot (R_i+1,Z_i), computed before
+  /// the preconditioner overwrites Z
+  int is_rzp_;
+
+  /// Pipelined CG vector id's (W = A*R, Q = A*W); D, Y and Z hold
+  /// P, S = A*P and Z = A*S respectively
+  int iw_;
+  int iq_;
+
+  /// Pipelined CG per-Block scalar indices (since Blocks on the same
+  /// process may be at different iterations)
+  int is_gamma_;
+  int is_gamma_old_;
+  int is_delta_;
+  int is_alpha_;
+  int is_rs_;
+  int is_xs_;
+  int is_bs_;
+  int is_bc_;
+  int is_rr0_;
+  int is_rr_min_;
+  int is_rr_max_;
+  int is_iter_;
+  int is_pipe_sync_;
 };
 
 #endif /* ENZO_ENZO_SOLVER_CG_HPP */
@@ -99,6 +99,12 @@ int EnzoBlock::SolveHydroEquations
 
   Field field = data()->field();
 
+  // Borrow temporary arrays from the process's scratch arena to
+  // avoid heap allocation on each call
+
+  Scratch * scratch = Scratch::instance();
+  const size_t scratch_mark = scratch->mark();
+
   //------------------------------
   // Prepare color field parameters
   //------------------------------
@@ -111,7 +117,7 @@ int EnzoBlock::SolveHydroEquations
   enzo_float * colorpt = (enzo_float *) field.permanent();
 
   // coloff: offsets into the color array (for each color field)
-  int * coloff   = (ncolor > 0) ? (new int [ncolor]) : NULL;
+  int * coloff   = (ncolor > 0) ? scratch->allocate<int>(ncolor) : NULL;
   int index_color = 0;
   for (int index_field = 0;
        index_field < field.field_count();
@@ -151,15 +157,13 @@ int EnzoBlock::SolveHydroEquations
   if (rank >= 2) {
     velocity_y = (enzo_float *) field.values("velocity_y");
   } else {
-    velocity_y = new enzo_float[size];
-    for (int i=0; i<size; i++) velocity_y[i] = 0.0;
+    velocity_y = scratch->allocate<enzo_float>(size,0.0);
   }
 
     if (rank >= 3) {
     velocity_z = (enzo_float *) field.values("velocity_z");
   } else {
-    velocity_z = new enzo_float[size];
-    for (int i=0; i<size; i++) velocity_z[i] = 0.0;
+    velocity_z = scratch->allocate<enzo_float>(size,0.0);
   }
 
   enzo_float * acceleration_x  = field.is_field("acceleration_x") ? 
@@ -260,14 +264,13 @@ int EnzoBlock::SolveHydroEquations
 			 GridDimension[1]*GridDimension[2]),
 		     GridDimension[2]*GridDimension[0]);
 
-  enzo_float *temp = new enzo_float[tempsize*(32+ncolor*4)];
+  enzo_float *temp = scratch->allocate<enzo_float>(tempsize*(32+ncolor*4));
 
   /* create and fill in arrays which are easier for the solver to
      understand. */
 
   size = NumberOfSubgrids*3*(18+2*ncolor) + 1;
-  int * array = new int[size];
-  for (int i=0; i<size; i++) array[i] = 0;
+  int * array = scratch->allocate<int>(size,0);
 
   int *leftface  = array + NumberOfSubgrids*3*0;
   int *rightface = array + NumberOfSubgrids*3*1;
@@ -306,7 +309,7 @@ int EnzoBlock::SolveHydroEquations
 
   enzo_float * CellWidthTemp[MAX_DIMENSION];
   for (dim = 0; dim < MAX_DIMENSION; dim++) {
-    CellWidthTemp[dim] = new enzo_float [GridDimension[dim]];
+    CellWidthTemp[dim] = scratch->allocate<enzo_float>(GridDimension[dim]);
     if (dim < rank) {
       for (int i=0; i<GridDimension[dim]; i++) 
 	CellWidthTemp[dim][i] = (cosmo_a*CellWidth[dim]);
@@ -416,10 +419,6 @@ int EnzoBlock::SolveHydroEquations
      &ncolor, colorpt, coloff, colindex
      );
 
-  for (dim = 0; dim < MAX_DIMENSION; dim++) {
-    delete [] CellWidthTemp[dim];
-  }
-
 #ifdef DEBUG_READ_FIELDS
   READ_FIELD("density_diff","de-enzo-1-%03d.data",cycle_,field,0,0,0,mx,my,mz);
   READ_FIELD("velocity_x_diff","vx-enzo-1-%03d.data",cycle_,field,0,0,0,mx,my,mz);
@@ -481,13 +480,9 @@ int EnzoBlock::SolveHydroEquations
   TRACE_FIELD("ppm-1-acceleration_z",acceleration_z,1.0);
   TRACE_FIELD("ppm-1-internal_energy",internal_energy,1.0);
   
-  /* deallocate temporary space for solver */
-
-  delete [] temp;
-  if (rank < 2) delete [] velocity_y;
-  if (rank < 3) delete [] velocity_z;
+  /* return temporary space for solver to the scratch arena */
 
-  delete [] array;
+  scratch->release(scratch_mark);
 
   if (SubgridFluxes != NULL) {    
     for (int i=0; i<NumberOfSubgrids; i++) {
@@ -495,8 +490,6 @@ int EnzoBlock::SolveHydroEquations
     }
     delete [] SubgridFluxes;
   }
-  
-  if (ncolor > 0) delete [] coloff;
 
   return ENZO_SUCCESS;
 
@@ -0,0 +1,34 @@
+#!/bin/bash
+#
+# Compare the datasets of two Enzo-P HDF5 data files, e.g. the output
+# of a method against that of a reference method on the same problem.
+# Output is in the same format as the unit tests, so that results are
+# counted by build.sh
+#
+# usage: compare-hdf5.sh <file> <reference file> <tolerance>
+#
+#    file             HDF5 file written by the run being tested
+#    reference file   HDF5 file written by the reference run
+#    tolerance        maximum absolute difference of any value, or 0
+#                     if values must be identical
+
+file=$1
+reference=$2
+tolerance=$3
+
+if [ ! -e $file -o ! -e $reference ]; then
+    echo " FAIL  0/1 $file 0 compare-hdf5 missing $file or $reference"
+    exit 0
+fi
+
+if [ $tolerance == 0 ]; then
+    h5diff $file $reference > /dev/null 2>&1
+else
+    h5diff -d $tolerance $file $reference > /dev/null 2>&1
+fi
+
+if [ $? == 0 ]; then
+    echo " pass  0/1 $file 0 compare-hdf5 $reference $tolerance"
+else
+    echo " FAIL  0/1 $file 0 compare-hdf5 $reference $tolerance"
+fi
@@ -0,0 +1,42 @@
+#!/bin/bash
+#
+# Compare PNG images of two Enzo-P runs pixel by pixel, e.g. images
+# combined in single and double precision.  Images are paired in
+# sorted order.  Output is in the same format as the unit tests, so
+# that results are counted by build.sh
+#
+# usage: compare-png.sh <dir> <reference dir> <fuzz>
+#
+#    dir              directory of PNG images of the run being tested
+#    reference dir    directory of PNG images of the reference run
+#    fuzz             colors within this distance are considered
+#                     equal, e.g. "1%"
+
+dir=$1
+reference=$2
+fuzz=$3
+
+files=(`ls $dir/*.png 2> /dev/null`)
+files_ref=(`ls $reference/*.png 2> /dev/null`)
+
+n=${#files[@]}
+n_ref=${#files_ref[@]}
+
+if [ $n -gt 0 -a $n == $n_ref ]; then
+    echo " pass  0/1 $dir 0 compare-png num_images $n $n_ref"
+else
+    echo " FAIL  0/1 $dir 0 compare-png num_images $n $n_ref"
+fi
+
+for ((i=0; i<n && i<n_ref; i++)); do
+
+    # number of differing pixels is written to stderr
+
+    pixels=`compare -metric AE -fuzz $fuzz ${files[$i]} ${files_ref[$i]} null: 2>&1`
+
+    if [ "$pixels" == "0" ]; then
+	echo " pass  0/1 ${files[$i]} 0 compare-png ${files_ref[$i]} $pixels"
+    else
+	echo " FAIL  0/1 ${files[$i]} 0 compare-png ${files_ref[$i]} $pixels"
+    fi
+done
@@ -0,0 +1,83 @@
+#!/bin/bash
+#
+# Compare the linear solver convergence of two Enzo-P runs, e.g. a
+# solver variant against the standard solver on the same problem.
+# Output is in the same format as the unit tests, so that results are
+# counted by build.sh
+#
+# usage: compare-solver.sh <output> <reference output> <solver> <res_tol> <iter_diff>
+#
+#    output           Enzo-P output of the run being tested
+#    reference output Enzo-P output of the reference run
+#    solver           name of the Solver to compare, e.g. "cg"
+#    res_tol          maximum final relative residual for each solve
+#    iter_diff        maximum difference in iterations for each solve,
+#                     or if negative, the minimum number of iterations
+#                     fewer than the reference that each solve must
+#                     need, e.g. -1 for a preconditioned solver
+
+output=$1
+reference=$2
+solver=$3
+res_tol=$4
+iter_diff=$5
+
+# Print "iter err" for the last monitor line of each solve
+
+solves()
+{
+    awk -v solver=$solver '
+    / Solver / && / iter / && / err / {
+        found = 0
+        for (i=1; i<=NF; i++) {
+            if ($i == solver) found = 1
+            if ($i == "iter") iter = $(i+1)
+            if ($i == "err")  err  = $(i+1)
+        }
+        if (! found) next
+        if (iter+0 == 0 && n > 0) print last_iter+0, last_err
+        last_iter = iter; last_err = err; n++
+    }
+    END { if (n > 0) print last_iter+0, last_err }' $1
+}
+
+solves $output    > $output.solves
+solves $reference > $output.solves.ref
+
+result()
+{
+    if [ $1 == 0 ]; then
+        echo " pass  0/1 $output 0 compare-solver $2"
+    else
+        echo " FAIL  0/1 $output 0 compare-solver $2"
+    fi
+}
+
+n=`wc -l < $output.solves`
+n_ref=`wc -l < $output.solves.ref`
+
+result `[ $n -gt 0 -a $n == $n_ref ]; echo $?` "num_solves $n $n_ref"
+
+paste $output.solves $output.solves.ref | \
+    awk -v res_tol=$res_tol -v iter_diff=$iter_diff '
+    { d = $1 - $3
+      if (iter_diff < 0) {
+         # (...solves the reference needs no iterations for are skipped)
+         if (d > iter_diff && $3 > 0) fail_iter++
+      } else {
+         if (d < 0) d = -d
+         if (d > iter_diff) fail_iter++
+      }
+      if ($2 + 0 > res_tol) fail_res++ }
+    END { print fail_iter+0, fail_res+0 }' > $output.solves.diff
+
+read fail_iter fail_res < $output.solves.diff
+
+if [ $iter_diff -lt 0 ]; then
+    result $fail_iter "iterations $fail_iter solves not fewer by at least ${iter_diff#-}"
+else
+    result $fail_iter "iterations $fail_iter solves differ by more than $iter_diff"
+fi
+result $fail_res  "residual $fail_res solves above $res_tol"
+
+rm -f $output.solves $output.solves.ref $output.solves.diff